@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal micro-benchmark harness. Deliberately tiny: no deps, so it builds on any Linux box.
+namespace nevermore::bench {
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps the optimiser from discarding `x` (or the work that produced it).
+template <typename A>
+void keep(A const& x) {
+    asm volatile("" : : "r,m"(x) : "memory");
+}
+
+// Forces the optimiser to assume all memory was read & written.
+inline void clobber() {
+    asm volatile("" : : : "memory");
+}
+
+struct Options {
+    std::chrono::nanoseconds min_time = std::chrono::milliseconds(200);  // per benchmark
+    size_t samples = 15;
+};
+
+struct Result {
+    std::string name;
+    uint64_t iterations = 0;  // total, over all samples
+    // per op, over the samples
+    double ns_median = 0;
+    double ns_min = 0;
+    double ns_max = 0;
+    size_t bytes_per_op = 0;  // 0 -> not a throughput benchmark
+
+    [[nodiscard]] double bytes_per_second() const {
+        return bytes_per_op ? double(bytes_per_op) * 1e9 / ns_median : 0;
+    }
+};
+
+// Runs `op` in batches sized so each sample takes `min_time / samples`, reports the per-op time.
+// Median is the headline figure, it shrugs off the odd scheduler hiccup.
+template <typename F>
+Result measure(std::string name, Options const& options, size_t bytes_per_op, F&& op) {
+    auto batch = [&](uint64_t n) {
+        auto begin = Clock::now();
+        for (uint64_t i = 0; i < n; ++i)
+            op();
+        return Clock::now() - begin;
+    };
+
+    auto const sample_time = options.min_time / std::max<size_t>(options.samples, 1);
+    uint64_t n = 1;
+    while (batch(n) < sample_time && n < (uint64_t(1) << 40))
+        n *= 2;
+
+    std::vector<double> ns_per_op;
+    for (size_t i = 0; i < std::max<size_t>(options.samples, 1); ++i)
+        ns_per_op.push_back(double(std::chrono::nanoseconds(batch(n)).count()) / double(n));
+
+    std::ranges::sort(ns_per_op);
+    return {
+            .name = std::move(name),
+            .iterations = n * ns_per_op.size(),
+            .ns_median = ns_per_op[ns_per_op.size() / 2],
+            .ns_min = ns_per_op.front(),
+            .ns_max = ns_per_op.back(),
+            .bytes_per_op = bytes_per_op,
+    };
+}
+
+}  // namespace nevermore::bench
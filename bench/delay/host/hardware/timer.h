@@ -0,0 +1,21 @@
+#pragma once
+
+// Host stand-in for the Pico SDK's `hardware/timer.h`: the steady clock as the 1 MHz timer.
+
+#include <chrono>
+#include <cstdint>
+
+inline uint64_t time_us_64() {
+    using namespace std::chrono;
+    return uint64_t(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+// NB: To the clock's resolution, not the timer's. Truncating to a whole us would return up to 1 us early.
+inline void busy_wait_us(uint64_t delay_us) {
+    auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(delay_us);
+    while (std::chrono::steady_clock::now() < end) {}
+}
+
+inline void busy_wait_us_32(uint32_t delay_us) {
+    busy_wait_us(delay_us);
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// Host stand-in for the Pico SDK's `pico/platform.h`. Never in an exception/IRQ, alarms get their own thread.
+
+inline unsigned __get_current_exception() {
+    return 0;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+// Host stand-in for the Pico SDK's `pico/time.h`. Alarms run on a single timer thread, standing in for the
+// timer IRQ.
+
+#include "hardware/timer.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void* user_data);
+
+inline void sleep_us(uint64_t delay_us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(delay_us));
+}
+
+namespace nevermore::host {
+
+struct Alarms {
+    using Alarm = std::tuple<alarm_id_t, alarm_callback_t, void*>;
+
+    std::mutex lock;
+    std::condition_variable changed;
+    alarm_id_t next_id = 1;
+    std::multimap<std::chrono::steady_clock::time_point, Alarm> pending;  // by deadline
+
+    Alarms() {
+        std::thread([this] { run(); }).detach();
+    }
+
+    // NB: Callbacks are one-shot, their result (reschedule) is ignored.
+    [[noreturn]] void run() {
+        std::unique_lock guard(lock);
+        for (;;) {
+            if (pending.empty()) {
+                changed.wait(guard);
+                continue;
+            }
+
+            auto [deadline, alarm] = *pending.begin();
+            if (std::chrono::steady_clock::now() < deadline) {
+                changed.wait_until(guard, deadline);
+                continue;
+            }
+
+            pending.erase(pending.begin());
+            guard.unlock();
+            auto [id, callback, user_data] = alarm;
+            callback(id, user_data);
+            guard.lock();
+        }
+    }
+};
+
+}  // namespace nevermore::host
+
+inline alarm_id_t add_alarm_in_us(uint64_t delay_us, alarm_callback_t callback, void* user_data, bool) {
+    static auto& g_alarms = *new nevermore::host::Alarms;  // leaked, the timer thread outlives `main`
+    std::lock_guard guard(g_alarms.lock);
+    auto id = g_alarms.next_id++;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(delay_us);
+    g_alarms.pending.emplace(deadline, nevermore::host::Alarms::Alarm{id, callback, user_data});
+    g_alarms.changed.notify_one();
+    return id;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+// Host stand-in for FreeRTOS' `task.h`, for `sdk/task.cpp`'s delays. Backed by real threads: a task is
+// whichever thread calls in, `vTaskDelay` sleeps to a boundary of a simulated tick, and task notifications
+// are a per thread semaphore.
+
+#include "FreeRTOS.h"
+#include <chrono>
+#include <cstdint>
+#include <semaphore>
+#include <thread>
+
+struct tskTaskControlBlock {
+    std::counting_semaphore<> notify{0};  // NB: Only the one index, `task_delay` is the only user
+};
+typedef tskTaskControlBlock* TaskHandle_t;
+
+#define taskSCHEDULER_RUNNING ((BaseType_t)2)
+#define portYIELD_FROM_ISR(woken) (void)(woken)
+
+namespace nevermore::host {
+
+inline auto const g_tick_epoch = std::chrono::steady_clock::now();
+inline thread_local tskTaskControlBlock g_task;
+
+}  // namespace nevermore::host
+
+inline BaseType_t xTaskGetSchedulerState() {
+    return taskSCHEDULER_RUNNING;
+}
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return &nevermore::host::g_task;
+}
+
+// Same as the kernel's: wakes on the `ticks`-th tick boundary from now.
+inline void vTaskDelay(TickType_t ticks) {
+    using namespace nevermore::host;
+    constexpr std::chrono::microseconds TICK{1'000'000 / configTICK_RATE_HZ};
+    auto since = std::chrono::steady_clock::now() - g_tick_epoch;
+    std::this_thread::sleep_until(g_tick_epoch + (since / TICK + ticks) * TICK);
+}
+
+// NB: `timeout` is either 0 or forever, `task_delay` never waits for a while.
+inline uint32_t ulTaskNotifyTakeIndexed(UBaseType_t, BaseType_t clear_on_exit, TickType_t timeout) {
+    auto& notify = nevermore::host::g_task.notify;
+    if (timeout == 0) {
+        if (!notify.try_acquire()) return 0;
+    } else
+        notify.acquire();
+
+    uint32_t n = 1;
+    if (clear_on_exit)
+        while (notify.try_acquire())
+            ++n;
+    return n;
+}
+
+inline void vTaskNotifyGiveIndexedFromISR(TaskHandle_t task, UBaseType_t, BaseType_t* woken) {
+    task->notify.release();
+    if (woken) *woken = pdTRUE;
+}
@@ -0,0 +1,176 @@
+#include "sdk/task.hpp"
+#include "sdk/timer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <sched.h>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Scheduling cost of the Bosch drivers' `delay_us` adapter (`task_delay`, `sdk/task.cpp`) vs the busy wait
+// it replaced, on the host. Everything is pinned to one CPU, standing in for one RP2040 core:
+//  - a sensor task runs Bosch shaped wait sequences
+//  - a periodic task (display/BTstack stand-in) wants to wake every tick
+//  - a background task soaks up whatever CPU is left
+// Reports the sensor task's CPU time per wait sequence, how late its waits return (never early, else
+// exits 1), the periodic task's wake latency & the CPU left over for the background task.
+// NB: Linux' CFS isn't FreeRTOS' fixed priority scheduler. On target the sensor task outranks the display,
+//     so a busy wait starves it outright; here it only takes a fair share. The busy wait numbers are a
+//     lower bound of the harm.
+
+using namespace std;
+using namespace nevermore;
+
+namespace {
+
+using Clock = chrono::steady_clock;
+
+// What the drivers ask for: `BME68X_PERIOD_POLL`, `BME280_STARTUP_DELAY` (about a BME68x T/H/P forced
+// measurement too), then sub-tick waits. The last is too short to block for, it spins either way.
+constexpr chrono::microseconds WAITS[]{10'000us, 2'000us, 500us, 100us, 20us};
+
+struct Mode {
+    char const* name;
+    void (*wait)(chrono::microseconds);  // `nullptr` -> no sensor task, the baseline
+};
+
+constexpr Mode MODES[]{
+        {"idle", nullptr},
+        {"busy_wait", [](chrono::microseconds x) { busy_wait_us_32(uint32_t(x / 1us)); }},
+        {"task_delay", [](chrono::microseconds x) { task_delay(x); }},
+};
+
+struct Stats {
+    double cpu_us_per_sequence = 0;
+    double overshoot_us_median = 0;
+    double overshoot_us_max = 0;
+    double latency_us_median = 0;
+    double latency_us_p99 = 0;
+    double latency_us_max = 0;
+    double background_ops_per_s = 0;
+    size_t early = 0;  // waits that returned before they were due
+};
+
+double percentile(vector<double>& xs, double p) {
+    if (xs.empty()) return 0;
+    auto i = xs.begin() + ptrdiff_t(double(xs.size() - 1) * p);
+    ranges::nth_element(xs, i);
+    return *i;
+}
+
+chrono::microseconds thread_cpu_time() {
+    timespec x{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &x);
+    auto since = chrono::seconds(x.tv_sec) + chrono::nanoseconds(x.tv_nsec);
+    return chrono::duration_cast<chrono::microseconds>(since);
+}
+
+Stats run(Mode const& mode, size_t sequences) {
+    Stats stats;
+    atomic<bool> done = false;
+    auto begin = Clock::now();
+
+    vector<double> overshoots;
+    thread sensor([&] {
+        if (!mode.wait) return;
+
+        auto cpu_begin = thread_cpu_time();
+        for (size_t i = 0; i < sequences; ++i)
+            for (auto wait : WAITS) {
+                auto begin = Clock::now();
+                mode.wait(wait);
+                auto overshoot = chrono::duration<double, micro>(Clock::now() - begin - wait).count();
+                overshoots.push_back(overshoot);
+                if (overshoot < 0) ++stats.early;
+            }
+
+        stats.cpu_us_per_sequence = double((thread_cpu_time() - cpu_begin) / 1us) / double(sequences);
+    });
+
+    vector<double> latencies;
+    thread periodic([&] {
+        auto next = Clock::now();
+        while (!done) {
+            next += TICK_PERIOD;
+            this_thread::sleep_until(next);
+            latencies.push_back(chrono::duration<double, micro>(Clock::now() - next).count());
+        }
+    });
+
+    thread background([&] {
+        uint64_t n = 0;
+        while (!done) {
+            ++n;
+            atomic_signal_fence(memory_order_seq_cst);
+        }
+        stats.background_ops_per_s = double(n) / chrono::duration<double>(Clock::now() - begin).count();
+    });
+
+    // NB: The baseline has no sensor task, run it for about as long as the sequences take.
+    if (mode.wait)
+        sensor.join();
+    else
+        this_thread::sleep_for(sequences * (WAITS[0] + WAITS[1] + WAITS[2] + WAITS[3] + WAITS[4]));
+    done = true;
+    if (sensor.joinable()) sensor.join();
+    periodic.join();
+    background.join();
+
+    stats.overshoot_us_median = percentile(overshoots, 0.5);
+    stats.overshoot_us_max = overshoots.empty() ? 0 : ranges::max(overshoots);
+    stats.latency_us_median = percentile(latencies, 0.5);
+    stats.latency_us_p99 = percentile(latencies, 0.99);
+    stats.latency_us_max = latencies.empty() ? 0 : ranges::max(latencies);
+    return stats;
+}
+
+void usage(char const* self) {
+    fprintf(stderr,
+            "usage: %s [--sequences <n>]\n"
+            "  --sequences  wait sequences per mode, default 100\n",
+            self);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t sequences = 100;
+    for (int i = 1; i < argc; ++i) {
+        string_view arg = argv[i];
+        if (arg == "--sequences" && i + 1 < argc)
+            sequences = size_t(atol(argv[++i]));
+        else {
+            usage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+
+    // one core, inherited by every thread (incl. the alarm thread)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(sched_getcpu(), &cpus);
+    if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) perror("WARN - sched_setaffinity, not on one CPU");
+
+    printf("%-12s %14s %14s %14s %12s %12s %12s %12s\n", "mode", "cpu us/seq", "late us med", "late us max",
+            "tick us med", "tick us p99", "tick us max", "background");
+
+    size_t early = 0;
+    double baseline = 0;
+    for (auto const& mode : MODES) {
+        auto x = run(mode, sequences);
+        if (!mode.wait) baseline = x.background_ops_per_s;
+        early += x.early;
+
+        printf("%-12s %14.1f %14.1f %14.1f %12.1f %12.1f %12.1f %11.1f%%\n", mode.name, x.cpu_us_per_sequence,
+                x.overshoot_us_median, x.overshoot_us_max, x.latency_us_median, x.latency_us_p99,
+                x.latency_us_max, baseline ? 100. * x.background_ops_per_s / baseline : 0.);
+    }
+
+    if (early) printf("FAIL: %zu wait(s) returned early\n", early);
+    return early ? 1 : 0;
+}
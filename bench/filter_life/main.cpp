@@ -0,0 +1,169 @@
+#include "utility/filter_life.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Replays a recorded trace through the firmware's filter life estimator (`utility/filter_life.hpp`), use it
+// to tune `FilterLifeLimits` against your own printer/media before changing the firmware defaults.
+//
+// Input is a CSV file with a header row and the following columns (any order, extras are ignored):
+//    timestamp   : seconds (any epoch, must be non-decreasing)
+//    voc_intake  : VOC index, empty/`nan` if not known
+//    voc_exhaust : VOC index, empty/`nan` if not known
+//    fan_power   : [0, 100] %
+
+using namespace std;
+using namespace nevermore;
+
+namespace {
+
+// firmware updates once per minute, anything larger is treated as a gap (e.g. powered off)
+constexpr double SAMPLE_GAP_MAX_SECONDS = 5 * 60;
+
+vector<string_view> split(string_view line) {
+    vector<string_view> xs;
+    for (;;) {
+        auto i = line.find(',');
+        xs.push_back(line.substr(0, i));
+        if (i == string_view::npos) return xs;
+        line.remove_prefix(i + 1);
+    }
+}
+
+// empty or garbage -> NaN
+double parse(string_view x) {
+    string s(x);
+    char* end = nullptr;
+    auto value = strtod(s.c_str(), &end);
+    return s.empty() || *end != '\0' ? NAN : value;
+}
+
+void report(FilterLife const& life, FilterLifeLimits const& limits, double hours) {
+    char efficiency[16] = "  ---";
+    if (life.efficiency_known()) snprintf(efficiency, sizeof(efficiency), "%5.1f%%", life.efficiency * 100);
+
+    printf("t=%9.1fh remaining=%5.1f%% efficiency=%s load=%10.0f run_hours=%7.1f\n", hours,
+            life.remaining(limits) * 100, efficiency, life.load, life.run_hours);
+}
+
+void usage(char const* self) {
+    FilterLifeLimits limits;
+    fprintf(stderr,
+            "usage: %s <trace.csv> [--capacity-load <x>] [--capacity-run-hours <x>] [--efficiency-new <x>]\n"
+            "       [--efficiency-spent <x>] [--report-every <hours>]\n"
+            "  --capacity-load       VOC index excess * hours @ full fan power, default %.0f\n"
+            "  --capacity-run-hours  hours @ full fan power, default %.0f\n"
+            "  --efficiency-new      efficiency -> 100%% remaining, default %.2f\n"
+            "  --efficiency-spent    efficiency -> 0%% remaining, default %.2f\n"
+            "  --report-every        print progress every n hours of trace time, 0 to disable, default 24\n",
+            self, limits.load, limits.run_hours, limits.efficiency_new, limits.efficiency_spent);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    char const* path = nullptr;
+    FilterLifeLimits limits;
+    double report_every = 24;
+
+    for (int i = 1; i < argc; ++i) {
+        string_view arg = argv[i];
+        auto value = [&]() -> double {
+            if (argc <= i + 1) {
+                usage(argv[0]);
+                exit(2);
+            }
+            return atof(argv[++i]);
+        };
+
+        if (arg == "--capacity-load") limits.load = float(value());
+        else if (arg == "--capacity-run-hours") limits.run_hours = float(value());
+        else if (arg == "--efficiency-new") limits.efficiency_new = float(value());
+        else if (arg == "--efficiency-spent") limits.efficiency_spent = float(value());
+        else if (arg == "--report-every") report_every = value();
+        else if (!path && !arg.starts_with("-")) path = argv[i];
+        else {
+            usage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+
+    if (!path) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    ifstream file(path);
+    if (!file) {
+        fprintf(stderr, "can't open `%s`\n", path);
+        return 1;
+    }
+
+    string line;
+    getline(file, line);
+    auto header = split(line);
+    auto column = [&](string_view name) -> optional<size_t> {
+        for (size_t i = 0; i < header.size(); ++i)
+            if (header[i] == name) return i;
+        return {};
+    };
+    auto col_timestamp = column("timestamp");
+    auto col_voc_intake = column("voc_intake");
+    auto col_voc_exhaust = column("voc_exhaust");
+    auto col_fan_power = column("fan_power");
+    if (!col_timestamp || !col_voc_intake || !col_voc_exhaust || !col_fan_power) {
+        fprintf(stderr, "missing column(s), need `timestamp,voc_intake,voc_exhaust,fan_power`\n");
+        return 1;
+    }
+
+    FilterLife life;
+    optional<double> t_begin;
+    optional<double> t_prev;
+    double next_report = report_every;
+    size_t gaps = 0;
+
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();  // CRLF
+        auto row = split(line);
+        auto field = [&](optional<size_t> i) { return *i < row.size() ? parse(row[*i]) : NAN; };
+
+        auto t = field(col_timestamp);
+        if (isnan(t)) continue;
+
+        if (!t_begin) t_begin = t;
+        if (t_prev) {
+            auto dt = t - *t_prev;
+            if (dt < 0) {
+                fprintf(stderr, "timestamp goes backwards at t=%g\n", t);
+                return 1;
+            }
+
+            if (SAMPLE_GAP_MAX_SECONDS < dt)
+                ++gaps;
+            else
+                life.update(field(col_voc_intake), field(col_voc_exhaust), field(col_fan_power) / 100,
+                        dt / 3600);
+        }
+        t_prev = t;
+
+        auto hours = (t - *t_begin) / 3600;
+        if (0 < report_every && next_report <= hours) {
+            report(life, limits, hours);
+            next_report += report_every;
+        }
+    }
+
+    if (!t_begin) {
+        fprintf(stderr, "trace is empty\n");
+        return 1;
+    }
+
+    if (gaps) printf("skipped %zu gap(s) > %.0fs\n", gaps, SAMPLE_GAP_MAX_SECONDS);
+    report(life, limits, (*t_prev - *t_begin) / 3600);
+    return 0;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+// Host stand-in for FreeRTOS' `FreeRTOS.h`. Declarations only: the benchmarked code never blocks, so no
+// kernel is linked. Anything that ends up calling into it fails to link, which is the point.
+// (`serial/host` & `delay/host` have thread backed `task.h`s for the few targets that do block.)
+
+#include <stdint.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFu)
+
+// same as `config/lib/FreeRTOSConfig.h`
+#define configTICK_RATE_HZ ((TickType_t)1000)
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2
+
+#define pdMS_TO_TICKS(ms) \
+    ((TickType_t)(((TickType_t)(ms) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000U))
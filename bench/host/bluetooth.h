@@ -0,0 +1,23 @@
+#pragma once
+
+// Host stand-in for BTstack's `bluetooth.h`: the ATT error codes `gatt/write_consumer.hpp` reports, and
+// the bits of the ATT/HCI vocabulary the wired GATT transport (`gatt/serial.cpp`) uses.
+// Values per the Bluetooth Core spec (Vol 3, Part F, 3.4.1.1 & Vol 1, Part F), same as BTstack's.
+
+#include <stdint.h>
+
+typedef uint16_t hci_con_handle_t;
+
+#define HCI_CON_HANDLE_INVALID 0xffff
+
+#define ATT_TRANSACTION_MODE_NONE 0x0
+
+#define ATT_ERROR_INVALID_PDU 0x04
+#define ATT_ERROR_REQUEST_NOT_SUPPORTED 0x06
+#define ATT_ERROR_INVALID_OFFSET 0x07
+#define ATT_ERROR_INVALID_ATTRIBUTE_VALUE_LENGTH 0x0d
+#define ATT_ERROR_VALUE_NOT_ALLOWED 0x13
+
+#define ERROR_CODE_SUCCESS 0x00
+#define ERROR_CODE_UNKNOWN_CONNECTION_IDENTIFIER 0x02
+#define ERROR_CODE_MEMORY_CAPACITY_EXCEEDED 0x07
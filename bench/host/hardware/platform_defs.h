@@ -0,0 +1,5 @@
+#pragma once
+
+// Host stand-in for the Pico SDK's `hardware/platform_defs.h`.
+
+#define SYS_CLK_KHZ 125000
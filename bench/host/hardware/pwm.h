@@ -0,0 +1,13 @@
+#pragma once
+
+// Host stand-in for the Pico SDK's `hardware/pwm.h`. Types only, nothing benchmarked drives a PWM slice.
+
+#include <stdint.h>
+
+enum pwm_chan { PWM_CHAN_A = 0, PWM_CHAN_B = 1 };
+
+typedef struct {
+    uint32_t csr;
+    uint32_t div;
+    uint32_t top;
+} pwm_config;
@@ -0,0 +1,8 @@
+#pragma once
+
+// Host stand-in for the Pico SDK's `hardware/spi.h`. Types only, nothing benchmarked touches a SPI bus.
+
+typedef struct spi_inst spi_inst_t;
+
+#define spi0 ((spi_inst_t*)0)
+#define spi1 ((spi_inst_t*)0)
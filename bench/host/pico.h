@@ -0,0 +1,10 @@
+#pragma once
+
+// Host stand-in for the Pico SDK's `pico.h`: just the `pico_w` board definitions `config/pins/pico_w.hpp`
+// validates against. Values match the SDK's `boards/pico_w.h`.
+
+#define RASPBERRYPI_PICO_W
+
+#define CYW43_PIN_WL_REG_ON 23u
+#define CYW43_PIN_WL_HOST_WAKE 24u
+#define PICO_VSYS_PIN 29
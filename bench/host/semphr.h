@@ -0,0 +1,21 @@
+#pragma once
+
+// Host stand-in for FreeRTOS' `semphr.h`. See `FreeRTOS.h`.
+
+#include "FreeRTOS.h"
+
+typedef struct QueueDefinition* SemaphoreHandle_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t);
+void vSemaphoreDelete(SemaphoreHandle_t);
+
+#ifdef __cplusplus
+}
+#endif
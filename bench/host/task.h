@@ -0,0 +1,9 @@
+#pragma once
+
+// Host stand-in for FreeRTOS' `task.h`. See `FreeRTOS.h`.
+// NB: Critical sections are no-ops, host tests & benchmarks are single threaded.
+
+#include "FreeRTOS.h"
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
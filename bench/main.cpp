@@ -0,0 +1,438 @@
+#include "bench.hpp"
+#include "gatt/dispatch.hpp"
+#include "gatt/write_consumer.hpp"
+#include "nevermore_gatt_dispatch.h"
+#include "revision.hpp"
+#include "sdk/ble_data_types.hpp"
+#include "sensors.hpp"
+#include "sensors/environmental.hpp"
+#include "sensors/gas_index.hpp"
+#include "sensors/sgp4x.hpp"
+#include "settings.hpp"
+#include "utility/crc.hpp"
+#include "utility/fan_policy_thermal.hpp"
+#include "utility/humidity.hpp"
+#include "utility/packed_tuple.hpp"
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+using namespace nevermore;
+using namespace nevermore::bench;
+
+namespace {
+
+constexpr int RESULTS_VERSION = 1;  // bump when the JSON layout changes
+
+// Inputs are cycled through a small table instead of being constants, so the optimiser can't fold the
+// benchmarked call away. Power of 2 size, the wrap is a mask.
+constexpr size_t INPUTS = 64;
+
+template <typename A>
+struct Inputs {
+    array<A, INPUTS> xs;
+    size_t i = 0;
+
+    A const& next() {
+        return xs[i++ & (INPUTS - 1)];
+    }
+};
+
+template <typename A, typename F>
+Inputs<A> mk_inputs(F&& f) {
+    Inputs<A> inputs;
+    for (size_t i = 0; i < INPUTS; ++i)
+        inputs.xs[i] = f(double(i) / INPUTS);
+    return inputs;
+}
+
+// Roughly what an SGP40/41 reports in clean-ish air, w/ a slow drift & some noise.
+int32_t sgp4x_raw(double t, int32_t base) {
+    return base + int32_t(800 * sin(t * 6.283) + 97 * ((int(t * 977) % 13) - 6));
+}
+
+template <typename Index, int32_t TYPE, int32_t BASE>
+Result gas_index(char const* name, Options const& options) {
+    settings::Settings settings{};
+    sensors::GasIndex index{TYPE};
+    auto raws = mk_inputs<int32_t>([](double t) { return sgp4x_raw(t, BASE); });
+    // NB: An hour of 1 Hz samples, well past the startup blackout. Steady state is the expensive path.
+    for (size_t i = 0; i < 3600; ++i)
+        keep(index.process<Index>(raws.next(), settings));
+
+    return measure(name, options, 0, [&] { keep(index.process<Index>(raws.next(), settings)); });
+}
+
+template <size_t N>
+Result crc8_(char const* name, Options const& options) {
+    auto data = mk_inputs<uint8_t>([](double t) { return uint8_t(t * 251); });
+    array<uint8_t, N> buffer{};
+    for (auto& x : buffer)
+        x = data.next();
+
+    return measure(name, options, N, [&] {
+        clobber();
+        keep(crc8(span<uint8_t const>(buffer), 0xFF));
+    });
+}
+
+template <size_t N>
+Result crc32_(char const* name, Options const& options) {
+    vector<uint8_t> buffer(N);
+    for (size_t i = 0; i < N; ++i)
+        buffer[i] = uint8_t(i * 131);
+
+    return measure(name, options, N, [&] {
+        clobber();
+        keep(crc32(buffer));
+    });
+}
+
+// Sensor words are CRC'd one at a time, via the `crc8(A const&)` overload.
+Result crc8_word(char const* name, Options const& options) {
+    auto words = mk_inputs<uint16_t>([](double t) { return uint16_t(t * 65521); });
+    return measure(name, options, sizeof(uint16_t), [&] { keep(crc8(words.next(), 0xFF)); });
+}
+
+// Typical degraded setup: intake has everything, exhaust has only a VOC sensor, chamber & aux are empty.
+sensors::Sensors sensors_sparse(uint8_t zones_used) {
+    using sensors::Zone;
+
+    sensors::Sensors x;
+    x.zones_used = zones_used;
+    x.temperature_mcu = 35.5;
+    x[Zone::Intake].temperature = 41.25;
+    x[Zone::Intake].humidity = 22.5;
+    x[Zone::Intake].pressure = 101'325;
+    x[Zone::Intake].voc_index = 180;
+    x[Zone::Intake].nox_index = 3;
+    x[Zone::Exhaust].voc_index = 95;
+    return x;
+}
+
+template <uint8_t ZONES>
+Result with_fallbacks(char const* name, Options const& options) {
+    sensors::g_config = {.fallback = true, .fallback_exhaust_mcu = true};
+    auto sensors = sensors_sparse(ZONES);
+    return measure(name, options, 0, [&] {
+        clobber();
+        keep(sensors.with_fallbacks(sensors::g_config));
+    });
+}
+
+Result v0(char const* name, Options const& options) {
+    auto sensors = sensors_sparse(sensors::ZONES_MAX);
+    return measure(name, options, 0, [&] {
+        clobber();
+        keep(sensors.v0());
+    });
+}
+
+Result fan_policy_thermal(char const* name, Options const& options) {
+    FanPolicyThermal policy{.min = 50, .max = 60, .coefficient = 30};
+    // sweeps below, through, and above the limiter's range
+    auto temperatures = mk_inputs<BLE::Temperature>([](double t) { return BLE::Temperature(40 + t * 30); });
+    return measure(name, options, 0, [&] { keep(policy(temperatures.next())); });
+}
+
+struct CompensationInput {
+    BLE::Temperature temperature;
+    BLE::Humidity humidity;
+};
+
+// What the SGP40/41 drivers do before each measurement.
+Result compensation_sgp4x(char const* name, Options const& options) {
+    sensors::EnvironmentalFilter side{sensors::Zone::Intake};
+    auto sensors = sensors_sparse(2);
+    auto xs = mk_inputs<CompensationInput>([](double t) {
+        return CompensationInput{BLE::Temperature(15 + t * 45), BLE::Humidity(5 + t * 90)};
+    });
+    return measure(name, options, 0, [&] {
+        auto& x = xs.next();
+        sensors[sensors::Zone::Intake].temperature = x.temperature;
+        sensors[sensors::Zone::Intake].humidity = x.humidity;
+        keep(sensors::sgp4x_tick(side.compensation_temperature(sensors, sensors::g_config)));
+        keep(sensors::sgp4x_tick(side.compensation_humidity(sensors, sensors::g_config)));
+    });
+}
+
+// The value `ui.cpp`'s `label_set` formats, e.g. pressure in hPa.
+Result label_value(char const* name, Options const& options) {
+    auto xs = mk_inputs<BLE::Pressure>([](double t) { return BLE::Pressure(95'000 + t * 10'000); });
+    return measure(name, options, 0, [&] { keep(xs.next().scaled<1e2>()); });
+}
+
+struct HumidityInput {
+    double relative;
+    double temperature;
+};
+
+template <typename N, N (*F)(N, N)>
+Result humidity_(char const* name, Options const& options) {
+    auto xs = mk_inputs<HumidityInput>([](double t) { return HumidityInput{5 + t * 90, 15 + t * 45}; });
+    return measure(name, options, 0, [&] {
+        auto& x = xs.next();
+        keep(F(N(x.relative), N(x.temperature)));
+    });
+}
+
+// Same shape as the SGP4x compensation parameters (`sgp40.cpp`, `sgp41.cpp`).
+Result packed_tuple_pack(char const* name, Options const& options) {
+    auto ticks = mk_inputs<uint16_t>([](double t) { return uint16_t(t * 65521); });
+    return measure(name, options, 0, [&] {
+        auto humidity = ticks.next();
+        auto temperature = ticks.next();
+        PackedTuple params{humidity, uint8_t(humidity), temperature, uint8_t(temperature)};
+        keep(params);
+    });
+}
+
+Result packed_tuple_sgp4x(char const* name, Options const& options) {
+    auto ticks = mk_inputs<uint16_t>([](double t) { return uint16_t(t * 65521); });
+    return measure(name, options, 0, [&] {
+        uint16_t humidity = byteswap(ticks.next());
+        uint16_t temperature = byteswap(ticks.next());
+        PackedTuple params{humidity, crc8(humidity, 0xFF), temperature, crc8(temperature, 0xFF)};
+        keep(params);
+    });
+}
+
+Result packed_tuple_get(char const* name, Options const& options) {
+    auto xs = mk_inputs<PackedTuple<uint16_t, uint8_t, uint16_t, uint8_t>>([](double t) {
+        return PackedTuple<uint16_t, uint8_t, uint16_t, uint8_t>{
+                uint16_t(t * 65521), uint8_t(t * 251), uint16_t(t * 32749), uint8_t(t * 127)};
+    });
+    return measure(name, options, 0, [&] {
+        auto& x = xs.next();
+        keep(get<0>(x) + get<1>(x) + get<2>(x) + get<3>(x));
+    });
+}
+
+// What `gatt/fan.cpp` does for `FAN_POWER_THERMAL_LIMIT` & friends.
+Result write_consumer_exactly(char const* name, Options const& options) {
+    FanPolicyThermal value{.min = 45, .max = 55, .coefficient = 20};
+    array<uint8_t, sizeof(value)> buffer{};
+    memcpy(buffer.data(), &value, sizeof(value));
+
+    return measure(name, options, buffer.size(), [&] {
+        clobber();
+        gatt::WriteConsumer consume{0, buffer.data(), uint16_t(buffer.size())};
+        keep(consume.exactly<FanPolicyThermal>());
+    });
+}
+
+// A multi-field write: a couple of scalars, then an optional trailing field.
+Result write_consumer_fields(char const* name, Options const& options) {
+    array<uint8_t, 8> buffer{0x40, 0x10, 0x27, 0xA0, 0x0F, 0x00, 0x00, 0x7D};
+
+    return measure(name, options, buffer.size(), [&] {
+        clobber();
+        gatt::WriteConsumer consume{0, buffer.data(), uint16_t(buffer.size())};
+        BLE::Percentage8 power = consume;
+        BLE::Temperature min = consume;
+        BLE::Temperature max = consume;
+        uint16_t reserved = consume;
+        auto extra = consume.or_default<uint8_t>(0);
+        keep(power);
+        keep(min);
+        keep(max);
+        keep(reserved);
+        keep(extra);
+    });
+}
+
+// Short writes are rejected by throwing, make sure that stays cheap enough.
+Result write_consumer_short(char const* name, Options const& options) {
+    array<uint8_t, sizeof(FanPolicyThermal) - 1> buffer{};
+
+    return measure(name, options, 0, [&] {
+        clobber();
+        gatt::WriteConsumer consume{0, buffer.data(), uint16_t(buffer.size())};
+        try {
+            keep(consume.exactly<FanPolicyThermal>());
+        } catch (gatt::AttrWriteException const& e) {
+            keep(e.error);
+        }
+    });
+}
+
+// Owner of each attribute, same as `gatt.cpp`'s.
+enum class GattHandler : uint8_t {
+    none,
+    configuration,
+    display,
+    environmental,
+    fan,
+    photocatalytic,
+    status,
+    ws2812,
+};
+
+// The profile's routes, from the same generated X-macro as `gatt.cpp`.
+// NB: `compile_gatt.py`'s handles need the SDK. Assigned in profile order instead, every other handle, about
+//     what it emits (each value sits between its declaration & descriptors).
+constexpr auto GATT_ROUTES = []() {
+    array xs{
+#define GATT_ROUTE(handler, handle) gatt::Route<GattHandler>{0, GattHandler::handler},
+            NEVERMORE_GATT_DISPATCH(GATT_ROUTE)
+#undef GATT_ROUTE
+    };
+    for (size_t i = 0; i < xs.size(); ++i)
+        xs[i].handle = uint16_t(2 * i + 3);
+    return xs;
+}();
+
+template <int Handler>
+[[gnu::noinline]] optional<uint16_t> gatt_attr_read(uint16_t attr) {
+    return uint16_t(attr + Handler);
+}
+
+// `gatt.cpp`'s `attr_read` up to & including the handler call, over every handle (routed or not).
+Result gatt_dispatch(char const* name, Options const& options) {
+    using Read = optional<uint16_t> (*)(uint16_t);
+    constexpr array<Read, 8> READ_HANDLERS{nullptr, gatt_attr_read<1>, gatt_attr_read<2>, gatt_attr_read<3>,
+            gatt_attr_read<4>, gatt_attr_read<5>, gatt_attr_read<6>, gatt_attr_read<7>};
+
+    uint16_t const handles = gatt::DISPATCH<GATT_ROUTES>.size() + 2;
+    uint16_t attr = 0;
+    return measure(name, options, 0, [&] {
+        attr = attr + 1 < handles ? attr + 1 : 0;
+        clobber();
+        if (auto handler = gatt::dispatch<GATT_ROUTES>(attr); handler != GattHandler::none)
+            keep(READ_HANDLERS.at(size_t(handler))(attr));
+    });
+}
+
+struct Benchmark {
+    char const* name;
+    Result (*run)(char const* name, Options const&);
+};
+
+// Names are stable keys for tracking results across commits. Don't rename w/o reason.
+constexpr Benchmark BENCHMARKS[]{
+        {"gas_index/voc", gas_index<sensors::VOCIndex, GasIndexAlgorithm_ALGORITHM_TYPE_VOC, 30'000>},
+        {"gas_index/nox", gas_index<sensors::NOxIndex, GasIndexAlgorithm_ALGORITHM_TYPE_NOX, 15'000>},
+        {"crc8/word", crc8_word},
+        {"crc8/256B", crc8_<256>},
+        {"crc32/256B", crc32_<256>},
+        {"crc32/4KiB", crc32_<settings::MAX_SIZE>},
+        {"with_fallbacks/2_zones", with_fallbacks<2>},
+        {"with_fallbacks/4_zones", with_fallbacks<sensors::ZONES_MAX>},
+        {"with_fallbacks/v0", v0},
+        {"fan_policy_thermal", fan_policy_thermal},
+        {"compensation/sgp4x", compensation_sgp4x},
+        {"scalar/label_value", label_value},
+        {"humidity/absolute/float", humidity_<float, humidity::absolute<float>>},
+        {"humidity/absolute/double", humidity_<double, humidity::absolute<double>>},
+        {"humidity/absolute_fast/float", humidity_<float, humidity::absolute_fast<float>>},
+        {"humidity/absolute_fast/double", humidity_<double, humidity::absolute_fast<double>>},
+        {"packed_tuple/pack", packed_tuple_pack},
+        {"packed_tuple/sgp4x_params", packed_tuple_sgp4x},
+        {"packed_tuple/get", packed_tuple_get},
+        {"write_consumer/exactly", write_consumer_exactly},
+        {"write_consumer/fields", write_consumer_fields},
+        {"write_consumer/short", write_consumer_short},
+        {"gatt/dispatch", gatt_dispatch},
+};
+
+void print_text(vector<Result> const& results) {
+    printf("nevermore-bench %s\n", NEVERMORE_BENCH_REVISION);
+    printf("%-32s %12s %12s %12s %14s %10s\n", "benchmark", "median ns", "min ns", "max ns", "iterations",
+            "MB/s");
+    for (auto const& x : results) {
+        printf("%-32s %12.2f %12.2f %12.2f %14llu", x.name.c_str(), x.ns_median, x.ns_min, x.ns_max,
+                (unsigned long long)x.iterations);
+        if (x.bytes_per_op)
+            printf(" %10.1f\n", x.bytes_per_second() / 1e6);
+        else
+            printf(" %10s\n", "-");
+    }
+}
+
+// Names & revision are plain ASCII w/o quotes/backslashes, no escaping needed.
+void print_json(vector<Result> const& results) {
+    printf("{\n");
+    printf("  \"version\": %d,\n", RESULTS_VERSION);
+    printf("  \"revision\": \"%s\",\n", NEVERMORE_BENCH_REVISION);
+    printf("  \"compiler\": \"%s\",\n", __VERSION__);
+    printf("  \"results\": [");
+    for (size_t i = 0; i < results.size(); ++i) {
+        auto const& x = results[i];
+        printf("%s\n    {\"name\": \"%s\", \"iterations\": %llu, \"ns_median\": %.3f, \"ns_min\": %.3f, "
+               "\"ns_max\": %.3f",
+                i ? "," : "", x.name.c_str(), (unsigned long long)x.iterations, x.ns_median, x.ns_min,
+                x.ns_max);
+        if (x.bytes_per_op)
+            printf(", \"bytes_per_op\": %zu, \"bytes_per_second\": %.0f", x.bytes_per_op,
+                    x.bytes_per_second());
+        printf("}");
+    }
+    printf("\n  ]\n}\n");
+}
+
+void usage(char const* self) {
+    fprintf(stderr,
+            "usage: %s [--json] [--list] [--filter <substring>] [--min-time <ms>]\n"
+            "  --json      machine readable results on stdout\n"
+            "  --list      list benchmark names & exit\n"
+            "  --filter    only run benchmarks whose name contains <substring>\n"
+            "  --min-time  time spent per benchmark, default 200 ms\n",
+            self);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool json = false;
+    bool list = false;
+    string_view filter;
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        string_view arg = argv[i];
+        auto value = [&]() -> char const* {
+            if (argc <= i + 1) {
+                usage(argv[0]);
+                exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--json") json = true;
+        else if (arg == "--list") list = true;
+        else if (arg == "--filter") filter = value();
+        else if (arg == "--min-time") options.min_time = chrono::milliseconds(atol(value()));
+        else {
+            usage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+
+    vector<Result> results;
+    for (auto const& x : BENCHMARKS) {
+        if (!string_view(x.name).contains(filter)) continue;
+
+        if (list)
+            printf("%s\n", x.name);
+        else
+            results.push_back(x.run(x.name, options));
+    }
+
+    if (list) return 0;
+
+    if (json)
+        print_json(results);
+    else
+        print_text(results);
+
+    return 0;
+}
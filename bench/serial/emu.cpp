@@ -0,0 +1,250 @@
+#include "gatt.hpp"
+#include "gatt/serial.hpp"
+#include "pico/stdio.h"
+#include "pico/stdio/driver.h"
+#include "semphr.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <initializer_list>
+#include <mutex>
+#include <poll.h>
+#include <pty.h>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// Runs the wired GATT transport (`gatt/serial.cpp`) on a pty, in front of a small fake attribute DB.
+// Prints the pty's path, then serves until killed. `test.py` drives it w/ `SerialGattClient`.
+
+using namespace std;
+
+namespace {
+
+int g_pty = -1;  // controller side
+mutex g_pty_out;
+
+void (*g_chars_available)(void*) = nullptr;
+void* g_chars_available_param = nullptr;
+
+// Attribute DB in BTstack's compiled format (`profile_data`): version, { size, flags, handle, uuid, value }*,
+// then a 0 size terminator. All little endian.
+enum : uint16_t {
+    FLAG_READ = 0x0002,
+    FLAG_WRITE_WITHOUT_RESPONSE = 0x0004,
+    FLAG_WRITE = 0x0008,
+    FLAG_NOTIFY = 0x0010,
+    FLAG_DYNAMIC = 0x0100,
+    FLAG_UUID128 = 0x0200,
+};
+
+// Handles of the attributes `test.py` exercises.
+enum : uint16_t {
+    ATTR_NOTIFY = 3,       // dynamic read + notify, a counter
+    ATTR_NOTIFY_CCC = 4,
+    ATTR_WRITE_CMD = 6,    // write w/o response, stored in `g_written`
+    ATTR_STATIC = 8,       // static read, served by the host from the DB
+    ATTR_LONG = 10,        // dynamic read, longer than one ATT value
+    ATTR_READ_WRITE = 12,  // write, reads back `g_written`
+};
+
+using Bytes = vector<uint8_t>;
+
+Bytes u16(uint16_t x) {
+    return {uint8_t(x), uint8_t(x >> 8)};
+}
+
+// `xxxxxxxx-xxxx-...` -> little endian
+Bytes u128(string_view uuid) {
+    Bytes hex;
+    for (auto c : uuid)
+        if (c != '-') hex.push_back(uint8_t(c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10));
+
+    Bytes out;
+    for (size_t i = hex.size(); 2 <= i; i -= 2)
+        out.push_back(uint8_t(hex[i - 2] << 4 | hex[i - 1]));
+    return out;
+}
+
+Bytes cat(initializer_list<Bytes> xs) {
+    Bytes out;
+    for (auto&& x : xs)
+        out.insert(out.end(), x.begin(), x.end());
+    return out;
+}
+
+constexpr char const* UUID_SERVICE = "d903600a-c268-4225-a0f6-5659160acafc";
+constexpr char const* UUID_NOTIFY = "5054026d-913e-45fc-a1f6-0500b5c9ab8d";
+constexpr char const* UUID_WRITE_CMD = "5d91b6ce-7779-4d3a-a8b1-7e5ef3c8b7f0";
+
+Bytes mk_database() {
+    Bytes db{1};  // version
+    auto attr = [&](uint16_t flags, uint16_t handle, Bytes const& type, Bytes const& value) {
+        auto size = uint16_t(6 + type.size() + value.size());
+        db = cat({db, u16(size), u16(flags), u16(handle), type, value});
+    };
+    auto characteristic = [&](uint8_t properties, uint16_t handle, Bytes const& type) {
+        attr(FLAG_READ, handle - 1, u16(0x2803), cat({{properties}, u16(handle), type}));
+    };
+
+    attr(FLAG_READ, 1, u16(0x2800), u128(UUID_SERVICE));
+    characteristic(0x12, ATTR_NOTIFY, u128(UUID_NOTIFY));
+    attr(FLAG_READ | FLAG_NOTIFY | FLAG_DYNAMIC | FLAG_UUID128, ATTR_NOTIFY, u128(UUID_NOTIFY), {});
+    attr(FLAG_READ | FLAG_WRITE | FLAG_DYNAMIC, ATTR_NOTIFY_CCC, u16(0x2902), {});
+    characteristic(0x04, ATTR_WRITE_CMD, u128(UUID_WRITE_CMD));
+    attr(FLAG_WRITE_WITHOUT_RESPONSE | FLAG_DYNAMIC | FLAG_UUID128, ATTR_WRITE_CMD, u128(UUID_WRITE_CMD), {});
+    characteristic(0x02, ATTR_STATIC, u16(0x2a28));
+    attr(FLAG_READ, ATTR_STATIC, u16(0x2a28), {'v', '1', '.', '0'});
+    characteristic(0x02, ATTR_LONG, u16(0x2a29));
+    attr(FLAG_READ | FLAG_DYNAMIC, ATTR_LONG, u16(0x2a29), {});
+    characteristic(0x0a, ATTR_READ_WRITE, u16(0x2a2a));
+    attr(FLAG_READ | FLAG_WRITE | FLAG_DYNAMIC, ATTR_READ_WRITE, u16(0x2a2a), {});
+    return cat({db, u16(0)});
+}
+
+Bytes const g_database = mk_database();
+Bytes g_long = [] {
+    Bytes xs(1000);
+    for (size_t i = 0; i < xs.size(); ++i)
+        xs[i] = uint8_t(i * 7);
+    return xs;
+}();
+
+// Only touched from the GATT context (the serial task), except `g_subscribed`.
+Bytes g_written;
+uint32_t g_counter = 0;
+atomic<bool> g_subscribed = false;
+
+btstack_context_callback_registration_t g_notify_counter{.callback = [](void*) {
+    ++g_counter;
+    nevermore::gatt::serial::notify(ATTR_NOTIFY, {reinterpret_cast<uint8_t const*>(&g_counter), 4});
+}};
+
+}  // namespace
+
+// Pico SDK/FreeRTOS/BTstack surface `gatt/serial.cpp` links against.
+extern "C" {
+
+bool stdio_usb_connected() {
+    return true;
+}
+
+stdio_driver_t stdio_usb{
+        .out_chars =
+                [](char const* buf, int len) {
+                    lock_guard lock(g_pty_out);
+                    while (0 < len) {
+                        auto n = write(g_pty, buf, size_t(len));
+                        if (0 < n) {
+                            buf += n;
+                            len -= int(n);
+                        } else
+                            this_thread::sleep_for(100us);  // pty buffer full, host is behind
+                    }
+                },
+        .in_chars =
+                [](char* buf, int len) {
+                    auto n = read(g_pty, buf, size_t(len));
+                    return 0 < n ? int(n) : -3;  // `PICO_ERROR_NO_DATA`
+                },
+};
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return nullptr;  // only used w/ `NEVERMORE_PICO_W_BT`
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) {
+    abort();  // only used w/ `NEVERMORE_PICO_W_BT`
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t) {
+    abort();  // only used w/ `NEVERMORE_PICO_W_BT`
+}
+
+void btstack_run_loop_execute_on_main_thread(btstack_context_callback_registration_t*) {
+    abort();  // only used w/ `NEVERMORE_PICO_W_BT`
+}
+}
+
+void stdio_set_chars_available_callback(void (*fn)(void*), void* param) {
+    g_chars_available = fn;
+    g_chars_available_param = param;
+}
+
+namespace nevermore::gatt {
+
+span<uint8_t const> database() {
+    return g_database;
+}
+
+uint16_t attr_read(hci_con_handle_t, uint16_t attr, uint16_t offset, uint8_t* buffer, uint16_t buffer_size) {
+    span<uint8_t const> value;
+    switch (attr) {
+    case ATTR_NOTIFY: value = {reinterpret_cast<uint8_t const*>(&g_counter), 4}; break;
+    case ATTR_LONG: value = g_long; break;
+    case ATTR_READ_WRITE: value = g_written; break;
+    default: break;
+    }
+
+    if (value.size() < offset) return 0;
+    auto n = min<size_t>(value.size() - offset, buffer_size);
+    memcpy(buffer, value.data() + offset, n);
+    return uint16_t(n);
+}
+
+int attr_write(hci_con_handle_t, uint16_t attr, uint16_t, uint16_t, uint8_t* buffer, uint16_t buffer_size) {
+    switch (attr) {
+    case ATTR_NOTIFY_CCC:
+        if (buffer_size != 2) return ATT_ERROR_INVALID_ATTRIBUTE_VALUE_LENGTH;
+        g_subscribed = buffer[0] & 1;
+        return 0;
+
+    case ATTR_WRITE_CMD:
+    case ATTR_READ_WRITE: g_written.assign(buffer, buffer + buffer_size); return 0;
+
+    default: return 0x03;  // ATT write not permitted
+    }
+}
+
+void disconnected(hci_con_handle_t) {
+    g_subscribed = false;
+}
+
+}  // namespace nevermore::gatt
+
+int main() {
+    int host = -1;
+    if (openpty(&g_pty, &host, nullptr, nullptr, nullptr) != 0) {
+        perror("openpty");
+        return 1;
+    }
+    fcntl(g_pty, F_SETFL, fcntl(g_pty, F_GETFL) | O_NONBLOCK);
+    printf("%s\n", ttyname(host));
+    fflush(stdout);
+
+    nevermore::gatt::serial::init();
+
+    // Stands in for the USB IRQ & the firmware's periodic notifications, w/ some log text interleaved.
+    auto next_notify = chrono::steady_clock::now();
+    for (uint32_t ticks = 0;;) {
+        pollfd fd{.fd = g_pty, .events = POLLIN};
+        if (0 < poll(&fd, 1, 5) && g_chars_available) {
+            g_chars_available(g_chars_available_param);
+            this_thread::sleep_for(200us);  // let the task drain it, else we'd spin on the same input
+        }
+
+        if (next_notify <= chrono::steady_clock::now()) {
+            next_notify += 20ms;
+            if (g_subscribed) nevermore::gatt::serial::request_to_send(g_notify_counter);
+            if (ticks++ % 50 == 0) {
+                lock_guard lock(g_pty_out);
+                constexpr string_view LOG = "INFO - interleaved log line\n";
+                (void)!write(g_pty, LOG.data(), LOG.size());
+            }
+        }
+    }
+}
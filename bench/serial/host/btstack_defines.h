@@ -0,0 +1,12 @@
+#pragma once
+
+// Host stand-in for BTstack's `btstack_defines.h`. Same layout, the transport links the callback
+// registration into its pending list.
+
+#include "btstack_linked_list.h"
+
+typedef struct btstack_context_callback_registration {
+    btstack_linked_item_t item;
+    void (*callback)(void* context);
+    void* context;
+} btstack_context_callback_registration_t;
@@ -0,0 +1,40 @@
+#pragma once
+
+// Host stand-in for BTstack's `btstack_linked_list.h`. Same semantics, e.g. adding an item that's already
+// in the list is a no-op that returns `false`.
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct btstack_linked_item {
+    struct btstack_linked_item* next;
+} btstack_linked_item_t;
+
+typedef btstack_linked_item_t* btstack_linked_list_t;
+
+inline bool btstack_linked_list_add_tail(btstack_linked_list_t* list, btstack_linked_item_t* item) {
+    btstack_linked_item_t* it = (btstack_linked_item_t*)list;
+    for (; it->next; it = it->next)
+        if (it->next == item) return false;
+
+    item->next = NULL;
+    it->next = item;
+    return true;
+}
+
+inline bool btstack_linked_list_remove(btstack_linked_list_t* list, btstack_linked_item_t* item) {
+    for (btstack_linked_item_t* it = (btstack_linked_item_t*)list; it && it->next; it = it->next) {
+        if (it->next == item) {
+            it->next = item->next;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline btstack_linked_item_t* btstack_linked_list_pop(btstack_linked_list_t* list) {
+    btstack_linked_item_t* item = *list;
+    if (item) *list = item->next;
+    return item;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+// Host stand-in for BTstack's `btstack_run_loop.h`. Declaration only: the emulator is built w/o
+// `NEVERMORE_PICO_W_BT`, the serial task is the GATT context & never defers to a run loop.
+
+#include "btstack_defines.h"
+
+void btstack_run_loop_execute_on_main_thread(btstack_context_callback_registration_t*);
@@ -0,0 +1,6 @@
+#pragma once
+
+// Host stand-in for the Pico SDK's `pico/stdio.h`. `serial_emu.cpp` defines it & calls the callback when
+// the pty has input, standing in for the USB IRQ.
+
+void stdio_set_chars_available_callback(void (*fn)(void*), void* param);
@@ -0,0 +1,8 @@
+#pragma once
+
+// Host stand-in for the Pico SDK's `pico/stdio/driver.h`: only the members `gatt/serial.cpp` uses.
+
+typedef struct stdio_driver {
+    void (*out_chars)(char const* buf, int len);
+    int (*in_chars)(char* buf, int len);  // `PICO_ERROR_NO_DATA` (< 0) if there's nothing to read
+} stdio_driver_t;
@@ -0,0 +1,44 @@
+#pragma once
+
+// Host stand-in for FreeRTOS' `task.h`, for the serial transport emulator. Unlike `bench/host/task.h` it's
+// backed by real threads: tasks are `std::thread`s (see `utility/task.hpp`), critical sections a mutex, and
+// task notifications a semaphore.
+
+#include "FreeRTOS.h"
+#include <mutex>
+#include <semaphore>
+
+typedef struct tskTaskControlBlock* TaskHandle_t;
+
+#define portYIELD_FROM_ISR(woken) (void)(woken)
+
+namespace nevermore::host {
+
+inline std::recursive_mutex g_critical;
+// NB: Shared by all tasks, the emulator only runs the one.
+inline std::counting_semaphore<> g_notify{0};
+
+}  // namespace nevermore::host
+
+#define taskENTER_CRITICAL() nevermore::host::g_critical.lock()
+#define taskEXIT_CRITICAL() nevermore::host::g_critical.unlock()
+
+// NB: Ignores the timeout, the transport only ever waits w/ `portMAX_DELAY`.
+inline uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t) {
+    nevermore::host::g_notify.acquire();
+    uint32_t n = 1;
+    if (clear_on_exit)
+        while (nevermore::host::g_notify.try_acquire())
+            ++n;
+    return n;
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t) {
+    nevermore::host::g_notify.release();
+    return pdTRUE;
+}
+
+inline void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken) {
+    xTaskNotifyGive(task);
+    if (woken) *woken = pdTRUE;
+}
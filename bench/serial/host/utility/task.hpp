@@ -0,0 +1,37 @@
+#pragma once
+
+// Host stand-in for `src/utility/task.hpp`: tasks are detached `std::thread`s, stacks & priorities are the
+// host's business.
+
+#include "task.h"
+#include <cstdint>
+#include <thread>
+
+namespace nevermore {
+
+enum class Priority {
+    Idle = 0,
+    Display,
+    Sensors,
+    Communication,
+    Startup,
+};
+
+template <uint32_t StackDepth>
+struct TaskStorage {};
+
+struct Task {
+    TaskHandle_t release() {
+        return nullptr;
+    }
+};
+
+template <uint32_t StackDepth>
+constexpr auto mk_task(char const*, Priority, TaskStorage<StackDepth>&) {
+    return [](auto go) {
+        std::thread(go).detach();
+        return Task{};
+    };
+}
+
+}  // namespace nevermore
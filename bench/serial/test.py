@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+
+# End-to-end test of the wired GATT transport: `SerialGattClient` against `gatt/serial.cpp` on a pty.
+#
+# Copyright (C) 2023       Sanaa Hamel
+#
+# This file may be distributed under the terms of the GNU AGPLv3 license.
+
+__doc__ = """End-to-end test of the wired GATT transport.
+
+Runs `nevermore-serial-emu` (`gatt/serial.cpp` on a pty, w/ a small fake attribute DB) and drives it w/
+`tools/nevermore_utilities.py`'s `SerialGattClient`. Run by `ctest`, exits 77 (skipped) if the tools'
+Python deps aren't installed.
+
+usage: test.py <path to nevermore-serial-emu>
+"""
+
+import asyncio
+import subprocess
+import sys
+from pathlib import Path
+
+EXIT_SKIPPED = 77
+
+sys.path.insert(0, str(Path(__file__).resolve().parents[2] / "tools"))
+try:
+    from nevermore_utilities import (
+        SerialGattClient,
+        SerialGattError,
+        SerialOp,
+        short_uuid,
+    )
+except ImportError as e:
+    print(f"skipped, tools' Python deps aren't installed: {e}")
+    sys.exit(EXIT_SKIPPED)
+
+# Must match `emu.cpp`
+UUID_NOTIFY = "5054026d-913e-45fc-a1f6-0500b5c9ab8d"
+UUID_WRITE_CMD = "5d91b6ce-7779-4d3a-a8b1-7e5ef3c8b7f0"
+ATTR_NOT_WRITABLE = 8
+LONG_VALUE = bytes((i * 7) & 0xFF for i in range(1000))
+
+
+async def check(path: str):
+    async with SerialGattClient(path) as client:
+        services = client.services
+
+        def char(uuid):
+            x = services.get_characteristic(uuid)
+            assert x is not None, f"characteristic {uuid} missing from the DB"
+            return x
+
+        notify = char(UUID_NOTIFY)
+        assert len(notify.descriptors) == 1, "CCC descriptor missing"
+
+        # static values are served from the DB, dynamic ones by the controller
+        assert await client.read_gatt_char(char(short_uuid(0x2A28))) == b"v1.0"
+        assert len(await client.read_gatt_char(notify)) == 4
+
+        # longer than one ATT value, read in chunks
+        assert await client.read_gatt_char(char(short_uuid(0x2A29))) == LONG_VALUE
+
+        read_write = char(short_uuid(0x2A2A))
+        value = bytes(range(256)) * 2  # `VALUE_MAX`
+        await client.write_gatt_char(read_write, value, response=True)
+        assert await client.read_gatt_char(read_write) == value
+
+        # w/o response: pipelined, the next request is a barrier
+        for i in range(64):
+            await client.write_gatt_char(char(UUID_WRITE_CMD), bytes([i, 0]) * 8)
+        assert await client.read_gatt_char(read_write) == bytes([63, 0]) * 8
+
+        got = []
+        await client.start_notify(notify, lambda _, x: got.append(bytes(x)))
+        await asyncio.sleep(0.5)
+        await client.stop_notify(notify)
+        assert got, "no notifications"
+        counts = [int.from_bytes(x, "little") for x in got]
+        assert counts == sorted(counts), f"notifications out of order: {counts}"
+
+        try:
+            await client._request(SerialOp.WRITE, ATTR_NOT_WRITABLE, b"x")
+            raise AssertionError("write to a read-only attribute succeeded")
+        except SerialGattError as e:
+            assert e.status == 0x03, e
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__)
+        sys.exit(2)
+
+    emu = subprocess.Popen([sys.argv[1]], stdout=subprocess.PIPE, text=True)
+    try:
+        assert emu.stdout is not None
+        path = emu.stdout.readline().strip()
+        asyncio.run(asyncio.wait_for(check(path), timeout=30))
+    finally:
+        emu.kill()
+        emu.wait()
+
+    print("ok")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,215 @@
+#include "sdk/ble_data_types.hpp"
+#include "sensors.hpp"
+#include "sensors/environmental.hpp"
+#include "sensors/fusion.hpp"
+#include "sensors/gas_index.hpp"
+#include "sensors/sgp4x.hpp"
+#include "settings.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <span>
+
+using namespace std;
+using namespace nevermore;
+
+// Host tests for the firmware's pure logic, run by `ctest`. No framework, a failed check prints & counts.
+namespace {
+
+size_t g_failures = 0;
+
+#define CHECK(cond, format, ...)                                                                             \
+    do {                                                                                                     \
+        if (!(cond)) {                                                                                       \
+            ++g_failures;                                                                                    \
+            printf("FAIL %s:%d: " format "\n", __FILE__, __LINE__ __VA_OPT__(, ) __VA_ARGS__);              \
+        }                                                                                                    \
+    } while (0)
+
+using Fusion = sensors::Fusion<BLE::Temperature>;
+
+// One driver report & the estimate it must produce. `nullopt` -> `NOT_KNOWN`.
+struct Report {
+    int at_s;
+    int source;
+    optional<double> value;
+    optional<double> expected;
+};
+
+// NB: Constant readings per source keep every jitter at the floor, so the estimate is a plain mean of the
+//     live, non-outlier sources.
+constexpr Report FUSION_REPLAY[]{
+        {0, 0, 20, 20},
+        {1, 1, 22, 21},
+        {2, 2, 21, 21},
+        {3, 3, 30, 21},             // outlier vs the median (21), ignored. Every slot is now taken.
+        {4, 4, nullopt, 21},        // untracked source going away mustn't evict a live one (used to drop 0)
+        {5, 0, 20, 21},             // ... so 0 is still tracked
+        {6, 1, nullopt, 20.5},      // removes itself
+        {30, 2, 21, 21},            // 0 & 3 went silent for > `STALE_AFTER`, dropped
+        {31, 4, 23, 22},            // 2 sources, averaged
+        {32, 2, nullopt, 23},
+        {33, 4, nullopt, nullopt},  // nothing left
+        {34, 5, nullopt, nullopt},  // untracked source going away from an empty table
+};
+
+void fusion_replay() {
+    Fusion fusion{2, 0.05};
+    int ids[6]{};  // addresses stand in for the drivers
+
+    for (auto const& x : FUSION_REPLAY) {
+        auto value = x.value ? BLE::Temperature(*x.value) : BLE::Temperature(BLE::NOT_KNOWN);
+        auto at = Fusion::Clock::time_point{} + chrono::seconds(x.at_s);
+        auto estimate = fusion.update(&ids[x.source], value, at);
+
+        if (x.expected)
+            CHECK(estimate != BLE::NOT_KNOWN && abs(estimate.value_or(0) - *x.expected) < 0.01,
+                    "fusion replay t=%ds: expected %.2f, got %.2f", x.at_s, *x.expected,
+                    estimate.value_or(NAN));
+        else
+            CHECK(estimate == BLE::NOT_KNOWN, "fusion replay t=%ds: expected not-known, got %.2f", x.at_s,
+                    estimate.value_or(NAN));
+    }
+}
+
+// A noisy source counts for less than a steady one.
+void fusion_jitter() {
+    Fusion fusion{2, 0.05};
+    int noisy{};
+    int steady{};
+
+    BLE::Temperature estimate;
+    for (int i = 0; i < 20; ++i) {
+        auto at = Fusion::Clock::time_point{} + chrono::seconds(i);
+        fusion.update(&noisy, BLE::Temperature(i % 2 ? 21 : 19), at);
+        estimate = fusion.update(&steady, BLE::Temperature(25), at);
+    }
+
+    CHECK(24 < estimate.value_or(0), "fusion jitter: expected ~25, got %.2f", estimate.value_or(NAN));
+}
+
+// Running mean & standard deviation (Welford).
+struct Spread {
+    size_t n = 0;
+    double mean = 0;
+    double m2 = 0;
+
+    void add(double x) {
+        auto delta = x - mean;
+        mean += delta / double(++n);
+        m2 += delta * (x - mean);
+    }
+
+    [[nodiscard]] double sd() const {
+        return n < 2 ? 0 : sqrt(m2 / double(n - 1));
+    }
+};
+
+struct CompensationSpread {
+    Spread temperature;  // `sgp4x_tick`s
+    Spread humidity;     // `sgp4x_tick`s
+    Spread voc_index;
+};
+
+// Two drivers reporting T/H for the intake, in steady air (40 c, 30 %): a noisy one w/ a positive bias, &
+// a steadier one w/ a negative bias that drops out (reports not-known) for 30 s every 10 min. Each second
+// the SGP4x driver compensates w/ whatever the zone's slot holds, same as `sgp40.cpp`/`sgp41.cpp`.
+// `fused` -> slot is written through `Fusion` (`EnvironmentalFilter::set`), otherwise the last writer
+// wins (the slot's behaviour before fusion).
+CompensationSpread compensation_replay(bool fused) {
+    using sensors::Zone;
+    constexpr auto TEMPERATURE = 40.;
+    constexpr auto HUMIDITY = 30.;
+    constexpr int DURATION_S = 3 * 60 * 60;
+    constexpr int SETTLE_S = 60 * 60;  // let the gas index learn its baseline first
+
+    // Stand-in for the sensor's on-chip compensation: raw signal moves w/ the error in its T/H params.
+    // Ballpark gains, raw ticks per c/%.
+    constexpr double RAW_PER_C = 10;
+    constexpr double RAW_PER_PERCENT = 25;
+    constexpr int32_t RAW_BASE = 30'000;
+
+    settings::Settings settings{};
+    sensors::Config config{.fallback = true};
+    sensors::Sensors sensors;
+    sensors.temperature_mcu = 35;  // what compensation falls back to w/o a reading
+    sensors::EnvironmentalFilter side{Zone::Intake};
+    sensors::ZoneFusion fusion;
+    sensors::GasIndex index;
+    int noisy{};
+    int dropping{};
+
+    // NB: Same seed & draw order for both paths, they see identical readings.
+    minstd_rand rng{0x6e65};
+    auto noise = [&]() { return double(rng() - rng.min()) / double(rng.max() - rng.min()) * 2 - 1; };
+
+    auto report = [&](void const* id, optional<double> t, optional<double> h, Fusion::Clock::time_point at) {
+        auto temperature = t ? BLE::Temperature(*t) : BLE::Temperature(BLE::NOT_KNOWN);
+        auto humidity = h ? BLE::Humidity(*h) : BLE::Humidity(BLE::NOT_KNOWN);
+        if (fused) {
+            temperature = fusion.temperature.update(id, temperature, at);
+            humidity = fusion.humidity.update(id, humidity, at);
+        }
+        sensors[Zone::Intake].temperature = temperature;
+        sensors[Zone::Intake].humidity = humidity;
+    };
+
+    CompensationSpread spread;
+    for (int i = 0; i < DURATION_S; ++i) {
+        auto at = Fusion::Clock::time_point{} + chrono::seconds(i);
+        auto noisy_t = TEMPERATURE + 0.3 + 0.3 * noise();
+        auto noisy_h = HUMIDITY + 1.0 + 1.5 * noise();
+        auto dropping_t = TEMPERATURE - 0.3 + 0.05 * noise();
+        auto dropping_h = HUMIDITY - 1.0 + 0.3 * noise();
+        auto raw_noise = 20 * noise();
+
+        report(&noisy, noisy_t, noisy_h, at);
+        if (i % 600 < 30)
+            report(&dropping, nullopt, nullopt, at);
+        else
+            report(&dropping, dropping_t, dropping_h, at);
+
+        auto tick_t = sensors::sgp4x_tick(side.compensation_temperature(sensors, config));
+        auto tick_h = sensors::sgp4x_tick(side.compensation_humidity(sensors, config));
+        auto error_t = int(tick_t) - sensors::sgp4x_tick(BLE::Temperature(TEMPERATURE));
+        auto error_h = int(tick_h) - sensors::sgp4x_tick(BLE::Humidity(HUMIDITY));
+        auto raw = RAW_BASE + RAW_PER_C * error_t * 175 / UINT16_MAX +
+                   RAW_PER_PERCENT * error_h * 100 / UINT16_MAX + raw_noise;
+        auto voc = index.process(int32_t(lround(raw)), settings);
+
+        if (i < SETTLE_S) continue;
+        spread.temperature.add(tick_t);
+        spread.humidity.add(tick_h);
+        spread.voc_index.add(voc.value_or(0));
+    }
+
+    return spread;
+}
+
+// Fusing the drivers must steady the SGP4x's compensation input, & the VOC index it drives.
+void fusion_voc_compensation() {
+    auto last = compensation_replay(false);
+    auto fused = compensation_replay(true);
+
+    CHECK(fused.temperature.sd() < last.temperature.sd(),
+            "compensation temperature sd: fused %.1f, last %.1f", fused.temperature.sd(),
+            last.temperature.sd());
+    CHECK(fused.humidity.sd() < last.humidity.sd(), "compensation humidity sd: fused %.1f, last %.1f",
+            fused.humidity.sd(), last.humidity.sd());
+    CHECK(fused.voc_index.sd() < last.voc_index.sd(), "VOC index sd: fused %.2f, last %.2f",
+            fused.voc_index.sd(), last.voc_index.sd());
+}
+
+}  // namespace
+
+int main() {
+    fusion_replay();
+    fusion_jitter();
+    fusion_voc_compensation();
+
+    if (g_failures) printf("%zu failure(s)\n", g_failures);
+    return g_failures ? 1 : 0;
+}
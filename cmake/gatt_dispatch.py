@@ -0,0 +1,240 @@
+# Generates the GATT dispatch table from a BTstack `.gatt` profile
+#
+# Copyright (C) 2024       Sanaa Hamel
+#
+# This file may be distributed under the terms of the GNU AGPLv3 license.
+
+__doc__ = """Generates the GATT dispatch table from a BTstack `.gatt` profile.
+
+Emits an X-macro listing every `DYNAMIC` attribute (values & descriptors) w/ the `gatt/` handler that owns
+it, keyed by the `ATT_CHARACTERISTIC_*_HANDLE` macros `compile_gatt.py` emits for the same profile.
+`gatt.cpp` expands it into a dense handle -> handler table.
+
+Fails if a service w/ `DYNAMIC` attributes has no handler, so a new service can't silently go unanswered.
+W/ `--handlers`, also fails if a handler's `attr_read`/`attr_write` case labels (see
+`gatt/handler_helpers.hpp`) don't answer exactly the attributes routed to it.
+"""
+
+import argparse
+import csv
+import re
+import sys
+from collections import defaultdict
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+# service UUID (as written in the profile) -> `nevermore::gatt::<handler>` namespace
+SERVICE_HANDLERS: Dict[str, str] = {
+    "ORG_BLUETOOTH_SERVICE_ENVIRONMENTAL_SENSING": "environmental",
+    "4553d138-1d00-4b6f-bc42-955a89cf8c36": "fan",  # Fan
+    "260a0845-e62f-48c6-aef9-04f62ff8bffd": "fan",  # Fan Control Policy
+    "f62918ab-33b7-4f47-9fba-8ce9de9fecbb": "ws2812",  # NeoPixel
+    "7be8ac4b-7eb4-4e09-b134-91a46b622832": "display",
+    "de44dd71-2400-4cd1-a3f3-9fb00c4697d7": "photocatalytic",
+    "d903600a-c268-4225-a0f6-5659160acafc": "status",
+    "b5078b20-aea3-4c37-a18f-b370c03f02a6": "configuration",
+}
+
+SERVICE_KINDS = {"PRIMARY_SERVICE", "SECONDARY_SERVICE"}
+# the attributes `compile_gatt.py` adds after a characteristic's value, by property
+IMPLICIT_DESCRIPTORS = {
+    "NOTIFY": "CLIENT_CONFIGURATION",
+    "INDICATE": "CLIENT_CONFIGURATION",
+    "BROADCAST": "SERVER_CONFIGURATION",
+}
+
+
+# case label macro (see `gatt/handler_helpers.hpp`) -> attribute kind, `None` -> kind is its 2nd argument
+CASE_MACROS: Dict[str, Optional[str]] = {
+    "USER_DESCRIBE": "USER_DESCRIPTION",
+    "ESM_DESCRIBE": "ENVIRONMENTAL_SENSING_MEASUREMENT",
+    "READ_CLIENT_CFG": "CLIENT_CONFIGURATION",
+    "WRITE_CLIENT_CFG": "CLIENT_CONFIGURATION",
+    "SERVER_CFG_ALWAYS_BROADCAST": "SERVER_CONFIGURATION",
+    "READ_VALUE": "VALUE",
+    "WRITE_VALUE": "VALUE",
+    "HANDLE_READ_BLOB": None,
+    "HANDLE_WRITE_EXPR": None,
+}
+RE_CASE = re.compile(
+    r"\b(?:(?P<macro>" + "|".join(CASE_MACROS) + r")|case\s+(?P<case>HANDLE_ATTR))\s*\("
+)
+RE_ALIAS = re.compile(r"^\s*#\s*define\s+(\w+)\s+(\w+)\s*$", re.MULTILINE)
+RE_COMMENT = re.compile(r"//[^\n]*|/\*.*?\*/", re.DOTALL)
+
+
+def c_name(uuid: str) -> str:
+    return uuid.replace("-", "_")
+
+
+def flags_of(field: str) -> List[str]:
+    return [x.strip() for x in field.split("|")]
+
+
+def parse(path: Path) -> List[Tuple[str, str]]:
+    routes: List[Tuple[str, str]] = []
+    instances: Dict[str, int] = defaultdict(int)
+    service: Optional[str] = None
+    # `<uuid>_<instance>` of the current characteristic
+    characteristic: Optional[str] = None
+
+    def route(kind: str, line_no: int):
+        assert characteristic is not None
+        handler = SERVICE_HANDLERS.get(service or "")
+        if handler is None:
+            raise SystemExit(
+                f"{path}:{line_no}: no handler for service `{service}`, add it to `{__file__}`"
+            )
+        routes.append((handler, f"ATT_CHARACTERISTIC_{characteristic}_{kind}_HANDLE"))
+
+    for line_no, line in enumerate(path.read_text().splitlines(), 1):
+        line = line.strip()
+        if not line or line.startswith("//") or line.startswith("#"):
+            continue
+
+        parts = [x.strip() for x in next(csv.reader([line], skipinitialspace=True))]
+        kind = parts[0]
+        if kind in SERVICE_KINDS:
+            service = parts[1]
+            characteristic = None
+        elif kind == "CHARACTERISTIC":
+            uuid = parts[1]
+            instances[uuid] += 1
+            characteristic = f"{c_name(uuid)}_{instances[uuid]:02d}"
+
+            flags = flags_of(parts[2])
+            if "DYNAMIC" not in flags:
+                continue
+
+            route("VALUE", line_no)
+            for descriptor in sorted(
+                {v for k, v in IMPLICIT_DESCRIPTORS.items() if k in flags}
+            ):
+                route(descriptor, line_no)
+        elif (
+            characteristic is not None
+            and 2 <= len(parts)
+            and "DYNAMIC" in flags_of(parts[1])
+        ):
+            # e.g. `CHARACTERISTIC_USER_DESCRIPTION` -> `..._USER_DESCRIPTION_HANDLE`
+            route(kind.removeprefix("CHARACTERISTIC_"), line_no)
+
+    return routes
+
+
+# Top level arguments of the call whose `(` is at `text[begin - 1]`. Only splits, no C++ parsing.
+def arguments(text: str, begin: int) -> List[str]:
+    args: List[str] = []
+    depth = 0
+    quote: Optional[str] = None
+    start = begin
+    i = begin
+    while i < len(text):
+        c = text[i]
+        if quote:
+            if c == "\\":
+                i += 1
+            elif c == quote:
+                quote = None
+        elif c in "\"'":
+            quote = c
+        elif c in "([{":
+            depth += 1
+        elif c in ")]}" and depth:
+            depth -= 1
+        elif c in ",)" and not depth:
+            args.append(text[start:i].strip())
+            if c == ")":
+                return args
+            start = i + 1
+        i += 1
+
+    raise SystemExit(f"unterminated call at offset {begin}")
+
+
+# Attribute handles a handler's case labels answer, e.g. `USER_DESCRIBE(FAN_POWER, ...)` w/ `#define
+# FAN_POWER 2B04_01` -> `ATT_CHARACTERISTIC_2B04_01_USER_DESCRIPTION_HANDLE`.
+def answered(path: Path) -> List[str]:
+    text = RE_COMMENT.sub("", path.read_text())
+    aliases = dict(RE_ALIAS.findall(text))
+
+    def resolve(attr: str) -> str:
+        if m := re.fullmatch(r"BT\(\s*(\w+)\s*\)", attr):
+            attr = f"ORG_BLUETOOTH_CHARACTERISTIC_{m[1]}"
+        while attr in aliases:
+            attr = aliases[attr]
+        return attr
+
+    handles: List[str] = []
+    for m in RE_CASE.finditer(text):
+        args = arguments(text, m.end())
+        kind = CASE_MACROS[m["macro"]] if m["macro"] else None
+        if kind is None:
+            if len(args) < 2:
+                raise SystemExit(f"{path}: can't parse `{m[0]}{', '.join(args)})`")
+            kind = args[1]
+        handles.append(f"ATT_CHARACTERISTIC_{resolve(args[0])}_{kind}_HANDLE")
+
+    return handles
+
+
+def check_handlers(routes: List[Tuple[str, str]], handlers: Path):
+    errors: List[str] = []
+    for handler in sorted(set(SERVICE_HANDLERS.values())):
+        path = handlers / f"{handler}.cpp"
+        routed = {handle for owner, handle in routes if owner == handler}
+        labels = set(answered(path))
+        for handle in sorted(routed - labels):
+            errors.append(
+                f"{path}: `{handle}` is routed to `{handler}`, but it has no case for it"
+            )
+        for handle in sorted(labels - routed):
+            errors.append(
+                f"{path}: `{handler}` has a case for `{handle}`, but it isn't routed there"
+            )
+
+    if errors:
+        raise SystemExit("\n".join(errors))
+
+
+def emit(routes: List[Tuple[str, str]]) -> str:
+    lines = [
+        "// Generated by `cmake/gatt_dispatch.py`. DO NOT EDIT.",
+        "#pragma once",
+        "",
+        "// X(handler, attribute handle) for every `DYNAMIC` attribute, in profile order",
+        "#define NEVERMORE_GATT_DISPATCH(X) \\",
+    ]
+    lines += [f"    X({handler}, {handle}) \\" for handler, handle in routes]
+    lines += ["    /* end */", ""]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        "profile", type=Path, help="`.gatt` profile, after configuration"
+    )
+    parser.add_argument("output", type=Path, help="header to write")
+    parser.add_argument(
+        "--handlers",
+        type=Path,
+        help="`gatt/` source dir, check each handler answers exactly its routes",
+    )
+    args = parser.parse_args()
+
+    routes = parse(args.profile)
+    if args.handlers:
+        check_handlers(routes, args.handlers)
+
+    content = emit(routes)
+    # don't touch the output if nothing changed, saves rebuilding everything that includes it
+    if args.output.exists() and args.output.read_text() == content:
+        return
+
+    args.output.parent.mkdir(parents=True, exist_ok=True)
+    args.output.write_text(content)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
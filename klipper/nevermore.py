@@ -260,6 +260,26 @@ class CmdFanPowerCoeff(CmdFanPowerAbstract):
     percent: float
 
 
+@dataclass(frozen=True)
+class CmdFanControlMode(Command):
+    value: int
+
+    def params(self):
+        return self.value.to_bytes(1, "little")
+
+
+@dataclass(frozen=True)
+class CmdFanRPMCharacterise(Command):
+    def params(self):
+        return b""
+
+
+@dataclass(frozen=True)
+class CmdFilterLifeReset(Command):
+    def params(self):
+        return b""
+
+
 @dataclass(frozen=True)
 class CmdFanPolicyCooldown(Command):
     value: int  # seconds
@@ -366,6 +386,7 @@ class CmdConfiguration(PseudoCommand):
 
         cfg_flag("sensors_fallback", 0)
         cfg_flag("sensors_fallback_exhaust_mcu", 1)
+        cfg_flag("advertise_telemetry", 2)
 
 
 @dataclass(frozen=True)
@@ -510,6 +531,7 @@ class NevermoreBackgroundWorker:
 
         self._thread.name = nevermore.name
         device_address = nevermore.bt_address
+        serial_path = nevermore.serial
         connection_initial_timeout = nevermore.connection_initial_timeout
         nevermore = None  # release reference otherwise call frame keeps it alive
 
@@ -526,7 +548,7 @@ class NevermoreBackgroundWorker:
             #       do this with `GCode::response_info`, but I don't
             #       know if there are rules/invariants about this.
             #       (e.g. only the active GCode/command may write)
-            if isinstance(e, bleak.exc.BleakError) or isinstance(e, EOFError):
+            if isinstance(e, (bleak.exc.BleakError, EOFError, SerialGattError)):
                 worker_log.exception("attempting reconnection...", exc_info=e)
                 return True
 
@@ -628,6 +650,22 @@ class NevermoreBackgroundWorker:
             except CantInferWhichNevermoreToUse:
                 pass  # quietly fail and move on
 
+        async def handle_serial(path: str) -> None:
+            while True:
+                try:
+                    async with SerialGattClient(path, log=worker_log) as client:
+                        return await self._worker_using(worker_log, client)
+                except SerialGattLost as e:
+                    # don't be (too) noisy about it, it happens (e.g. controller rebooting)
+                    worker_log.debug("connection lost.", exc_info=e)
+                    worker_log.info("connection lost. attempting reconnection...")
+                except Exception as e:
+                    if not exc_filter(e):
+                        raise
+
+                if not await retry():
+                    return
+
         async def go():
             # set this up ASAP once we're in an asyncio loop
             self._command_queue = janus.Queue()
@@ -635,7 +673,11 @@ class NevermoreBackgroundWorker:
             self._disconnect = UNSAFE_LazyAsyncioEvent()
             self._led_dirty = UNSAFE_LazyAsyncioEvent()
 
-            main = asyncio.create_task(handle_connection(device_address))
+            main = asyncio.create_task(
+                handle_serial(serial_path)
+                if serial_path is not None
+                else handle_connection(device_address)
+            )
 
             async def canceller():
                 await self._disconnect.wait()
@@ -652,7 +694,9 @@ class NevermoreBackgroundWorker:
             worker_log.exception("worker failed")
 
     async def _worker_using(
-        self, log: Union[logging.Logger, LoggerAdapter], client: BleakClient
+        self,
+        log: Union[logging.Logger, LoggerAdapter],
+        client: Union[BleakClient, SerialGattClient],
     ):
         log.info(f"connected to controller {client.address}")
 
@@ -663,15 +707,14 @@ class NevermoreBackgroundWorker:
             return x
 
         service_config = require(UUID_SERVICE_CONFIGURATION)
-        service_env = require(UUID_SERVICE_ENVIRONMENTAL_SENSING)
         service_fan = require(UUID_SERVICE_FAN)
         service_fan_policy = require(UUID_SERVICE_FAN_POLICY)
         service_ws2812 = require(UUID_SERVICE_WS2812)
         service_display = require(UUID_SERVICE_DISPLAY)
+        service_status = require(UUID_SERVICE_STATUS)
 
         P = CharacteristicProperty
-        aggregate_env = require_char(service_env, UUID_CHAR_DATA_AGGREGATE, {P.NOTIFY})
-        aggregate_fan = require_char(service_fan, UUID_CHAR_FAN_AGGREGATE, {P.NOTIFY})
+        bulk_state = require_char(service_status, UUID_CHAR_STATUS_BULK, {P.READ, P.NOTIFY})
         # HACK: it's the first one in the list (ordered by handle #). this is brittle.
         (
             fan_power_override,
@@ -683,6 +726,11 @@ class NevermoreBackgroundWorker:
         ws2812_update = require_char(
             service_ws2812, UUID_CHAR_WS2812_UPDATE, {P.WRITE_NO_RESPONSE}
         )
+        fan_control_mode = require_char(
+            service_fan, UUID_CHAR_FAN_CONTROL_MODE, {P.WRITE}
+        )
+        fan_rpm_curve = require_char(service_fan, UUID_CHAR_FAN_RPM_CURVE, {P.WRITE})
+        filter_life = require_char(service_fan, UUID_CHAR_FILTER_LIFE, {P.WRITE})
         fan_policy_cooldown = require_char(
             service_fan_policy, UUID_CHAR_TIMESEC16, {P.WRITE}
         )
@@ -741,18 +789,17 @@ class NevermoreBackgroundWorker:
 
             await client.start_notify(char, go)
 
-        def notify_env(nevermore: "Nevermore", params: BleAttrReader):
-            (intake, exhaust) = SensorState.parse(params)
+        def notify_bulk_state(nevermore: "Nevermore", params: BleAttrReader):
+            state = BulkState.parse(params)
             # HACK: Abuse GIL to keep this thread-safe
-            nevermore.state.intake = intake
-            nevermore.state.exhaust = exhaust
-            nevermore.state_stats_update()
-
-        def notify_fan(nevermore: "Nevermore", params: BleAttrReader):
-            # HACK: Abuse GIL to keep this thread-safe
-            # show the current fan power even if it isn't overridden
-            nevermore.state.fan_power = (params.percentage8() or 0) / 100.0
-            nevermore.state.fan_tacho = params.tachometer()
+            if state.intake is not None:
+                nevermore.state.intake = state.intake
+            if state.exhaust is not None:
+                nevermore.state.exhaust = state.exhaust
+            if state.fan is not None:
+                # show the current fan power even if it isn't overridden
+                nevermore.state.fan_power = state.fan.speed or 0
+                nevermore.state.fan_tacho = state.fan.rpm or 0
             nevermore.state_stats_update()
 
         async def handle_commands():
@@ -765,6 +812,12 @@ class NevermoreBackgroundWorker:
                 char = fan_power_auto
             elif isinstance(cmd, CmdFanPowerCoeff):
                 char = fan_power_coeff
+            elif isinstance(cmd, CmdFanControlMode):
+                char = fan_control_mode
+            elif isinstance(cmd, CmdFanRPMCharacterise):
+                char = fan_rpm_curve
+            elif isinstance(cmd, CmdFilterLifeReset):
+                char = filter_life
             elif isinstance(cmd, CmdFanPolicyCooldown):
                 char = fan_policy_cooldown
             elif isinstance(cmd, CmdFanPolicyVocPassiveMax):
@@ -800,7 +853,7 @@ class NevermoreBackgroundWorker:
 
             try:
                 await client.write_gatt_char(char, cmd.params())
-            except bleak.exc.BleakError as e:
+            except (bleak.exc.BleakError, SerialGattError) as e:
                 # special case: lost connection -> wait and attempt reconnect
                 if is_lost_connection_exception(e):
                     raise
@@ -835,8 +888,14 @@ class NevermoreBackgroundWorker:
         )
 
         try:
-            await notify(aggregate_env, notify_env)
-            await notify(aggregate_fan, notify_fan)
+            # one round trip for the full state instead of waiting for the first notify
+            params = BleAttrReader(await client.read_gatt_char(bulk_state))
+            nevermore = self._nevermore()
+            if nevermore is not None:
+                notify_bulk_state(nevermore, params)
+            nevermore = None  # release local ref
+
+            await notify(bulk_state, notify_bulk_state)
             await tasks
         finally:
             tasks.cancel()  # kill off all active tasks if any fail
@@ -870,6 +929,10 @@ class Nevermore:
     )
     cmd_NEVERMORE_SENSOR_CALIBRATION_RESET_help = "Reset sensor calibration"
     cmd_NEVERMORE_RESET_help = "Reset settings. Do not use unless directed."
+    cmd_NEVERMORE_FAN_RPM_CHARACTERISE_help = (
+        "Re-measure the fan's duty to RPM curve (takes ~45 seconds)"
+    )
+    cmd_NEVERMORE_FILTER_REPLACED_help = "Reset the filter life estimate"
 
     def __init__(self, config: ConfigWrapper) -> None:
         self.name = config.get_name().split()[-1]
@@ -881,6 +944,9 @@ class Nevermore:
         self.fan = NevermoreFan(self)
 
         self.bt_address: Optional[str] = config.get("bt_address", None)
+        # wired (USB CDC) transport, e.g. `/dev/serial/by-id/usb-Raspberry_Pi_Pico_Nevermore_...`
+        # takes precedence over bluetooth
+        self.serial: Optional[str] = config.get("serial", None)
         if self.bt_address is not None:
             self.bt_address = self.bt_address.upper()
             if not bt_address_validate(self.bt_address):
@@ -907,9 +973,13 @@ class Nevermore:
             raise config.error(
                 f"`connection_initial_timeout` must either be 0 or >= {connection_initial_min}."
             )
-        if self.connection_initial_timeout == 0 and self.bt_address is None:
+        if (
+            self.connection_initial_timeout == 0
+            and self.bt_address is None
+            and self.serial is None
+        ):
             raise config.error(
-                f"`connection_initial_timeout` cannot be 0 if `bt_address` is not specified."
+                f"`connection_initial_timeout` cannot be 0 if neither `bt_address` nor `serial` are specified."
             )
 
         # LED-specific code.
@@ -977,6 +1047,16 @@ class Nevermore:
                 "`fan_thermal_limit_temperature_min` must <= `fan_thermal_limit_temperature_max`"
             )
 
+        try:
+            self._fan_control_mode = opt(
+                lambda x: CmdFanControlMode(FanControlMode[x.upper()].value),
+                config.get("fan_control_mode", default=None),
+            )
+        except KeyError:
+            raise config.error(
+                f"`fan_control_mode` isn't one of: {', '.join(x.name for x in FanControlMode)}"
+            )
+
         self._display_brightness = opt(
             CmdDisplayBrightness,
             config.getfloat("display_brightness", default=None, minval=0, maxval=1),
@@ -1052,6 +1132,20 @@ class Nevermore:
             self.cmd_NEVERMORE_SENSOR_CALIBRATION_RESET,
             desc=self.cmd_NEVERMORE_SENSOR_CALIBRATION_RESET_help,
         )
+        gcode.register_mux_command(
+            "NEVERMORE_FAN_RPM_CHARACTERISE",
+            "NEVERMORE",
+            self.name,
+            self.cmd_NEVERMORE_FAN_RPM_CHARACTERISE,
+            desc=self.cmd_NEVERMORE_FAN_RPM_CHARACTERISE_help,
+        )
+        gcode.register_mux_command(
+            "NEVERMORE_FILTER_REPLACED",
+            "NEVERMORE",
+            self.name,
+            self.cmd_NEVERMORE_FILTER_REPLACED,
+            desc=self.cmd_NEVERMORE_FILTER_REPLACED_help,
+        )
 
     def set_fan_power(self, percent: Optional[float]):
         if self._interface is not None:
@@ -1098,6 +1192,7 @@ class Nevermore:
         self._interface.send_command(self._fan_power_auto)
         self._interface.send_command(self._fan_power_coeff)
         self._interface.send_command(self._fan_thermal_limit)
+        self._interface.send_command(self._fan_control_mode)
         self._interface.send_command(self._display_brightness)
         self._interface.send_command(self._display_ui)
         self._interface.send_command(CmdWs2812Length(len(self.led_colour_idxs)))
@@ -1168,6 +1263,14 @@ class Nevermore:
         if self._interface is not None:
             self._interface.send_command(CmdConfigResetSensorCalibration())
 
+    def cmd_NEVERMORE_FAN_RPM_CHARACTERISE(self, gcmd: GCodeCommand) -> None:
+        if self._interface is not None:
+            self._interface.send_command(CmdFanRPMCharacterise())
+
+    def cmd_NEVERMORE_FILTER_REPLACED(self, gcmd: GCodeCommand) -> None:
+        if self._interface is not None:
+            self._interface.send_command(CmdFilterLifeReset())
+
 
 # basically ripped from `extras/fan_generic.py`
 class NevermoreFan:
@@ -7,6 +7,7 @@
 
 // BTstack features that can be enabled
 #define ENABLE_LE_PERIPHERAL
+#define ENABLE_LE_DATA_LENGTH_EXTENSION
 #define ENABLE_PRINTF_HEXDUMP
 #define ENABLE_LOG_ERROR
 
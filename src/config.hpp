@@ -17,6 +17,11 @@ constexpr auto SENSOR_UPDATE_PERIOD = 1s;
 static_assert(0.5s <= SENSOR_UPDATE_PERIOD,
         "SENSOR_UPDATE_PERIOD too low, SGP40 needs at least 0.5s between measures.");
 
+// Temperature/humidity/pressure sensors back off towards this while their readings are stable.
+// VOC sensors always use `SENSOR_UPDATE_PERIOD`, their algorithms are calibrated for it.
+constexpr auto SENSOR_UPDATE_PERIOD_STABLE_MAX = 10s;
+static_assert(SENSOR_UPDATE_PERIOD <= SENSOR_UPDATE_PERIOD_STABLE_MAX);
+
 constexpr auto ADVERTISE_INTERVAL_MIN = 300ms;
 constexpr auto ADVERTISE_INTERVAL_MAX = 500ms;
 
@@ -49,10 +49,14 @@
 //      (We have some locks around things like I2C comms where we don't want
 //       both cores banging on the same bus.)
 #define configUSE_PREEMPTION 0
-#define configUSE_TICKLESS_IDLE 0
+// Tickless idle w/ our own sleep, woken by a RP2040 timer alarm. See `sdk/tickless.cpp`.
+// (2 -> don't build the port's SysTick based one)
+#define configUSE_TICKLESS_IDLE 2
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP 2
 #define configUSE_IDLE_HOOK 0
 #define configUSE_TICK_HOOK 1
-#define configTICK_RATE_HZ ((TickType_t)20000)
+// Sub-tick waits use HW alarms (see `task_delay`), no need for a fast tick.
+#define configTICK_RATE_HZ ((TickType_t)1000)
 #define configMAX_PRIORITIES 32
 #define configMINIMAL_STACK_SIZE (configSTACK_DEPTH_TYPE)256
 #define configUSE_16_BIT_TICKS 0
@@ -70,13 +74,20 @@
 #define configUSE_NEWLIB_REENTRANT 0
 #define configENABLE_BACKWARD_COMPATIBILITY 0
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
+// [0] general use (e.g. driver IRQs), [1] reserved for `task_delay_alarm`
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2
 
 /* System */
 #define configSTACK_DEPTH_TYPE uint32_t
 #define configMESSAGE_BUFFER_LENGTH_TYPE size_t
 
 /* Memory allocation related definitions. */
-#define configSUPPORT_STATIC_ALLOCATION 0
+// `NEVERMORE_STATIC_ALLOCATION`: our own tasks, timers, semaphores & sensor drivers use static storage.
+// Dynamic allocation is still required by the SDK, BTstack, etc.
+#ifndef NEVERMORE_STATIC_ALLOCATION
+#define NEVERMORE_STATIC_ALLOCATION 0
+#endif
+#define configSUPPORT_STATIC_ALLOCATION NEVERMORE_STATIC_ALLOCATION
 #define configSUPPORT_DYNAMIC_ALLOCATION 1
 #define configTOTAL_HEAP_SIZE (64 * 1024)
 #define configAPPLICATION_ALLOCATED_HEAP 0
@@ -118,6 +129,20 @@
 #define configSUPPORT_PICO_SYNC_INTEROP 1
 #define configSUPPORT_PICO_TIME_INTEROP 1
 
+/* Tickless idle, see `sdk/tickless.cpp` */
+#if !defined(__ASSEMBLER__)
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+void nevermore_suppress_ticks_and_sleep(uint32_t expected_idle_ticks);
+#ifdef __cplusplus
+}
+#endif
+#define portSUPPRESS_TICKS_AND_SLEEP(expected_idle_ticks) \
+    nevermore_suppress_ticks_and_sleep(expected_idle_ticks)
+#endif
+
 #include <assert.h>
 /* Define to trap errors during development. */
 #define configASSERT(x) assert(x)
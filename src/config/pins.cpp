@@ -2,6 +2,7 @@
 #include "hardware/gpio.h"
 #include "hardware/i2c.h"
 #include "hardware/spi.h"
+#include "sdk/i2c_pio.hpp"
 #include "utility/square_wave.hpp"
 #include <cassert>
 #include <cstdint>
@@ -36,22 +37,26 @@ void bind_bus(auto const& xs, auto&& using_hw, auto&& using_pio) {
     }
 }
 
+char const* i2c_kind_name(Pins::BusI2C::Kind kind) {
+    switch (kind) {
+    case Pins::BusI2C::Kind::generic: return "generic";
+    case Pins::BusI2C::Kind::intake: return "intake";
+    case Pins::BusI2C::Kind::exhaust: return "exhaust";
+    case Pins::BusI2C::Kind::chamber: return "chamber";
+    case Pins::BusI2C::Kind::auxiliary: return "auxiliary";
+    }
+    return "";
+}
+
 void bind_i2c_hw(Pins::BusI2C const& bus, uint8_t const hw) {
     gpio_set_function(bus.clock, GPIO_FUNC_I2C);
     gpio_set_function(bus.data, GPIO_FUNC_I2C);
     gpio_pull_up(bus.clock);
     gpio_pull_up(bus.data);
 
-    char const* kind = "";
-    switch (bus.kind) {
-    case Pins::BusI2C::Kind::generic: kind = "generic"; break;
-    case Pins::BusI2C::Kind::intake: kind = "intake"; break;
-    case Pins::BusI2C::Kind::exhaust: kind = "exhaust"; break;
-    }
-
     assert(hw <= 1);
     auto* i2c_inst = hw == 0 ? i2c0 : i2c1;
-    printf("I2C%u (%s) running at %u baud/s (requested %u baud/s)\n", hw, kind,
+    printf("I2C%u (%s) running at %u baud/s (requested %u baud/s)\n", hw, i2c_kind_name(bus.kind),
             i2c_init(i2c_inst, bus.baud_rate), unsigned(bus.baud_rate));
 }
 
@@ -73,8 +78,10 @@ void bind_spi_hw(Pins::BusSPI const& bus, uint8_t const hw) {
             unsigned(bus.baud_rate));
 }
 
-void bind_i2c_pio(Pins::BusI2C const&) {
-    assert(false && "PIO I2C not implemented");
+void bind_i2c_pio(Pins::BusI2C const& bus) {
+    // pins are bound & pulled up by `i2c_program_init`, which also logs the achieved baud rate
+    printf("PIO I2C %u/%u (%s)\n", unsigned(bus.data), unsigned(bus.clock), i2c_kind_name(bus.kind));
+    i2c_pio_add(bus.baud_rate, bus.data, bus.clock);
 }
 
 void bind_spi_pio(Pins::BusSPI const&) {
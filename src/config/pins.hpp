@@ -97,14 +97,17 @@ struct [[gnu::packed]] Pins {
 
     using GPIOs = GPIO[ALTERNATIVES_MAX];
 
-    // reserve for future expansion where you can use PIO-driven pins
+    // Buses that can't claim a free HW controller are run on PIO (see `sdk/i2c_pio.hpp`).
     struct [[gnu::packed]] BusI2C {
+        // one PIO block's worth of state machines
+        static constexpr size_t PIO_MAX = 4;
         // generic buses can run faster, but we don't verify that it'll support all sensors.
         static constexpr uint32_t BAUD_RATE_MAX = 1'000'000;
         static constexpr uint32_t BAUD_RATE_GENERIC_MAX = BAUD_RATE_MAX;
         static constexpr uint32_t BAUD_RATE_SENSOR_MAX = I2C_BAUD_RATE_SENSOR_MAX;
 
-        enum class Kind : uint8_t { generic = 0, intake = 1, exhaust = 2 };
+        // `chamber` & `auxiliary` feed the extra environmental zones, see `sensors::Zone`
+        enum class Kind : uint8_t { generic = 0, intake = 1, exhaust = 2, chamber = 3, auxiliary = 4 };
 
         Kind kind = Kind::generic;
         GPIO clock;
@@ -261,16 +264,16 @@ private:
         if (bus.baud_rate <= 0) throw "Config uses an I2C bus with a baud-rate <= 0.";
         if (BusI2C::BAUD_RATE_MAX < bus.baud_rate)
             throw "Config uses an SPI bus with a baud rate exceeding system max.";
-        // currently HW bus is required. future work to support PIO buses
-        if (!bus.hardware_bus_num()) throw "Config uses an I2C bus with GPIOs that cannot map to a HW bus.";
 
         switch (bus.kind) {
         case BusI2C::Kind::generic: {
             if (BusI2C::BAUD_RATE_GENERIC_MAX < bus.baud_rate)
                 throw "Config uses an generic I2C bus with a baud rate exceeding generic max.";
         } break;
-        case BusI2C::Kind::intake:  // FALL THRU: exhaust
-        case BusI2C::Kind::exhaust: {
+        case BusI2C::Kind::intake:   // FALL THRU
+        case BusI2C::Kind::exhaust:  // FALL THRU
+        case BusI2C::Kind::chamber:  // FALL THRU
+        case BusI2C::Kind::auxiliary: {
             if (BusI2C::BAUD_RATE_SENSOR_MAX < bus.baud_rate)
                 throw "Config uses an I2C bus with a baud rate exceeding sensor max.";
         } break;
@@ -314,17 +317,22 @@ inline constexpr void nevermore::Pins::validate_or_throw() const {
     if (!pins_forall([](auto p) { return p.validate(); })) throw "Config uses an invalid GPIO (>= 30).";
     if (!pins_distinct()) throw "Config uses a GPIO more than once.";
 
+    // NB: Same assignment as `bind_bus`: HW if the controller is free, otherwise PIO.
     uint32_t i2c_hw_bus = 0;
+    size_t i2c_pio_buses = 0;
     for (auto&& bus : i2c) {
         validate_or_throw(bus);
         if (!bus) continue;
 
-        auto bus_num = bus.hardware_bus_num();
-        if (!bus_num) throw "Config uses an I2C bus that cannot be mapped to a hardware bus.";
-        if (i2c_hw_bus & (1u << *bus_num))
-            throw "Config uses multiple I2C buses mapped to the same hardware bus.";
+        if (auto bus_num = bus.hardware_bus_num(); bus_num && !(i2c_hw_bus & (1u << *bus_num))) {
+            i2c_hw_bus |= 1u << *bus_num;
+            continue;
+        }
 
-        i2c_hw_bus |= 1u << *bus_num;
+        // PIO program uses `in pins` & `jmp pin` w/ SCL as the side-set pin following SDA
+        if (uint8_t(bus.clock) != uint8_t(bus.data) + 1)
+            throw "Config uses a PIO I2C bus whose clock GPIO isn't data GPIO + 1.";
+        if (BusI2C::PIO_MAX <= i2c_pio_buses++) throw "Config uses more I2C buses than can be run on PIO.";
     }
 
     uint32_t spi_hw_bus = 0;
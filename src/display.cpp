@@ -13,20 +13,93 @@
 #include <cassert>
 #include <cstdint>
 #include <cstdio>
+#include <iterator>
 
 using namespace std;
 using namespace nevermore;
 
+#ifndef NEVERMORE_DISPLAY_DRAW_ARENA_LINES
+#define NEVERMORE_DISPLAY_DRAW_ARENA_LINES 240
+#endif
+
 namespace nevermore::display {
 
 namespace {
 
 constexpr auto DISPLAY_BACKLIGHT_FREQ = 1'000;
 
-lv_color_t g_draw_scratch_buffers[2][RESOLUTION.width * RESOLUTION.height / 2];
+// Backing store for whichever `DisplayBuffering` is selected.
+// Shrink it w/ `-DNEVERMORE_DISPLAY_DRAW_ARENA_LINES=N` to reclaim RAM.
+constexpr uint16_t DRAW_ARENA_LINES = NEVERMORE_DISPLAY_DRAW_ARENA_LINES;
+static_assert(RESOLUTION.height / 10 <= DRAW_ARENA_LINES && DRAW_ARENA_LINES <= RESOLUTION.height,
+        "draw arena must fit at least the smallest strategy, and there's no point exceeding a full frame");
+
+struct Buffering {
+    uint16_t lines;  // per buffer
+    uint8_t buffers;
+    bool direct = false;
+
+    [[nodiscard]] constexpr bool fits() const {
+        return lines * buffers <= DRAW_ARENA_LINES;
+    }
+};
+
+constexpr Buffering buffering(settings::DisplayBuffering x) {
+    using enum settings::DisplayBuffering;
+    switch (x) {
+    default:  // FALL THRU
+    case DOUBLE_HALF: return {.lines = RESOLUTION.height / 2, .buffers = 2};
+    case DOUBLE_TENTH: return {.lines = RESOLUTION.height / 10, .buffers = 2};
+    case SINGLE_TENTH: return {.lines = RESOLUTION.height / 10, .buffers = 1};
+    case DIRECT_FULL: return {.lines = RESOLUTION.height, .buffers = 1, .direct = true};
+    }
+}
+
+// Best first, used to pick a fallback when the requested strategy doesn't fit the arena.
+constexpr settings::DisplayBuffering BUFFERING_PREFERENCE[] = {
+        settings::DisplayBuffering::DOUBLE_HALF,
+        settings::DisplayBuffering::DOUBLE_TENTH,
+        settings::DisplayBuffering::SINGLE_TENTH,
+};
+static_assert(buffering(end(BUFFERING_PREFERENCE)[-1]).fits());
+
+lv_color_t g_draw_arena[RESOLUTION.width * DRAW_ARENA_LINES];
 lv_disp_draw_buf_t g_draw_buffer;
 lv_disp_drv_t g_driver;
 lv_disp_t* g_display;
+settings::DisplayBuffering g_buffering;
+void (*g_flush_panel)(lv_disp_drv_t*, lv_area_t const*, lv_color_t*);
+
+// Only touched from the LVGL task.
+Stats g_stats;
+
+void flush(lv_disp_drv_t* driver, lv_area_t const* area, lv_color_t* colour) {
+    // In direct mode the buffer always holds the whole frame and `area` is always the whole screen.
+    // Only push it once per refresh instead of once per dirty area.
+    if (driver->direct_mode && !lv_disp_flush_is_last(driver)) {
+        lv_disp_flush_ready(driver);
+        return;
+    }
+
+    g_stats.flushes++;
+    g_flush_panel(driver, area, colour);
+}
+
+void monitor(lv_disp_drv_t*, uint32_t time_ms, uint32_t pixels) {
+    g_stats.frames++;
+    g_stats.render_ms += time_ms;
+    g_stats.pixels += pixels;
+}
+
+settings::DisplayBuffering buffering_select(settings::DisplayBuffering requested) {
+    if (buffering(requested).fits()) return requested;
+
+    auto fallback = *ranges::find_if(BUFFERING_PREFERENCE, [](auto x) { return buffering(x).fits(); });
+    printf("WARN - display - buffering %u needs %u lines, arena only has %u. falling back to %u\n",
+            unsigned(requested), unsigned(buffering(requested).lines * buffering(requested).buffers),
+            unsigned(DRAW_ARENA_LINES), unsigned(fallback));
+    return fallback;
+}
 
 }  // namespace
 
@@ -53,8 +126,11 @@ bool init_with_ui() {
     brightness(settings::g_active.display_brightness);
 
     lv_init();
-    lv_disp_draw_buf_init(&g_draw_buffer, g_draw_scratch_buffers[0], g_draw_scratch_buffers[1],
-            size(g_draw_scratch_buffers[0]));
+    g_buffering = buffering_select(settings::g_active.display_buffering);
+    auto const layout = buffering(g_buffering);
+    auto const buffer_size = uint32_t(RESOLUTION.width * layout.lines);
+    lv_disp_draw_buf_init(&g_draw_buffer, g_draw_arena,
+            layout.buffers == 2 ? g_draw_arena + buffer_size : nullptr, buffer_size);
 
     switch (settings::g_active.display_hw) {
     case settings::DisplayHW::GC9A01_240_240: {
@@ -65,6 +141,10 @@ bool init_with_ui() {
         g_driver.hor_res = RESOLUTION.width;
         g_driver.ver_res = RESOLUTION.height;
         g_driver.draw_buf = &g_draw_buffer;
+        g_driver.direct_mode = layout.direct;
+        g_flush_panel = g_driver.flush_cb;
+        g_driver.flush_cb = flush;
+        g_driver.monitor_cb = monitor;
     } break;
 
     default: {
@@ -81,6 +161,18 @@ bool init_with_ui() {
     return ui::init();
 }
 
+settings::DisplayBuffering buffering() {
+    return g_buffering;
+}
+
+uint32_t draw_arena_size() {
+    return sizeof(g_draw_arena);
+}
+
+Stats stats() {
+    return g_stats;
+}
+
 spi_inst_t* active_spi() {
     for (auto&& bus : Pins::active().spi) {
         if (!bus || bus.kind != Pins::BusSPI::Kind::display) continue;
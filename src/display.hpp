@@ -1,6 +1,7 @@
 #pragma once
 
 #include "hardware/spi.h"
+#include "settings.hpp"
 #include <cstdint>
 
 namespace nevermore::display {
@@ -21,6 +22,19 @@ constexpr Resolution RESOLUTION{
         .height = 240,
 };
 
+// Counters since boot, for comparing `DisplayBuffering` strategies.
+struct Stats {
+    uint32_t frames = 0;     // refreshes that redrew something
+    uint32_t flushes = 0;    // partial/full frames pushed to the panel
+    uint32_t render_ms = 0;  // total time spent refreshing, including waiting on flushes
+    uint32_t pixels = 0;     // total pixels redrawn
+};
+
+// The strategy actually in use, might differ from the setting if it didn't fit.
+settings::DisplayBuffering buffering();
+uint32_t draw_arena_size();  // bytes
+Stats stats();
+
 // HACK: internal API, do not use
 spi_inst_t* active_spi();
 
@@ -4,44 +4,103 @@
 #include "bluetooth_gatt.h"
 #include "btstack_event.h"
 #include "config.hpp"
+#include "gatt/advertise.hpp"
 #include "gatt/configuration.hpp"
+#include "gatt/connection.hpp"
+#include "gatt/dispatch.hpp"
 #include "gatt/display.hpp"
 #include "gatt/environmental.hpp"
 #include "gatt/fan.hpp"
 #include "gatt/handler_helpers.hpp"
 #include "gatt/photocatalytic.hpp"
+#include "gatt/serial.hpp"
+#include "gatt/status.hpp"
 #include "gatt/ws2812.hpp"
 #include "hci_dump.h"
 #include "l2cap.h"
 #include "nevermore.h"
-#include "sdk/gap.hpp"
-#include "utility/bt_advert.hpp"
+#include "nevermore_gatt_dispatch.h"
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
-#include <tuple>
+#include <optional>
+#include <span>
 
 using namespace std;
-using namespace bt::advert;
 
 namespace nevermore::gatt {
 
 namespace {
 
-// coincidentally packed b/c all `bt::advert` funcs return only tuples of packed members
-constexpr tuple ADVERT{
-        flags({
-                Flag::LE_DISCOVERABLE,
-                Flag::EDR_NOT_SUPPORTED,
-        }),
-        shortened_local_name("Nevermore"),
-        services<ORG_BLUETOOTH_SERVICE_ENVIRONMENTAL_SENSING>(),
+// Owner of each `DYNAMIC` attribute, generated from `nevermore.gatt` (see `cmake/gatt_dispatch.py`).
+enum class Handler : uint8_t {
+    none,
+    configuration,
+    display,
+    environmental,
+    fan,
+    photocatalytic,
+    status,
+    ws2812,
 };
 
+using ReadHandler = optional<uint16_t> (*)(hci_con_handle_t, uint16_t, uint16_t, uint8_t*, uint16_t);
+using WriteHandler = optional<int> (*)(hci_con_handle_t, uint16_t, uint16_t, uint8_t const*, uint16_t);
+
+// indexed by `Handler`
+constexpr array<ReadHandler, 8> READ_HANDLERS{
+        nullptr,
+        configuration::attr_read,
+        display::attr_read,
+        environmental::attr_read,
+        fan::attr_read,
+        photocatalytic::attr_read,
+        status::attr_read,
+        ws2812::attr_read,
+};
+constexpr array<WriteHandler, READ_HANDLERS.size()> WRITE_HANDLERS{
+        nullptr,
+        configuration::attr_write,
+        display::attr_write,
+        environmental::attr_write,
+        fan::attr_write,
+        photocatalytic::attr_write,
+        status::attr_write,
+        ws2812::attr_write,
+};
+
+constexpr array ROUTES{
+#define GATT_ROUTE(handler, handle) Route<Handler>{handle, Handler::handler},
+        NEVERMORE_GATT_DISPATCH(GATT_ROUTE)
+#undef GATT_ROUTE
+};
+
+static_assert(
+        []() {
+            auto xs = ROUTES;
+            ranges::sort(xs, {}, &Route<Handler>::handle);
+            return ranges::adjacent_find(xs, {}, &Route<Handler>::handle) == xs.end();
+        }(),
+        "attribute handle routed more than once");
+static_assert(ranges::none_of(ROUTES, [](auto&& route) { return route.handler == Handler::none; }));
+static_assert(
+        []() {
+            for (size_t i = 1; i < READ_HANDLERS.size(); ++i)
+                if (!READ_HANDLERS.at(i) || !WRITE_HANDLERS.at(i) ||
+                        ranges::find(ROUTES, Handler(i), &Route<Handler>::handler) == ROUTES.end())
+                    return false;
+            return true;
+        }(),
+        "every handler must have a read & write function and own at least one attribute");
+
 void hci_handler(uint8_t packet_type, [[maybe_unused]] uint16_t channel, uint8_t* packet,
         [[maybe_unused]] uint16_t size) {
     if (packet_type != HCI_EVENT_PACKET) return;
 
+    connection::hci_event(packet);
+
     auto const event_type = hci_event_packet_get_type(packet);
     switch (event_type) {
     case BTSTACK_EVENT_STATE: {
@@ -51,44 +110,39 @@ void hci_handler(uint8_t packet_type, [[maybe_unused]] uint16_t channel, uint8_t
         gap_local_bd_addr(local_addr);
         printf("BLE GATT - ready; address is %s\n", bd_addr_to_str(local_addr));
 
-        // setup advertisements
-        static_assert(sizeof(ADVERT) <= 31, "too large for non-extended advertisement");
-        gap_advertisements_set_params(ADVERTISE_INTERVAL_MIN, ADVERTISE_INTERVAL_MAX);
-        gap_advertisements_set_data(sizeof(ADVERT), (uint8_t*)&ADVERT);  // NOLINT
-        gap_advertisements_enable(1);
+        advertise::start();
     } break;
 
     case ATT_EVENT_CONNECTED: {
         auto const conn = att_event_connected_get_handle(packet);
         printf("BLE GATT - connected conn=%d\n", conn);
+
+        connection::connected(conn);
     } break;
 
     case ATT_EVENT_DISCONNECTED: {
         auto const conn = att_event_disconnected_get_handle(packet);
         printf("BLE GATT - disconnected conn=%d\n", conn);
 
-        configuration::disconnected(conn);
-        display::disconnected(conn);
-        environmental::disconnected(conn);
-        fan::disconnected(conn);
-        photocatalytic::disconnected(conn);
-        ws2812::disconnected(conn);
+        disconnected(conn);
     } break;
     }
 }
 
+btstack_packet_callback_registration_t g_hci_handler{.callback = &hci_handler};
+
+}  // namespace
+
+span<uint8_t const> database() {
+    return profile_data;
+}
+
 uint16_t attr_read(
         hci_con_handle_t conn, uint16_t attr, uint16_t offset, uint8_t* buffer, uint16_t buffer_size) {
-    constexpr array HANDLERS{
-            configuration::attr_read,
-            display::attr_read,
-            environmental::attr_read,
-            fan::attr_read,
-            photocatalytic::attr_read,
-            ws2812::attr_read,
-    };
-    for (auto handler : HANDLERS)
-        if (auto r = handler(conn, attr, offset, buffer, buffer_size)) return *r;
+    if (auto handler = dispatch<ROUTES>(attr); handler != Handler::none) {
+        auto read = READ_HANDLERS.at(size_t(handler));
+        if (auto r = read(conn, attr, offset, buffer, buffer_size)) return *r;
+    }
 
     printf("WARN - BLE GATT - attr_read unhandled attr 0x%04x\n", int(attr));
     return 0;
@@ -109,18 +163,11 @@ int attr_write(hci_con_handle_t conn, uint16_t attr, uint16_t transaction_mode,
         return 0;
     }
 
-    constexpr array HANDLERS{
-            configuration::attr_write,
-            display::attr_write,
-            environmental::attr_write,
-            fan::attr_write,
-            photocatalytic::attr_write,
-            ws2812::attr_write,
-    };
-
     try {
-        for (auto handler : HANDLERS)
-            if (auto r = handler(conn, attr, offset, buffer, buffer_size)) return *r;
+        if (auto handler = dispatch<ROUTES>(attr); handler != Handler::none) {
+            auto write = WRITE_HANDLERS.at(size_t(handler));
+            if (auto r = write(conn, attr, offset, buffer, buffer_size)) return *r;
+        }
     } catch (AttrWriteException const& e) {
         return e.error;
     }
@@ -129,9 +176,16 @@ int attr_write(hci_con_handle_t conn, uint16_t attr, uint16_t transaction_mode,
     return 0;
 }
 
-btstack_packet_callback_registration_t g_hci_handler{.callback = &hci_handler};
-
-}  // namespace
+void disconnected(hci_con_handle_t conn) {
+    configuration::disconnected(conn);
+    connection::disconnected(conn);
+    display::disconnected(conn);
+    environmental::disconnected(conn);
+    fan::disconnected(conn);
+    photocatalytic::disconnected(conn);
+    status::disconnected(conn);
+    ws2812::disconnected(conn);
+}
 
 bool init() {
     if constexpr (NEVERMORE_PICO_W_BT) {
@@ -141,13 +195,17 @@ bool init() {
 
         l2cap_init();
         sm_init();  // FUTURE WORK: do we even need a security manager? can we ditch this?
+        if (!connection::init()) return false;
+        if (!advertise::init()) return false;
     }
 
     if (!display::init()) return false;
     if (!environmental::init()) return false;
     if (!fan::init()) return false;
     if (!photocatalytic::init()) return false;
+    if (!status::init()) return false;
     if (!ws2812::init()) return false;
+    if (!serial::init()) return false;
 
     if constexpr (NEVERMORE_PICO_W_BT) {
         hci_add_event_handler(&g_hci_handler);
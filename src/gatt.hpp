@@ -1,9 +1,24 @@
 #pragma once
 
+#include "bluetooth.h"
+#include <cstdint>
+#include <span>
+
 namespace nevermore::gatt {
 
 // Setup bluetooth and GATT services.
 // Caller is responsible for subsequently calling `btstack_run_loop_execute`.
 bool init();
 
+// BTstack's compiled attribute DB (`profile_data`), for transports that don't go through `att_server`.
+std::span<uint8_t const> database();
+
+// `att_server` read/write callbacks, shared w/ the wired transport (`gatt/serial.hpp`).
+// Only call from the GATT context.
+uint16_t attr_read(hci_con_handle_t, uint16_t attr, uint16_t offset, uint8_t* buffer, uint16_t buffer_size);
+int attr_write(hci_con_handle_t, uint16_t attr, uint16_t transaction_mode, uint16_t offset, uint8_t* buffer,
+        uint16_t buffer_size);
+// Drops all per-connection state (e.g. notification subscriptions). Only call from the GATT context.
+void disconnected(hci_con_handle_t);
+
 }  // namespace nevermore::gatt
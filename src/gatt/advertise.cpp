@@ -0,0 +1,118 @@
+#include "advertise.hpp"
+#include "bluetooth_gatt.h"
+#include "btstack_run_loop.h"
+#include "config.hpp"
+#include "gatt/fan.hpp"
+#include "sdk/gap.hpp"
+#include "sensors.hpp"
+#include "settings.hpp"
+#include "utility/bt_advert.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <tuple>
+
+using namespace std;
+using namespace bt::advert;
+
+namespace nevermore::gatt::advertise {
+
+namespace {
+
+constexpr auto FLAGS = flags({
+        Flag::LE_DISCOVERABLE,
+        Flag::EDR_NOT_SUPPORTED,
+});
+
+// coincidentally packed b/c all `bt::advert` funcs return only tuples of packed members
+constexpr tuple ADVERT{
+        FLAGS,
+        shortened_local_name("Nevermore"),
+        services<ORG_BLUETOOTH_SERVICE_ENVIRONMENTAL_SENSING>(),
+};
+static_assert(sizeof(ADVERT) <= 31, "too large for non-extended advertisement");
+
+// Name doesn't fit alongside the telemetry, active scanners still get it from the scan response.
+constexpr tuple SCAN_RESPONSE{
+        shortened_local_name("Nevermore"),
+};
+static_assert(sizeof(SCAN_RESPONSE) <= 31, "too large for non-extended scan response");
+
+// Telemetry service data format (little endian), same encoding as the dedicated characteristics.
+// NB: This isn't an ESS defined format, hosts must check `version` before trusting anything else.
+//     `version` only changes for incompatible changes, fields may be appended.
+struct [[gnu::packed]] Telemetry {
+    static constexpr uint8_t VERSION = 1;
+
+    uint8_t version = VERSION;
+    sensors::VOCIndex voc_index_intake;
+    sensors::VOCIndex voc_index_exhaust;
+    BLE::Temperature temperature_intake;
+    BLE::Temperature temperature_exhaust;
+    BLE::Percentage8 fan_power;
+    fan::RPM16 fan_rpm;
+};
+
+Telemetry telemetry() {
+    auto sensors = sensors::with_fallbacks().v0();
+    return {
+            .voc_index_intake = sensors.voc_index_intake,
+            .voc_index_exhaust = sensors.voc_index_exhaust,
+            .temperature_intake = sensors.temperature_intake,
+            .temperature_exhaust = sensors.temperature_exhaust,
+            .fan_power = fan::fan_power(),
+            .fan_rpm = fan::fan_rpm(),
+    };
+}
+
+auto advert_telemetry() {
+    return tuple{
+            FLAGS,
+            services<ORG_BLUETOOTH_SERVICE_ENVIRONMENTAL_SENSING>(),
+            service_data<ORG_BLUETOOTH_SERVICE_ENVIRONMENTAL_SENSING>(telemetry()),
+    };
+}
+static_assert(sizeof(advert_telemetry()) <= 31, "too large for non-extended advertisement");
+
+// Only ever touched from the BTstack context.
+// NB: BTstack holds onto the advert data pointer, these must outlive the advertisement.
+decltype(advert_telemetry()) g_advert_telemetry;
+btstack_timer_source_t g_refresh_timer;
+bool g_telemetry_enabled = false;
+
+void refresh(btstack_timer_source_t* timer) {
+    btstack_run_loop_set_timer(timer, SENSOR_UPDATE_PERIOD / 1ms);
+    btstack_run_loop_add_timer(timer);
+
+    bool const enabled = settings::g_active.advertise_telemetry;
+    if (!enabled && !g_telemetry_enabled) return;  // nothing to do, static advert already set
+
+    if (enabled != g_telemetry_enabled) printf("BLE GATT - advertise telemetry=%d\n", int(enabled));
+    g_telemetry_enabled = enabled;
+
+    if (enabled) {
+        g_advert_telemetry = advert_telemetry();
+        gap_advertisements_set_data(sizeof(g_advert_telemetry), (uint8_t*)&g_advert_telemetry);  // NOLINT
+    } else
+        gap_advertisements_set_data(sizeof(ADVERT), (uint8_t*)&ADVERT);  // NOLINT
+}
+
+}  // namespace
+
+bool init() {
+    btstack_run_loop_set_timer_handler(&g_refresh_timer, refresh);
+    return true;
+}
+
+void start() {
+    gap_advertisements_set_params(ADVERTISE_INTERVAL_MIN, ADVERTISE_INTERVAL_MAX);
+    gap_advertisements_set_data(sizeof(ADVERT), (uint8_t*)&ADVERT);               // NOLINT
+    gap_scan_response_set_data(sizeof(SCAN_RESPONSE), (uint8_t*)&SCAN_RESPONSE);  // NOLINT
+    gap_advertisements_enable(1);
+
+    g_telemetry_enabled = false;
+    btstack_run_loop_remove_timer(&g_refresh_timer);
+    refresh(&g_refresh_timer);
+}
+
+}  // namespace nevermore::gatt::advertise
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace nevermore::gatt::advertise {
+
+bool init();
+// Call once the HCI is up & running.
+void start();
+
+}  // namespace nevermore::gatt::advertise
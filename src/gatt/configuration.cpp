@@ -32,6 +32,7 @@ constexpr auto REBOOT_DELAY = 200ms;
 constexpr array FLAGS{
         &sensors::g_config.fallback,
         &sensors::g_config.fallback_exhaust_mcu,
+        &settings::g_active.advertise_telemetry,
 };
 
 void reboot_delayed(bool to_bootloader) {
@@ -65,6 +66,7 @@ optional<uint16_t> attr_read(
     switch (att_handle) {
         USER_DESCRIBE(CONFIG_REBOOT_01, "Reboot")
         USER_DESCRIBE(CONFIG_FLAGS_01, "Configuration Flags (bitset)")
+        USER_DESCRIBE(CONFIG_CHECKPOINT_SENSOR_CALIBRATION, "Checkpoint sensor calibration")
         USER_DESCRIBE(CONFIG_RESET_SENSOR_CALIBRATION, "Reset sensor calibration")
         USER_DESCRIBE(CONFIG_RESET_SETTINGS, "Reset settings (bitset)")
         USER_DESCRIBE(CONFIG_VOC_GATING_THRESHOLD, "VOC Gating Threshold")
@@ -119,6 +121,8 @@ optional<int> attr_write(
             if (auto const bit = uint64_t(1) << i; mask & bit) {
                 *FLAGS.at(i) = !!(flags & bit);
             }
+
+        sensors::touch();  // `FLAGS` includes `sensors::g_config`
         return 0;
     }
     case HANDLE_ATTR(CONFIG_RESET_SENSOR_CALIBRATION, VALUE): {
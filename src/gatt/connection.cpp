@@ -0,0 +1,204 @@
+#include "connection.hpp"
+#include "btstack_event.h"
+#include "btstack_run_loop.h"
+#include "hci.h"
+#include "l2cap.h"
+#include "sdk/gap.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+
+using namespace std;
+using namespace std::literals::chrono_literals;
+
+namespace nevermore::gatt::connection {
+
+namespace {
+
+struct Profile {
+    char const* name;
+    chrono::microseconds interval_min;
+    chrono::microseconds interval_max;
+    uint16_t latency;  // # of connection events we're allowed to skip if we've nothing to send
+    chrono::milliseconds supervision_timeout;
+
+    [[nodiscard]] constexpr bool validate() const {
+        return 7500us <= interval_min && interval_min <= interval_max && interval_max <= 4s &&
+               latency <= 499 && 100ms <= supervision_timeout && supervision_timeout <= 32s &&
+               (1 + latency) * interval_max * 2 < supervision_timeout;
+    }
+};
+
+// LED effects are streamed as a series of write w/o response. Want as many connection events as we can get.
+constexpr Profile PROFILE_STREAMING{"streaming", 7500us, 15ms, 0, 2s};
+// Otherwise we're only pushing telemetry once per `SENSOR_UPDATE_PERIOD` and the odd config write.
+constexpr Profile PROFILE_IDLE{"idle", 100ms, 200ms, 2, 6s};
+static_assert(PROFILE_STREAMING.validate());
+static_assert(PROFILE_IDLE.validate());
+
+// Also how long we leave the central's initial params alone after connecting. Service discovery is
+// a burst of round trips, don't slow it down.
+constexpr auto STREAMING_IDLE_AFTER = 5s;
+
+constexpr uint8_t LE_PHY_MASK_2M = 1 << 1;
+
+struct State {
+    hci_con_handle_t conn = HCI_CON_HANDLE_INVALID;
+    Profile const* profile = nullptr;  // `nullptr` -> whatever the central picked
+    btstack_timer_source_t idle_timer{};
+    uint32_t stream_begin_ms = 0;
+    uint32_t stream_last_ms = 0;
+    uint32_t stream_bytes = 0;
+};
+
+// Only ever touched from the BTstack context.
+array<State, MAX_NR_HCI_CONNECTIONS> g_connections;
+
+State* find(hci_con_handle_t conn) {
+    auto it = ranges::find_if(g_connections, [&](auto&& x) { return x.conn == conn; });
+    return it == g_connections.end() ? nullptr : &*it;
+}
+
+void profile_request(State& state, Profile const& profile) {
+    if (state.profile == &profile) return;  // no-op
+
+    printf("BLE GATT - conn=%d requesting %s profile\n", state.conn, profile.name);
+    if (auto err = gap_request_connection_parameter_update(state.conn, profile.interval_min,
+                profile.interval_max, profile.latency, profile.supervision_timeout)) {
+        // NB: Keep the old profile, a later request for this one has to retry instead of no-op'ing.
+        printf("WARN - BLE GATT - conn=%d connection parameter update failed err=0x%02x\n", state.conn, err);
+        return;
+    }
+
+    state.profile = &profile;
+}
+
+void idle_timer_arm(State& state, uint32_t ms) {
+    btstack_run_loop_remove_timer(&state.idle_timer);
+    btstack_run_loop_set_timer(&state.idle_timer, ms);
+    btstack_run_loop_add_timer(&state.idle_timer);
+}
+
+void idle_timer_fired(btstack_timer_source_t* timer) {
+    auto& state = *static_cast<State*>(btstack_run_loop_get_timer_context(timer));
+    if (state.conn == HCI_CON_HANDLE_INVALID) return;
+
+    // HACK: Don't re-arm on every write (~30 Hz for LED effects), check for quiet period lazily instead.
+    auto quiet = chrono::milliseconds(btstack_run_loop_get_time_ms() - state.stream_last_ms);
+    if (quiet < STREAMING_IDLE_AFTER) {
+        idle_timer_arm(state, (STREAMING_IDLE_AFTER - quiet) / 1ms);
+        return;
+    }
+
+    if (auto dur_ms = state.stream_last_ms - state.stream_begin_ms; state.stream_bytes && dur_ms) {
+        printf("BLE GATT - conn=%d streamed %u bytes over %u ms (%.2f KiB/s)\n", state.conn,
+                unsigned(state.stream_bytes), unsigned(dur_ms),
+                double(state.stream_bytes) / 1024 / (double(dur_ms) / 1000));
+    }
+    state.stream_bytes = 0;
+
+    profile_request(state, PROFILE_IDLE);
+}
+
+}  // namespace
+
+bool init() {
+    for (auto& state : g_connections) {
+        btstack_run_loop_set_timer_handler(&state.idle_timer, idle_timer_fired);
+        btstack_run_loop_set_timer_context(&state.idle_timer, &state);
+    }
+
+    l2cap_set_max_le_mtu(ATT_MTU_MAX);
+    return true;
+}
+
+void connected(hci_con_handle_t conn) {
+    auto* state = find(HCI_CON_HANDLE_INVALID);
+    if (!state) {
+        printf("ERR - BLE GATT - no connection slot for conn=%d\n", conn);
+        return;
+    }
+
+    *state = State{.conn = conn, .idle_timer = state->idle_timer};
+    state->stream_last_ms = btstack_run_loop_get_time_ms();
+    idle_timer_arm(*state, STREAMING_IDLE_AFTER / 1ms);
+
+    // Prefer 2M, controller falls back to 1M if the central doesn't support it.
+    // Data length extension is negotiated by the controller (`ENABLE_LE_DATA_LENGTH_EXTENSION`).
+    if (auto err = gap_le_set_phy(conn, 0, LE_PHY_MASK_2M, LE_PHY_MASK_2M, 0))
+        printf("WARN - BLE GATT - conn=%d PHY update request failed err=0x%02x\n", conn, err);
+}
+
+void disconnected(hci_con_handle_t conn) {
+    auto* state = find(conn);
+    if (!state) return;
+
+    btstack_run_loop_remove_timer(&state->idle_timer);
+    *state = State{.idle_timer = state->idle_timer};
+}
+
+void streaming(hci_con_handle_t conn, uint16_t bytes) {
+    auto* state = find(conn);
+    if (!state) return;
+
+    auto now = btstack_run_loop_get_time_ms();
+    if (state->stream_bytes == 0) state->stream_begin_ms = now;
+    state->stream_bytes += bytes;
+    state->stream_last_ms = now;
+
+    if (state->profile != &PROFILE_STREAMING) {
+        profile_request(*state, PROFILE_STREAMING);
+        idle_timer_arm(*state, STREAMING_IDLE_AFTER / 1ms);
+    }
+}
+
+void hci_event(uint8_t const* packet) {
+    switch (hci_event_packet_get_type(packet)) {
+    case ATT_EVENT_MTU_EXCHANGE_COMPLETE: {
+        printf("BLE GATT - conn=%d MTU=%d\n", att_event_mtu_exchange_complete_get_handle(packet),
+                att_event_mtu_exchange_complete_get_MTU(packet));
+    } break;
+
+    case HCI_EVENT_LE_META: {
+        switch (hci_event_le_meta_get_subevent_code(packet)) {
+        case HCI_SUBEVENT_LE_CONNECTION_UPDATE_COMPLETE: {
+            if (auto err = hci_subevent_le_connection_update_complete_get_status(packet)) {
+                printf("WARN - BLE GATT - connection update failed err=0x%02x\n", err);
+                break;
+            }
+
+            auto interval = hci_subevent_le_connection_update_complete_get_conn_interval(packet) *
+                            chrono::duration<double, milli>(BT_CONNECTION_INTERVAL_TICK);
+            printf("BLE GATT - conn=%d interval=%.2f ms latency=%d timeout=%d ms\n",
+                    hci_subevent_le_connection_update_complete_get_connection_handle(packet),
+                    interval.count(),
+                    hci_subevent_le_connection_update_complete_get_conn_latency(packet),
+                    int(hci_subevent_le_connection_update_complete_get_supervision_timeout(packet) *
+                            BT_CONNECTION_SUPERVISION_TIMEOUT_TICK / 1ms));
+        } break;
+
+        case HCI_SUBEVENT_LE_DATA_LENGTH_CHANGE: {
+            printf("BLE GATT - conn=%d data length tx=%d rx=%d\n",
+                    hci_subevent_le_data_length_change_get_connection_handle(packet),
+                    hci_subevent_le_data_length_change_get_max_tx_octets(packet),
+                    hci_subevent_le_data_length_change_get_max_rx_octets(packet));
+        } break;
+
+        case HCI_SUBEVENT_LE_PHY_UPDATE_COMPLETE: {
+            if (auto err = hci_subevent_le_phy_update_complete_get_status(packet)) {
+                printf("WARN - BLE GATT - PHY update failed err=0x%02x\n", err);
+                break;
+            }
+
+            printf("BLE GATT - conn=%d PHY tx=%d rx=%d\n",
+                    hci_subevent_le_phy_update_complete_get_connection_handle(packet),
+                    hci_subevent_le_phy_update_complete_get_tx_phy(packet),
+                    hci_subevent_le_phy_update_complete_get_rx_phy(packet));
+        } break;
+        }
+    } break;
+    }
+}
+
+}  // namespace nevermore::gatt::connection
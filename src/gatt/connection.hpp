@@ -0,0 +1,22 @@
+#pragma once
+
+#include "bluetooth.h"
+#include <cstdint>
+
+namespace nevermore::gatt::connection {
+
+// 247 -> ATT PDU + L2CAP header fits exactly in a single max length (251 octet) LL data PDU.
+// NB: Only the client can initiate an MTU exchange, this just caps what we'll agree to.
+constexpr uint16_t ATT_MTU_MAX = 247;
+constexpr uint16_t ATT_MTU_DEFAULT = 23;
+
+bool init();
+void connected(hci_con_handle_t);
+void disconnected(hci_con_handle_t);
+void hci_event(uint8_t const* packet);
+
+// Call whenever the client streams bulk data to us (i.e. WS2812 updates).
+// Switches the connection to a low latency profile until the stream goes quiet.
+void streaming(hci_con_handle_t, uint16_t bytes);
+
+}  // namespace nevermore::gatt::connection
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+// Attribute handle -> handler dispatch, see `gatt.cpp` & `cmake/gatt_dispatch.py`.
+// NB: No SDK/BTstack deps, the host benchmarks build it.
+namespace nevermore::gatt {
+
+// `Handler{}` is 'unrouted'.
+template <typename Handler>
+struct Route {
+    uint16_t handle;
+    Handler handler;
+};
+
+// Dense, handles are small & contiguous.
+template <auto const& ROUTES>
+constexpr auto DISPATCH = []() {
+    using R = std::remove_cvref_t<decltype(ROUTES[0])>;
+    std::array<decltype(R::handler), std::ranges::max(ROUTES, {}, &R::handle).handle + 1> xs{};
+    for (auto&& route : ROUTES)
+        xs.at(route.handle) = route.handler;
+    return xs;
+}();
+
+template <auto const& ROUTES>
+constexpr auto dispatch(uint16_t attr) {
+    return attr < DISPATCH<ROUTES>.size() ? DISPATCH<ROUTES>[attr] : decltype(ROUTES[0].handler){};
+}
+
+}  // namespace nevermore::gatt
@@ -12,9 +12,21 @@ using namespace BLE;
 
 #define DISPLAY_BRIGHTNESS 2B04_06
 #define DISPLAY_UI 86a25d55_1893_4d01_8ea8_8970f622c243_01
+#define DISPLAY_BUFFERING 64eccc24_c2c0_45f2_a16e_446ac5a4b119_01
+#define DISPLAY_STATS ecab8577_a8b9_48db_b810_405d1a1a234a_01
 
 namespace nevermore::gatt::display {
 
+namespace {
+
+struct [[gnu::packed]] Stats {
+    settings::DisplayBuffering buffering = nevermore::display::buffering();  // active, not the setting
+    uint32_t draw_arena_size = nevermore::display::draw_arena_size();
+    nevermore::display::Stats stats = nevermore::display::stats();
+};
+
+}  // namespace
+
 bool init() {
     return true;
 }
@@ -26,8 +38,12 @@ optional<uint16_t> attr_read(
     switch (att_handle) {
         USER_DESCRIBE(DISPLAY_BRIGHTNESS, "Display Brightness %")
         USER_DESCRIBE(DISPLAY_UI, "Display UI")
+        USER_DESCRIBE(DISPLAY_BUFFERING, "Display Buffering")
+        USER_DESCRIBE(DISPLAY_STATS, "Display Stats")
         READ_VALUE(DISPLAY_BRIGHTNESS, Percentage8(nevermore::display::brightness() * 100));
         READ_VALUE(DISPLAY_UI, settings::g_active.display_ui);
+        READ_VALUE(DISPLAY_BUFFERING, settings::g_active.display_buffering);
+        READ_VALUE(DISPLAY_STATS, Stats{});
 
     default: return {};
     }
@@ -57,6 +73,14 @@ optional<int> attr_write(hci_con_handle_t conn, uint16_t att_handle, uint16_t of
         return 0;
     }
 
+    case HANDLE_ATTR(DISPLAY_BUFFERING, VALUE): {
+        settings::DisplayBuffering const x = consume;
+        if (!settings::validate(x)) throw AttrWriteException(ATT_ERROR_VALUE_NOT_ALLOWED);
+
+        settings::g_active.display_buffering = x;  // takes effect on reboot
+        return 0;
+    }
+
     default: return {};
     }
 }
@@ -6,7 +6,11 @@
 #include "sdk/btstack.hpp"
 #include "sensors.hpp"
 #include "utility/timer.hpp"
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstring>
+#include <span>
 
 using namespace std;
 
@@ -17,7 +21,10 @@ using namespace std;
 #define VOC_INDEX_02 216aa791_97d0_46ac_8752_60bbc00611e1_02
 #define VOC_RAW_01 c3acb286_8071_427b_bbed_d64987373f23_01
 #define VOC_RAW_02 c3acb286_8071_427b_bbed_d64987373f23_02
+#define NOX_INDEX_01 4a9c2f31_7d5e_4b8a_9f06_c1e3b72d58a4_01
+#define NOX_INDEX_02 4a9c2f31_7d5e_4b8a_9f06_c1e3b72d58a4_02
 #define ENV_AGGREGATE_01 75134bec_dd06_49b1_bac2_c15e05fd7199_01
+#define ENV_ZONES_01 c7d1a3e5_2f4b_4c69_8e0d_61b5f9a2c438_01
 
 namespace nevermore::gatt::environmental {
 
@@ -64,16 +71,62 @@ const ESM ESM_VOC_RAW{
         .application = ESM::Application::Supplementary,
 };
 
+// using SGP41
+const ESM ESM_NOX_INDEX{
+        .sampling = ESM::Sampling::Instantaneous,
+        .update_interval = SENSOR_UPDATE_PERIOD / 1s,
+        .application = ESM::Application::Supplementary,
+};
+
 // NB: nRF Connect incorrectly reads this as a big-endian structure.
 // GATT supplementary spec section 2.4 explicitly says everything is little
 // endian unless otherwise noted. Section 4.1 describes `Valid Range` and has
 // nothing to say regarding its endianness.
 const BLE::ValidRange<nevermore::sensors::VOCIndex> VALID_RANGE_VOC_INDEX{.min = 0, .max = 500};
+const BLE::ValidRange<nevermore::sensors::NOxIndex> VALID_RANGE_NOX_INDEX{.min = 0, .max = 500};
+
+// Zones format:
+//  version     : u8
+//  zones_used  : u8
+//  zone_size   : u8, size of each `zones` entry
+//  temperature_mcu
+//  zones       : ZoneState[zones_used], indexed by `sensors::Zone`
+// Values use the same encoding as their dedicated characteristics & have fallbacks applied.
+// Fields are only ever appended to `ZoneState`, hosts must use `zone_size` to step between entries.
+constexpr uint8_t ZONES_VERSION = 1;
+
+struct [[gnu::packed]] ZonesHeader {
+    uint8_t version = ZONES_VERSION;
+    uint8_t zones_used;
+    uint8_t zone_size;
+    BLE::Temperature temperature_mcu;
+};
+
+struct [[gnu::packed]] ZoneState {
+    BLE::Temperature temperature;
+    BLE::Humidity humidity;
+    BLE::Pressure pressure;
+    nevermore::sensors::VOCIndex voc_index;
+    nevermore::sensors::VOCRaw voc_raw;
+    nevermore::sensors::NOxIndex nox_index;
+};
+
+// Only ever touched from the BTstack context.
+array<uint8_t, sizeof(ZonesHeader) + sizeof(ZoneState) * nevermore::sensors::ZONES_MAX> g_zones_state;
+
+auto sensors_v0() {
+    return nevermore::sensors::with_fallbacks().v0();
+}
 
 // NOLINTNEXTLINE(cppcoreguidelines-interfaces-global-init)
 auto g_notify_aggregate = NotifyState<[](hci_con_handle_t conn) {
-    att_server_notify(
-            conn, HANDLE_ATTR(ENV_AGGREGATE_01, VALUE), nevermore::sensors::g_sensors.with_fallbacks());
+    att_server_notify(conn, HANDLE_ATTR(ENV_AGGREGATE_01, VALUE), sensors_v0());
+}>();
+
+// NOLINTNEXTLINE(cppcoreguidelines-interfaces-global-init)
+auto g_notify_zones = NotifyState<[](hci_con_handle_t conn) {
+    auto state = zones_state();
+    att_server_notify(conn, HANDLE_ATTR(ENV_ZONES_01, VALUE), state.data(), state.size());
 }>();
 
 }  // namespace
@@ -82,11 +135,13 @@ bool init() {
     // HACK:  We'd like to notify on write changes, but the code base isn't setup
     //        for that yet. Internally poll and update based on diffs for now.
     mk_timer("gatt-env-notify", SENSOR_UPDATE_PERIOD / 2.)([](auto*) {
-        auto const& current = nevermore::sensors::g_sensors.with_fallbacks();
+        auto current = nevermore::sensors::with_fallbacks();
         static nevermore::sensors::Sensors g_prev;
         if (g_prev != current) {
+            // NB: Both track every zone reading, not worth diffing the v0 view separately.
             g_prev = current;
             g_notify_aggregate.notify();
+            g_notify_zones.notify();
         }
     });
 
@@ -95,11 +150,38 @@ bool init() {
 
 void disconnected(hci_con_handle_t conn) {
     g_notify_aggregate.unregister(conn);
+    g_notify_zones.unregister(conn);
+}
+
+span<uint8_t const> zones_state() {
+    auto sensors = nevermore::sensors::with_fallbacks();
+    ZonesHeader header{
+            .zones_used = sensors.zones_used,
+            .zone_size = sizeof(ZoneState),
+            .temperature_mcu = sensors.temperature_mcu,
+    };
+    memcpy(g_zones_state.data(), &header, sizeof(header));
+    size_t size = sizeof(header);
+
+    for (auto&& zone : span(sensors.zones).first(sensors.zones_used)) {
+        ZoneState x{
+                .temperature = zone.temperature,
+                .humidity = zone.humidity,
+                .pressure = zone.pressure,
+                .voc_index = zone.voc_index,
+                .voc_raw = zone.voc_raw,
+                .nox_index = zone.nox_index,
+        };
+        memcpy(&g_zones_state.at(size), &x, sizeof(x));
+        size += sizeof(x);
+    }
+
+    return span(g_zones_state).first(size);
 }
 
 optional<uint16_t> attr_read(
         hci_con_handle_t conn, uint16_t att_handle, uint16_t offset, uint8_t* buffer, uint16_t buffer_size) {
-    auto sensors = []() { return nevermore::sensors::g_sensors.with_fallbacks(); };
+    auto sensors = sensors_v0;
 
     switch (att_handle) {
         // NOLINTBEGIN(bugprone-branch-clone)
@@ -114,7 +196,10 @@ optional<uint16_t> attr_read(
         USER_DESCRIBE(VOC_INDEX_02, "Exhaust VOC Index")
         USER_DESCRIBE(VOC_RAW_01, "Intake VOC Raw")
         USER_DESCRIBE(VOC_RAW_02, "Exhaust VOC Raw")
+        USER_DESCRIBE(NOX_INDEX_01, "Intake NOx Index")
+        USER_DESCRIBE(NOX_INDEX_02, "Exhaust NOx Index")
         USER_DESCRIBE(ENV_AGGREGATE_01, "Aggregated Service Data")
+        USER_DESCRIBE(ENV_ZONES_01, "Environmental Zones")
 
         ESM_DESCRIBE(BT(TEMPERATURE_01), ESM_TEMPERATURE)
         ESM_DESCRIBE(BT(TEMPERATURE_02), ESM_TEMPERATURE)
@@ -127,9 +212,13 @@ optional<uint16_t> attr_read(
         ESM_DESCRIBE(VOC_INDEX_02, ESM_VOC_INDEX)
         ESM_DESCRIBE(VOC_RAW_01, ESM_VOC_RAW)
         ESM_DESCRIBE(VOC_RAW_02, ESM_VOC_RAW)
+        ESM_DESCRIBE(NOX_INDEX_01, ESM_NOX_INDEX)
+        ESM_DESCRIBE(NOX_INDEX_02, ESM_NOX_INDEX)
 
         HANDLE_READ_BLOB(VOC_INDEX_01, VALID_RANGE, VALID_RANGE_VOC_INDEX)
         HANDLE_READ_BLOB(VOC_INDEX_02, VALID_RANGE, VALID_RANGE_VOC_INDEX)
+        HANDLE_READ_BLOB(NOX_INDEX_01, VALID_RANGE, VALID_RANGE_NOX_INDEX)
+        HANDLE_READ_BLOB(NOX_INDEX_02, VALID_RANGE, VALID_RANGE_NOX_INDEX)
         // NOLINTEND(bugprone-branch-clone)
 
         READ_VALUE(BT(TEMPERATURE_01), sensors().temperature_intake)
@@ -143,9 +232,17 @@ optional<uint16_t> attr_read(
         READ_VALUE(VOC_INDEX_02, sensors().voc_index_exhaust)
         READ_VALUE(VOC_RAW_01, sensors().voc_raw_intake)
         READ_VALUE(VOC_RAW_02, sensors().voc_raw_exhaust)
+        READ_VALUE(NOX_INDEX_01, sensors().nox_index_intake)
+        READ_VALUE(NOX_INDEX_02, sensors().nox_index_exhaust)
         READ_VALUE(ENV_AGGREGATE_01, sensors())
 
         READ_CLIENT_CFG(ENV_AGGREGATE_01, g_notify_aggregate)
+        READ_CLIENT_CFG(ENV_ZONES_01, g_notify_zones)
+
+    case HANDLE_ATTR(ENV_ZONES_01, VALUE): {
+        auto state = zones_state();
+        return ::att_read_callback_handle_blob(state.data(), state.size(), offset, buffer, buffer_size);
+    }
 
     default: return {};
     }
@@ -159,6 +256,7 @@ optional<int> attr_write(hci_con_handle_t conn, uint16_t att_handle, uint16_t of
 
     switch (att_handle) {
         WRITE_CLIENT_CFG(ENV_AGGREGATE_01, g_notify_aggregate)
+        WRITE_CLIENT_CFG(ENV_ZONES_01, g_notify_zones)
 
     default: return {};
     }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "bluetooth.h"
+#include <cstdint>
 #include <optional>
+#include <span>
 
 namespace nevermore::gatt::environmental {
 
@@ -15,4 +17,7 @@ std::optional<int> attr_write(
 bool init();
 void disconnected(hci_con_handle_t);
 
+// Encoded zones characteristic value, also used by the bulk state. Only call from the BTstack context.
+std::span<uint8_t const> zones_state();
+
 }  // namespace nevermore::gatt::environmental
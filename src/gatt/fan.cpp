@@ -6,13 +6,26 @@
 #include "sdk/btstack.hpp"
 #include "sdk/pwm.hpp"
 #include "sensors.hpp"
+#include "sensors/async_sensor.hpp"
 #include "sensors/tachometer.hpp"
 #include "settings.hpp"
 #include "utility/fan_policy.hpp"
 #include "utility/fan_policy_thermal.hpp"
+#include "utility/fan_rpm_curve.hpp"
+#include "utility/filter_life.hpp"
+#include "utility/scope_guard.hpp"
+#include "utility/task.hpp"
 #include "utility/timer.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <cstdint>
+#include <cstdio>
+#include <initializer_list>
 #include <limits>
+#include <span>
+#include <utility>
 
 using namespace std;
 
@@ -26,26 +39,65 @@ using namespace std;
 #define FAN_POWER_TACHO_AGGREGATE 79cd747f_91af_49a6_95b2_5b597c683129_01
 // NB: Error prone, but we're the 2nd aggregation char instance in the DB
 #define FAN_AGGREGATE 75134bec_dd06_49b1_bac2_c15e05fd7199_02
+#define FAN_CONTROL_MODE 2eaec573_8cbf_4542_a91a_f4a3eef1680c_01
+#define FAN_RPM_CURVE 4ec1d504_c202_41e0_a2c7_db810879c3d9_01
+#define FAN_FILTER_LOAD 79d66381_c112_4b5f_b9ae_8445c98836ca_01
+#define FILTER_LIFE 4df932ec_e8e4_4528_84e9_e443098b0f53_01
 
 #define FAN_POLICY_COOLDOWN 2B16_01
 #define FAN_POLICY_VOC_PASSIVE_MAX 216aa791_97d0_46ac_8752_60bbc00611e1_03
 #define FAN_POLICY_VOC_IMPROVE_MIN 216aa791_97d0_46ac_8752_60bbc00611e1_04
+#define FAN_POLICY_NOX_PASSIVE_MAX 4a9c2f31_7d5e_4b8a_9f06_c1e3b72d58a4_03
+#define FAN_POLICY_ZONES 9e2b7c4d_51a3_4f08_b6d2_3c8e0a7f1d59_01
 
 namespace nevermore::gatt::fan {
 
 namespace {
 
-BLE_DECL_SCALAR(RPM16, uint16_t, 1, 0, 0);
-
-constexpr uint8_t FAN_POLICY_UPDATE_RATE_HZ = 10;
+// The policy is re-evaluated when an input changes or a deadline (e.g. cooldown end) expires.
+// Belt & braces: also re-evaluate at least this often. Catches inputs we don't explicitly track
+// (e.g. settings reset) and dropped timer commands.
+constexpr auto FAN_POLICY_REFRESH_PERIOD_MAX = 10s;
 
 constexpr uint8_t TACHOMETER_PULSE_PER_REVOLUTION = 2;
 constexpr uint32_t FAN_PWN_HZ = 25'000;
 
+// Time given to spin up/down between characterisation steps.
+// Needs to cover at least one full tachometer read period.
+constexpr auto FAN_RPM_CHARACTERISE_SETTLE = 4s;
+static_assert(sensors::Tachometer::TACHOMETER_READ_PERIOD * 2 < FAN_RPM_CHARACTERISE_SETTLE);
+// Integral gain for RPM control. Units: duty per unit of RPM error (normalised to max RPM).
+// Applied once per tachometer reading; kept low b/c the tachometer lags by a full read period.
+constexpr double FAN_RPM_CONTROL_GAIN = 0.25;
+
+constexpr auto FILTER_LIFE_UPDATE_PERIOD = 1min;
+// Don't thrash the flash, losing a few hours of estimate on power loss is fine.
+constexpr auto FILTER_LIFE_CHECKPOINT_PERIOD = 4h;
+
 BLE::Percentage8 g_fan_power = 0;
 BLE::Percentage8 g_fan_power_override;  // not-known -> automatic control
 sensors::Tachometer g_tachometer;
 
+// RPM control state, along w/ `settings::g_active.fan_rpm_curve`. Written by the fan policy timer, the
+// characterisation task & BTstack, only touch it via `rpm_locked`.
+bool g_rpm_characterising = false;  // fan is being driven by the characterisation task
+double g_rpm_target = 0;            // only meaningful in `FanControlMode::RPM`
+double g_rpm_trim = 0;              // duty correction on top of the characterised curve. [-1, 1]
+TaskHandle_t g_rpm_characterise_task = nullptr;  // parked between runs, see `rpm_characterise`
+
+TimerHandle_t g_fan_policy_timer = nullptr;
+atomic<bool> g_fan_policy_refresh_pending = false;
+
+FilterLife g_filter_life;  // working copy, checkpointed to `settings::g_active.filter_life`
+
+struct [[gnu::packed]] FilterLifeState {
+    BLE::Percentage8 remaining = g_filter_life.remaining() * 100;
+    BLE::Percentage8 efficiency = g_filter_life.efficiency_known()
+                                          ? BLE::Percentage8(g_filter_life.efficiency * 100)
+                                          : BLE::NOT_KNOWN;
+    BLE::TimeHour24 run_hours = floor(g_filter_life.run_hours);
+};
+
 struct [[gnu::packed]] FanPowerTachoAggregate {
     BLE::Percentage8 power = g_fan_power;
     RPM16 tachometer = fan_rpm();
@@ -71,12 +123,124 @@ auto g_notify_aggregate = NotifyState<[](hci_con_handle_t conn) {
     att_server_notify(conn, HANDLE_ATTR(FAN_AGGREGATE, VALUE), Aggregate{});
 }>();
 
+bool has_tachometer() {
+    return ranges::any_of(Pins::active().fan_tachometer, [](auto&& pin) { return !!pin; });
+}
+
+// NB: A critical section, not a mutex, the timer task mustn't block. Keep `go` short.
+template <typename F>
+auto rpm_locked(F&& go) {
+    taskENTER_CRITICAL();
+    SCOPE_GUARD {
+        taskEXIT_CRITICAL();
+    };
+    return go();
+}
+
+// REQUIRES: `rpm_locked`
+bool rpm_control_active_(settings::Settings const& settings) {
+    return settings.fan_control_mode == FanControlMode::RPM && settings.fan_rpm_curve.characterised() &&
+           !g_rpm_characterising && has_tachometer();
+}
+
+bool rpm_control_active(settings::Settings const& settings = settings::g_active) {
+    return rpm_locked([&] { return rpm_control_active_(settings); });
+}
+
+void fan_duty_apply(double duty) {
+    static optional<uint16_t> g_duty_raw;
+
+    auto duty_raw = uint16_t(numeric_limits<uint16_t>::max() * clamp(duty, 0., 1.));
+    if (g_duty_raw == duty_raw) return;
+
+    g_duty_raw = duty_raw;
+    for (auto&& pin : Pins::active().fan_pwm)
+        if (pin) pwm_set_gpio_duty(pin, duty_raw);
+}
+
+// `scale` [0, 1] -> PWM duty [0, 1]
+double fan_duty(double scale, settings::Settings const& settings) {
+    return rpm_locked([&] {
+        if (!rpm_control_active_(settings)) return scale;
+
+        auto const& curve = settings.fan_rpm_curve;
+        g_rpm_target = scale * curve.rpm_max();
+        if (g_rpm_target <= 0) return 0.;
+
+        // feed-forward from the curve, closed loop fixes up whatever drift there is
+        auto duty = curve.duty_for(g_rpm_target);
+        g_rpm_trim = clamp(g_rpm_trim, -duty, 1 - duty);  // anti-windup
+        return duty + g_rpm_trim;
+    });
+}
+
+// Call periodically. Only does work when the tachometer has a fresh reading.
+void rpm_control_update(settings::Settings const& settings = settings::g_active) {
+    static uint32_t g_readings_prev = 0;
+    if (g_readings_prev == g_tachometer.readings()) return;
+    g_readings_prev = g_tachometer.readings();
+
+    auto rpm = fan_rpm();
+    rpm_locked([&] {
+        if (!rpm_control_active_(settings) || g_rpm_target <= 0) {
+            g_rpm_trim = 0;
+            return;
+        }
+
+        auto error = (g_rpm_target - rpm) / settings.fan_rpm_curve.rpm_max();
+        g_rpm_trim = clamp(g_rpm_trim + error * FAN_RPM_CONTROL_GAIN, -1., 1.);
+    });
+}
+
+// Extra duty needed to hold the target RPM compared to when the fan was characterised.
+// A clogged filter shows up as a creeping increase.
+BLE::Percentage8 filter_load() {
+    return rpm_locked([] {
+        BLE::Percentage8 load;  // not-known
+        if (rpm_control_active_(settings::g_active) && 0 < g_rpm_target) load = max(0., g_rpm_trim) * 100;
+        return load;
+    });
+}
+
+// Hottest zone w/ a known temperature. Not-known only if every zone in use is.
+// NB: Can't `max` from a default `Temperature`, not-known is unordered so `max` would never leave it.
+constexpr BLE::Temperature temperature_hottest(sensors::Sensors const& sensors) {
+    BLE::Temperature hottest;
+    for (auto&& zone : span(sensors.zones).first(sensors.zones_used)) {
+        if (zone.temperature == BLE::NOT_KNOWN) continue;
+        if (hottest == BLE::NOT_KNOWN || hottest < zone.temperature) hottest = zone.temperature;
+    }
+    return hottest;
+}
+
+constexpr sensors::Sensors mk_sensors_temperatures(std::initializer_list<BLE::Temperature> xs) {
+    sensors::Sensors sensors;
+    sensors.zones_used = uint8_t(xs.size());
+    size_t i = 0;
+    for (auto x : xs)
+        sensors.zones.at(i++).temperature = x;
+    return sensors;
+}
+
+static_assert(temperature_hottest(mk_sensors_temperatures({40, 45})) == BLE::Temperature(45));
+static_assert(temperature_hottest(mk_sensors_temperatures({BLE::NOT_KNOWN, 45})) == BLE::Temperature(45));
+static_assert(temperature_hottest(mk_sensors_temperatures({40, BLE::NOT_KNOWN})) == BLE::Temperature(40));
+static_assert(
+        temperature_hottest(mk_sensors_temperatures({BLE::NOT_KNOWN, BLE::NOT_KNOWN})) == BLE::NOT_KNOWN);
+static_assert(temperature_hottest(mk_sensors_temperatures({40, BLE::NOT_KNOWN, 55})) == BLE::Temperature(55));
+static_assert(temperature_hottest(mk_sensors_temperatures({BLE::NOT_KNOWN, 50, 35})) == BLE::Temperature(50));
+static_assert(
+        temperature_hottest(mk_sensors_temperatures({BLE::NOT_KNOWN, BLE::NOT_KNOWN, BLE::NOT_KNOWN})) ==
+        BLE::NOT_KNOWN);
+
 void fan_power_set(BLE::Percentage8 power, sensors::Sensors const& sensors = sensors::g_sensors,
         settings::Settings const& settings = settings::g_active) {
-    auto temperature = max(sensors.temperature_intake, sensors.temperature_exhaust);
-    auto thermal_scaler = settings.fan_policy_thermal(temperature);
+    auto thermal_scaler = settings.fan_policy_thermal(temperature_hottest(sensors));
 
-    power = power.value_or(0) * thermal_scaler;
+    // usually unscaled, skip the soft-float round trip
+    power = thermal_scaler == 1 ? power.or_(0) : BLE::Percentage8(power.value_or(0) * thermal_scaler);
+    // filtering stirs the chamber, keep the environmental sensors up to date
+    sensors::SensorPeriodic::hurry(0 < power.value_or(0));
 
     if (g_fan_power != power) {
         g_fan_power = power;
@@ -84,10 +248,146 @@ void fan_power_set(BLE::Percentage8 power, sensors::Sensors const& sensors = sen
         g_notify_aggregate.notify();                  // `g_fan_power` changed
     }
 
+    // characterisation owns the fan until it's done
+    if (rpm_locked([] { return g_rpm_characterising; })) return;
+
     auto scale = (power.value_or(0) / 100.) * (settings.fan_power_coefficient.value_or(0) / 100.);
-    auto duty = uint16_t(numeric_limits<uint16_t>::max() * scale);
-    for (auto&& pin : Pins::active().fan_pwm)
-        if (pin) pwm_set_gpio_duty(pin, duty);
+    fan_duty_apply(fan_duty(scale, settings));
+}
+
+// Sensor derived policy inputs. Lets us skip re-evaluating when nothing relevant changed.
+struct PolicyInputs {
+    struct ZoneInputs {
+        sensors::VOCIndex voc;
+        sensors::NOxIndex nox;
+        BLE::Temperature temperature;  // thermal limiting considers every zone
+
+        bool operator==(ZoneInputs const&) const = default;
+    };
+
+    array<ZoneInputs, sensors::ZONES_MAX> zones;
+    uint32_t tachometer_readings = 0;
+
+    static PolicyInputs current() {
+        auto const& sensors = sensors::g_sensors;
+        PolicyInputs x{.tachometer_readings = rpm_control_active() ? g_tachometer.readings() : 0};
+        for (size_t i = 0; i < sensors.zones_used; ++i) {
+            auto const& zone = sensors.zones.at(i);
+            x.zones.at(i) = {.voc = zone.voc_index, .nox = zone.nox_index, .temperature = zone.temperature};
+        }
+        return x;
+    }
+
+    bool operator==(PolicyInputs const&) const = default;
+};
+
+PolicyInputs g_fan_policy_inputs;  // as of the last evaluation
+
+// Returns how long until the policy must be re-evaluated, assuming no inputs change.
+chrono::milliseconds fan_policy_update() {
+    static auto g_instance = settings::g_active.fan_policy_env.instance(
+            settings::g_active.fan_policy_nox_passive_max, settings::g_active.fan_policy_zones);
+
+    g_fan_policy_inputs = PolicyInputs::current();
+    rpm_control_update();
+
+    // still have to apply the override via the policy b/c of thermal limiting
+    if (g_fan_power_override != BLE::NOT_KNOWN) {
+        fan_power_set(g_fan_power_override);
+        return FAN_POLICY_REFRESH_PERIOD_MAX;
+    }
+
+    auto now = FanPolicyEnvironmental::Instance::Clock::now();
+    if (auto perc = g_instance(sensors::g_sensors, now); 0 < perc)
+        fan_power_set(perc * settings::g_active.fan_power_automatic.value_or(0));
+    else
+        fan_power_set(settings::g_active.fan_power_passive.value_or(0));
+
+    // cooldown ending is the only transition that happens w/o an input changing
+    auto until_cooldown_end = chrono::ceil<chrono::milliseconds>(g_instance.cooldown_remaining(now));
+    if (0ms < until_cooldown_end)
+        return min<chrono::milliseconds>(until_cooldown_end, FAN_POLICY_REFRESH_PERIOD_MAX);
+
+    return FAN_POLICY_REFRESH_PERIOD_MAX;
+}
+
+// NB: Must not block, also called from the timer task.
+void fan_policy_schedule(chrono::milliseconds delay) {
+    if (!g_fan_policy_timer) return;  // not initialised yet
+
+    xTimerChangePeriod(g_fan_policy_timer, max<TickType_t>(1, pdMS_TO_TICKS(delay / 1ms)), 0);
+}
+
+// Re-evaluate the policy ASAP. Safe to call from any task.
+void fan_policy_refresh() {
+    // coalesce, there's already a refresh queued which hasn't started yet
+    if (g_fan_policy_refresh_pending.exchange(true)) return;
+
+    fan_policy_schedule(0ms);
+}
+
+// Runs in whichever sensor task just finished a read, keep it cheap.
+// NB: Racy read of `g_fan_policy_inputs`. Worst case is a spurious or missed refresh, the latter is
+//     covered by `FAN_POLICY_REFRESH_PERIOD_MAX`.
+void fan_policy_sensor_read() {
+    if (PolicyInputs::current() != g_fan_policy_inputs) fan_policy_refresh();
+}
+
+// Sweeps the fan across the duty range & records the RPM reached at each step.
+// Takes `POINTS * FAN_RPM_CHARACTERISE_SETTLE`.
+void rpm_characterise_sweep() {
+    printf("fan - RPM characterisation started\n");
+
+    FanRPMCurve curve;
+    for (size_t i = 0; i < FanRPMCurve::POINTS; ++i) {
+        fan_duty_apply(double(i) / (FanRPMCurve::POINTS - 1));
+        task_delay(FAN_RPM_CHARACTERISE_SETTLE);
+        // tachometer is noisy, force monotonic so the curve is invertible
+        auto rpm = uint16_t(clamp<float>(fan_rpm(), 0, numeric_limits<uint16_t>::max()));
+        curve.rpm.at(i) = max(rpm, i == 0 ? uint16_t(0) : curve.rpm.at(i - 1));
+        printf("fan - RPM characterisation duty=%u%% rpm=%u\n", unsigned(i * 100 / (FanRPMCurve::POINTS - 1)),
+                unsigned(curve.rpm.at(i)));
+    }
+
+    // no RPM at full duty -> no fan/tachometer, curve stays uncharacterised & we retry next boot
+    rpm_locked([&] {
+        settings::g_active.fan_rpm_curve = curve;
+        g_rpm_trim = 0;
+        g_rpm_characterising = false;
+    });
+    fan_policy_refresh();  // hand the fan back to the policy
+}
+
+// Runs `rpm_characterise_sweep` in its own task.
+// NB: The task is never deleted, it parks until the next request. The idle task reaps deleted tasks
+//     whenever it gets around to it, a restart could otherwise reuse the storage while it's still live.
+void rpm_characterise() {
+    if (!has_tachometer()) {
+        printf("WARN - fan - RPM characterisation skipped, no tachometer\n");
+        return;
+    }
+
+    if (rpm_locked([] { return exchange(g_rpm_characterising, true); })) return;  // already running
+
+    if (!g_rpm_characterise_task) {
+        static TaskStorage<512> storage;
+        g_rpm_characterise_task = mk_task("fan-rpm-characterise", Priority::Sensors, storage)([]() {
+            for (;;) {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                rpm_characterise_sweep();
+            }
+        }).release();
+    }
+
+    xTaskNotifyGive(g_rpm_characterise_task);
+}
+
+// Don't sweep the fan on boot unless someone actually wants RPM control.
+void rpm_characterise_if_required(settings::Settings const& settings = settings::g_active) {
+    if (settings.fan_control_mode != FanControlMode::RPM) return;
+    if (rpm_locked([&] { return settings.fan_rpm_curve.characterised(); })) return;
+
+    rpm_characterise();
 }
 
 }  // namespace
@@ -106,16 +406,17 @@ void fan_power_override(BLE::Percentage8 power) {
 
     g_fan_power_override = power;
     g_notify_aggregate.notify();
-
-    if (power != BLE::NOT_KNOWN) {
-        fan_power_set(power);  // apply override
-    }
+    fan_policy_refresh();  // apply override, or resume automatic control
 }
 
 BLE::Percentage8 fan_power_override() {
     return g_fan_power_override;
 }
 
+double filter_life_remaining() {
+    return g_filter_life.remaining();
+}
+
 bool init() {
     // setup PWM configurations for fan PWM and fan tachometer
     for (auto&& pin : Pins::active().fan_pwm) {
@@ -132,6 +433,8 @@ bool init() {
     // set fan PWM level
     fan_power_set(g_fan_power);
 
+    rpm_characterise_if_required();
+
     // HACK:  We'd like to notify on write to tachometer changes, but the code base isn't setup
     //        for that yet. Internally poll and update based on diffs for now.
     mk_timer("gatt-fan-tachometer-notify", SENSOR_UPDATE_PERIOD)([](auto*) {
@@ -143,20 +446,36 @@ bool init() {
         g_notify_aggregate.notify();
     });
 
-    mk_timer("fan-policy", 1.s / FAN_POLICY_UPDATE_RATE_HZ)([](auto*) {
-        static auto g_instance = settings::g_active.fan_policy_env.instance();
-        // keep updating even w/ `g_fan_power_override` set b/c we need to
-        // refresh to account for thermal throttling policy
-        if (g_fan_power_override == BLE::NOT_KNOWN) {
-            if (auto perc = g_instance(sensors::g_sensors); 0 < perc)
-                fan_power_set(perc * settings::g_active.fan_power_automatic.value_or(0));
-            else
-                fan_power_set(settings::g_active.fan_power_passive.value_or(0));
-        } else {
-            fan_power_set(g_fan_power_override);
+    g_filter_life = settings::g_active.filter_life;
+    mk_timer("fan-filter-life", FILTER_LIFE_UPDATE_PERIOD)([](auto*) {
+        constexpr auto CHECKPOINT_EVERY = FILTER_LIFE_CHECKPOINT_PERIOD / FILTER_LIFE_UPDATE_PERIOD;
+        static uint32_t g_updates = 0;
+
+        // don't want fallbacks here, copying intake -> exhaust would look like a dead filter
+        auto const& sensors = sensors::g_sensors;
+        auto const& zones = settings::g_active.fan_policy_zones;
+        g_filter_life.update(sensors[zones.intake].voc_index.value_or(NAN),
+                sensors[zones.exhaust].voc_index.value_or(NAN), fan_power() / 100,
+                FILTER_LIFE_UPDATE_PERIOD / 1.h);
+
+        if (CHECKPOINT_EVERY <= ++g_updates) {
+            g_updates = 0;
+            settings::g_active.filter_life = g_filter_life;
         }
     });
 
+    // Auto-reload w/ the period (re)set after every update, a dropped command can't stall the policy.
+    g_fan_policy_timer = mk_timer("fan-policy", FAN_POLICY_REFRESH_PERIOD_MAX)([](auto*) {
+        g_fan_policy_refresh_pending = false;
+        fan_policy_schedule(fan_policy_update());
+
+        // A refresh requested mid-update might have queued its command *before* our reschedule,
+        // which then clobbers it. Re-issue it, worst case we evaluate twice.
+        if (g_fan_policy_refresh_pending) fan_policy_schedule(0ms);
+    });
+    sensors::SensorPeriodic::read_listener(fan_policy_sensor_read);
+    fan_policy_refresh();
+
     return true;
 }
 
@@ -176,10 +495,16 @@ optional<uint16_t> attr_read(
         USER_DESCRIBE(TACHOMETER, "Fan RPM")
         USER_DESCRIBE(FAN_POWER_TACHO_AGGREGATE, "Aggregated Fan % and RPM")
         USER_DESCRIBE(FAN_AGGREGATE, "Aggregated Service Data")
+        USER_DESCRIBE(FAN_CONTROL_MODE, "Fan Control Mode")
+        USER_DESCRIBE(FAN_RPM_CURVE, "Fan Duty to RPM Curve")
+        USER_DESCRIBE(FAN_FILTER_LOAD, "Fan Filter Load")
+        USER_DESCRIBE(FILTER_LIFE, "Filter Life Estimate")
 
         USER_DESCRIBE(FAN_POLICY_COOLDOWN, "How long to continue filtering after conditions are acceptable")
         USER_DESCRIBE(FAN_POLICY_VOC_PASSIVE_MAX, "Filter if any VOC sensor reaches this threshold")
         USER_DESCRIBE(FAN_POLICY_VOC_IMPROVE_MIN, "Filter if intake exceeds exhaust by this threshold")
+        USER_DESCRIBE(FAN_POLICY_NOX_PASSIVE_MAX, "Filter if any NOx sensor reaches this threshold")
+        USER_DESCRIBE(FAN_POLICY_ZONES, "Zones used as the filter's intake & exhaust")
         USER_DESCRIBE(FAN_POWER_THERMAL_LIMIT, "Thermal limiting cut-off")
 
         READ_VALUE(FAN_POWER, g_fan_power)
@@ -190,10 +515,16 @@ optional<uint16_t> attr_read(
         READ_VALUE(TACHOMETER, FanPowerTachoAggregate{}.tachometer)
         READ_VALUE(FAN_POWER_TACHO_AGGREGATE, FanPowerTachoAggregate{})
         READ_VALUE(FAN_AGGREGATE, Aggregate{});  // default init populate from global state
+        READ_VALUE(FAN_CONTROL_MODE, settings::g_active.fan_control_mode)
+        READ_VALUE(FAN_RPM_CURVE, rpm_locked([] { return settings::g_active.fan_rpm_curve; }))
+        READ_VALUE(FAN_FILTER_LOAD, filter_load())
+        READ_VALUE(FILTER_LIFE, FilterLifeState{})
 
         READ_VALUE(FAN_POLICY_COOLDOWN, settings::g_active.fan_policy_env.cooldown)
         READ_VALUE(FAN_POLICY_VOC_PASSIVE_MAX, settings::g_active.fan_policy_env.voc_passive_max)
         READ_VALUE(FAN_POLICY_VOC_IMPROVE_MIN, settings::g_active.fan_policy_env.voc_improve_min)
+        READ_VALUE(FAN_POLICY_NOX_PASSIVE_MAX, settings::g_active.fan_policy_nox_passive_max)
+        READ_VALUE(FAN_POLICY_ZONES, settings::g_active.fan_policy_zones)
         READ_VALUE(FAN_POWER_THERMAL_LIMIT, settings::g_active.fan_policy_thermal)
 
         READ_CLIENT_CFG(FAN_POWER_TACHO_AGGREGATE, g_notify_fan_power_tacho_aggregate)
@@ -203,7 +534,9 @@ optional<uint16_t> attr_read(
     }
 }
 
-optional<int> attr_write(hci_con_handle_t conn, uint16_t att_handle, uint16_t offset, uint8_t const* buffer,
+namespace {
+
+optional<int> attr_write_(hci_con_handle_t conn, uint16_t att_handle, uint16_t offset, uint8_t const* buffer,
         uint16_t buffer_size) {
     if (buffer_size < offset) return ATT_ERROR_INVALID_OFFSET;
     WriteConsumer consume{offset, buffer, buffer_size};
@@ -212,6 +545,7 @@ optional<int> attr_write(hci_con_handle_t conn, uint16_t att_handle, uint16_t of
         WRITE_VALUE(FAN_POLICY_COOLDOWN, settings::g_active.fan_policy_env.cooldown)
         WRITE_VALUE(FAN_POLICY_VOC_PASSIVE_MAX, settings::g_active.fan_policy_env.voc_passive_max)
         WRITE_VALUE(FAN_POLICY_VOC_IMPROVE_MIN, settings::g_active.fan_policy_env.voc_improve_min)
+        WRITE_VALUE(FAN_POLICY_NOX_PASSIVE_MAX, settings::g_active.fan_policy_nox_passive_max)
 
         WRITE_CLIENT_CFG(FAN_POWER_TACHO_AGGREGATE, g_notify_fan_power_tacho_aggregate)
         WRITE_CLIENT_CFG(FAN_AGGREGATE, g_notify_aggregate)
@@ -245,13 +579,57 @@ optional<int> attr_write(hci_con_handle_t conn, uint16_t att_handle, uint16_t of
         return 0;
     }
 
+    case HANDLE_ATTR(FAN_CONTROL_MODE, VALUE): {
+        FanControlMode value = consume.exactly<FanControlMode>();
+        if (!validate(value)) throw AttrWriteException(ATT_ERROR_VALUE_NOT_ALLOWED);
+
+        rpm_locked([&] {
+            settings::g_active.fan_control_mode = value;
+            g_rpm_trim = 0;
+        });
+        rpm_characterise_if_required();
+        return 0;
+    }
+
+    case HANDLE_ATTR(FAN_RPM_CURVE, VALUE): {
+        if (consume.remaining() == 0) {
+            rpm_characterise();
+            return 0;
+        }
+
+        FanRPMCurve value = consume.exactly<FanRPMCurve>();
+        if (!value.validate()) throw AttrWriteException(ATT_ERROR_VALUE_NOT_ALLOWED);
+
+        rpm_locked([&] {
+            settings::g_active.fan_rpm_curve = value;
+            g_rpm_trim = 0;
+        });
+        return 0;
+    }
+
+    case HANDLE_ATTR(FILTER_LIFE, VALUE): {
+        if (consume.remaining() != 0) throw AttrWriteException(ATT_ERROR_INVALID_ATTRIBUTE_VALUE_LENGTH);
+
+        // filter was replaced, start over
+        g_filter_life = {};
+        settings::g_active.filter_life = g_filter_life;
+        return 0;
+    }
+
+    case HANDLE_ATTR(FAN_POLICY_ZONES, VALUE): {
+        sensors::ZonePair value = consume.exactly<sensors::ZonePair>();
+        if (!value.validate()) throw AttrWriteException(ATT_ERROR_VALUE_NOT_ALLOWED);
+
+        settings::g_active.fan_policy_zones = value;
+        return 0;
+    }
+
     case HANDLE_ATTR(FAN_POWER_THERMAL_LIMIT, VALUE): {
         FanPolicyThermal value = consume;
         value = value.or_(settings::g_active.fan_policy_thermal);
         if (!value.validate()) throw AttrWriteException(ATT_ERROR_VALUE_NOT_ALLOWED);
 
         settings::g_active.fan_policy_thermal = value;
-        fan_power_set(g_fan_power);  // apply updated thermal coefficient
         return 0;
     }
 
@@ -259,4 +637,14 @@ optional<int> attr_write(hci_con_handle_t conn, uint16_t att_handle, uint16_t of
     }
 }
 
+}  // namespace
+
+optional<int> attr_write(hci_con_handle_t conn, uint16_t att_handle, uint16_t offset, uint8_t const* buffer,
+        uint16_t buffer_size) {
+    auto result = attr_write_(conn, att_handle, offset, buffer, buffer_size);
+    // nearly everything writable here is a policy input, simpler to refresh on any successful write
+    if (result == 0) fan_policy_refresh();
+    return result;
+}
+
 }  // namespace nevermore::gatt::fan
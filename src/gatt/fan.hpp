@@ -7,6 +7,8 @@
 
 namespace nevermore::gatt::fan {
 
+BLE_DECL_SCALAR(RPM16, uint16_t, 1, 0, 0);
+
 std::optional<uint16_t> attr_read(
         hci_con_handle_t, uint16_t att_handle, uint16_t offset, uint8_t* buffer, uint16_t buffer_size);
 
@@ -23,4 +25,7 @@ float fan_rpm();
 void fan_power_override(BLE::Percentage8 power);  // `NOT_KNOWN` to clear override
 BLE::Percentage8 fan_power_override();
 
+// Estimated remaining filter life. [0, 1]
+double filter_life_remaining();
+
 }  // namespace nevermore::gatt::fan
@@ -4,6 +4,9 @@
 #include "bluetooth.h"
 #include "btstack_config.h"
 #include "btstack_defines.h"
+#include "gatt/connection.hpp"
+#include "gatt/serial.hpp"
+#include "gatt/write_consumer.hpp"
 #include "hci.h"
 #include "sdk/btstack.hpp"  // IWYU pragma: keep [doesn't find overloads]
 #include <algorithm>
@@ -18,10 +21,33 @@ namespace nevermore::gatt {
 
 constexpr uint16_t GATT_CLIENT_CFG_NOTIFY_FLAG = 0b0000'0001;
 
+// Same as BTstack's, but also routes the wired transport's connection (`serial::CON_HANDLE`).
+inline uint8_t att_server_notify(
+        hci_con_handle_t conn, uint16_t attr, uint8_t const* value, uint16_t value_len) {
+    if (conn == serial::CON_HANDLE) return serial::notify(attr, {value, value_len});
+
+    return ::att_server_notify(conn, attr, value, value_len);
+}
+
+template <typename T>
+uint8_t att_server_notify(hci_con_handle_t conn, uint16_t attr, T const& value) {
+    static_assert(!std::is_pointer_v<T>);
+    return att_server_notify(conn, attr, reinterpret_cast<uint8_t const*>(&value), sizeof(T));
+}
+
+// The wired transport has no ATT MTU, report the largest we'd negotiate so it gets the same payloads.
+inline uint16_t att_server_get_mtu(hci_con_handle_t conn) {
+    if (conn == serial::CON_HANDLE) return connection::ATT_MTU_MAX;
+
+    return ::att_server_get_mtu(conn);
+}
+
 #define BT(x) ORG_BLUETOOTH_CHARACTERISTIC_##x
 #define HANDLE_ATTR_(attr, kind) ATT_CHARACTERISTIC_##attr##_##kind##_HANDLE
 #define HANDLE_ATTR(attr, kind) HANDLE_ATTR_(attr, kind)
 
+// NB: `cmake/gatt_dispatch.py` scans handlers for these (& `case HANDLE_ATTR(...)`) to check each answers
+//     exactly its routes. Add new case label macros to its `CASE_MACROS`.
 #define HANDLE_READ_BLOB(attr, kind, expr) \
     case HANDLE_ATTR(attr, kind): return att_read_callback_handle_blob(expr, offset, buffer, buffer_size);
 #define HANDLE_WRITE_EXPR(attr, kind, expr) \
@@ -38,76 +64,11 @@ constexpr uint16_t GATT_CLIENT_CFG_NOTIFY_FLAG = 0b0000'0001;
 #define WRITE_VALUE(attr, dst) \
     case HANDLE_ATTR(attr, VALUE): dst = consume.exactly<decltype(dst)>(); return 0;
 
-struct AttrWriteException {
-    int error;
-};
-
-struct WriteConsumer {
-    struct NotEnoughException {};
-
-    uint16_t offset;
-    uint8_t const* buffer;
-    uint16_t buffer_size;
-
-    template <typename A>
-        requires(std::is_standard_layout_v<A> && !std::is_pointer_v<A> && !std::is_reference_v<A>)
-    operator A() {
-        if (!has_available(sizeof(A))) throw AttrWriteException(ATT_ERROR_INVALID_ATTRIBUTE_VALUE_LENGTH);
-
-        // Ideally we'd like to just return a ptr within the buffer, but sadly
-        // ARM has stricter alignment requirements than x86's *ANYTHING-GOES!* approach.
-        A value;
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        memcpy((void*)&value, buffer + offset, sizeof(value));
-        offset += sizeof(A);
-        return value;
-    }
-
-    template <typename A>
-    A exactly() {
-        if (remaining() != sizeof(A)) throw AttrWriteException(ATT_ERROR_INVALID_ATTRIBUTE_VALUE_LENGTH);
-
-        return *this;
-    }
-
-    template <typename A>
-    A or_default(A default_) {
-        if (remaining() == 0) return default_;
-
-        return *this;
-    }
-
-    std::span<uint8_t const> span(size_t length) {
-        if (!has_available(sizeof(uint8_t) * length))
-            throw AttrWriteException(ATT_ERROR_INVALID_ATTRIBUTE_VALUE_LENGTH);
-
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        auto const* ptr = buffer + offset;
-        offset += sizeof(uint8_t) * length;
-        return {ptr, ptr + length};  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    }
-
-    [[nodiscard]] uint16_t remaining() const {
-        if (buffer_size < offset) return 0;
-
-        return buffer_size - offset;
-    }
-
-private:
-    [[nodiscard]] constexpr bool has_available(size_t n) const {
-        // Always return false, even for 0 byte reads, if beyond end of buffer.
-        // This prevents creating pointers beyond the last of an array + 1 (which is UB).
-        if (buffer_size < offset) return false;
-
-        auto const available = size_t(buffer_size) - offset;
-        return n <= available;
-    }
-};
-
 template <void (*Handler)(hci_con_handle_t)>
 struct NotifyState {
     static_assert(Handler != nullptr);
-    std::array<btstack_context_callback_registration_t, MAX_NR_HCI_CONNECTIONS> callbacks{};
+    // +1 for the wired transport
+    std::array<btstack_context_callback_registration_t, MAX_NR_HCI_CONNECTIONS + 1> callbacks{};
 
     NotifyState() {
         for (auto& cb : callbacks) {
@@ -137,15 +98,19 @@ struct NotifyState {
     bool unregister(hci_con_handle_t const conn) {
         // btstack only releases HCI connection info after registered event handlers
         // finish *and* no one triggered a reconnect
-        auto* hci_connection = hci_connection_for_handle(conn);
-        assert(hci_connection && "should still have HCI info until event handler completes");
+        auto* hci_connection = conn == serial::CON_HANDLE ? nullptr : hci_connection_for_handle(conn);
+        assert((conn == serial::CON_HANDLE || hci_connection) &&
+                "should still have HCI info until event handler completes");
 
         for (auto& cb : callbacks) {
             if (conn != uintptr_t(cb.context)) continue;
 
             // remove any pending notification requests
-            btstack_linked_list_remove(&hci_connection->att_server.notification_requests,
-                    reinterpret_cast<btstack_linked_item_t*>(&cb));
+            if (hci_connection)
+                btstack_linked_list_remove(&hci_connection->att_server.notification_requests,
+                        reinterpret_cast<btstack_linked_item_t*>(&cb));
+            else
+                serial::cancel(cb);
             cb.context = reinterpret_cast<void*>(HCI_CON_HANDLE_INVALID);  // unassign slot
             return true;
         }
@@ -154,9 +119,15 @@ struct NotifyState {
     }
 
     void notify() {
-        for (auto&& cb : callbacks)
-            if (uintptr_t(cb.context) != HCI_CON_HANDLE_INVALID)
-                att_server_request_to_send_notification(&cb, hci_con_handle_t(uintptr_t(cb.context)));
+        for (auto&& cb : callbacks) {
+            auto conn = hci_con_handle_t(uintptr_t(cb.context));
+            if (conn == HCI_CON_HANDLE_INVALID) continue;
+
+            if (conn == serial::CON_HANDLE)
+                serial::request_to_send(cb);
+            else
+                att_server_request_to_send_notification(&cb, conn);
+        }
     }
 
     [[nodiscard]] uint16_t client_configuration(hci_con_handle_t conn) const {
@@ -0,0 +1,288 @@
+#include "serial.hpp"
+#include "btstack_linked_list.h"
+#include "btstack_run_loop.h"
+#include "config.hpp"
+#include "gatt.hpp"
+#include "pico/stdio.h"
+#include "pico/stdio/driver.h"
+#include "task.h"  // IWYU pragma: keep [taskENTER_CRITICAL, ulTaskNotifyTake]
+#include "utility/cobs.hpp"
+#include "utility/crc.hpp"
+#include "utility/semaphore.hpp"
+#include "utility/task.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+extern "C" {
+// declared/defined by `pico_stdio_usb`
+extern stdio_driver_t stdio_usb;
+bool stdio_usb_connected();
+}
+
+namespace nevermore::gatt::serial {
+
+namespace {
+
+// Frame:   0x00 COBS(payload, crc32(payload) : u32) 0x00
+// Payload: op : u8, seq : u8, attr : u16, body : u8[]
+// Host -> controller. Replies have `op | OP_RESPONSE` and the request's `seq` & `attr`:
+//  Hello         body: -               reply: status : u8, version : u8, value_max : u16, db_size : u16
+//  Read          body: offset : u16    reply: status : u8, value : u8[<= value_max]
+//  Write         body: value : u8[]    reply: status : u8
+//  WriteCommand  body: value : u8[]    no reply
+//  Database      body: offset : u16    reply: status : u8, chunk : u8[<= value_max]
+// Controller -> host:
+//  Notify        body: value : u8[]    `seq` is 0
+// `status` is an ATT error code. `Database` returns BTstack's compiled attribute DB (`profile_data`),
+// hosts discover handles & properties from it, and serve reads of non-`DYNAMIC` attributes from it.
+// Integers are little endian. Frames w/ a bad CRC are dropped, hosts time out & retry.
+constexpr uint8_t VERSION = 1;
+// Largest attribute value ATT allows, so any of our values fits in a single read/write.
+constexpr uint16_t VALUE_MAX = 512;
+
+enum class Op : uint8_t {
+    Hello = 0x01,
+    Read = 0x02,
+    Write = 0x03,
+    WriteCommand = 0x04,
+    Database = 0x05,
+    Notify = 0x06,
+};
+constexpr uint8_t OP_RESPONSE = 0x80;
+
+struct [[gnu::packed]] Header {
+    uint8_t op;
+    uint8_t seq;
+    uint16_t attr;
+};
+
+struct [[gnu::packed]] HelloResponse {
+    uint8_t version = VERSION;
+    uint16_t value_max = VALUE_MAX;
+    uint16_t db_size = uint16_t(database().size());
+};
+
+// header + status/offset + value
+constexpr size_t PAYLOAD_MAX = sizeof(Header) + sizeof(uint16_t) + VALUE_MAX;
+constexpr size_t FRAME_MAX = 2 + cobs_encoded_size_max(PAYLOAD_MAX + sizeof(CRC32_t));
+
+// Only ever touched from the GATT context.
+array<uint8_t, PAYLOAD_MAX + sizeof(CRC32_t)> g_tx_payload;
+array<uint8_t, FRAME_MAX> g_tx_frame;
+
+// Only ever touched from the serial task, or from the GATT context while the task waits on `g_request_done`.
+array<uint8_t, FRAME_MAX> g_rx;  // encoded, decoded in place
+size_t g_rx_size = 0;
+bool g_rx_overflow = false;  // drop everything until the next delimiter
+span<uint8_t> g_request;
+
+TaskHandle_t g_task;
+SemaphoreStorage g_request_done_storage;
+SemaphoreHandle_t g_request_done;
+
+btstack_linked_list_t g_pending = nullptr;  // guarded by a critical section
+
+bool send(size_t size) {
+    // NB: Cheap early out, a closed port would drop it anyways.
+    if (!stdio_usb_connected()) return false;
+
+    auto crc = crc32(span(g_tx_payload).first(size));
+    memcpy(&g_tx_payload[size], &crc, sizeof(crc));
+    size += sizeof(crc);
+
+    g_tx_frame[0] = 0;
+    auto n = cobs_encode(span(g_tx_payload).first(size), span(g_tx_frame).subspan(1));
+    assert(n && "`FRAME_MAX` must cover `PAYLOAD_MAX`");
+    g_tx_frame[1 + *n] = 0;
+
+    // NB: One `out_chars` per frame, the driver's mutex keeps log output from being spliced into it.
+    //     Bypasses `stdio`'s CRLF translation, which would corrupt it anyways.
+    stdio_usb.out_chars(reinterpret_cast<char const*>(g_tx_frame.data()), int(*n + 2));
+    return true;
+}
+
+size_t response(Header const& request, uint8_t status) {
+    Header header{uint8_t(request.op | OP_RESPONSE), request.seq, request.attr};
+    memcpy(g_tx_payload.data(), &header, sizeof(header));
+    g_tx_payload[sizeof(header)] = status;
+    return sizeof(header) + 1;
+}
+
+void process(span<uint8_t> request) {
+    Header header;
+    memcpy(&header, request.data(), sizeof(header));
+    auto body = request.subspan(sizeof(header));
+
+    uint16_t offset = 0;
+    if (Op(header.op) == Op::Read || Op(header.op) == Op::Database) {
+        if (body.size() != sizeof(offset)) {
+            send(response(header, ATT_ERROR_INVALID_PDU));
+            return;
+        }
+
+        memcpy(&offset, body.data(), sizeof(offset));
+    }
+
+    switch (Op(header.op)) {
+    case Op::Hello: {
+        printf("USB GATT - session started\n");
+        disconnected(CON_HANDLE);  // drop the previous session's subscriptions
+
+        auto size = response(header, 0);
+        HelloResponse hello;
+        memcpy(&g_tx_payload[size], &hello, sizeof(hello));
+        send(size + sizeof(hello));
+    } break;
+
+    case Op::Read: {
+        auto size = response(header, 0);
+        size += attr_read(CON_HANDLE, header.attr, offset, &g_tx_payload[size], VALUE_MAX);
+        send(size);
+    } break;
+
+    case Op::Write:
+    case Op::WriteCommand: {
+        auto err = attr_write(CON_HANDLE, header.attr, ATT_TRANSACTION_MODE_NONE, 0, body.data(),
+                uint16_t(body.size()));
+        if (Op(header.op) == Op::Write) send(response(header, uint8_t(err)));
+    } break;
+
+    case Op::Database: {
+        auto db = database();
+        if (db.size() < offset) {
+            send(response(header, ATT_ERROR_INVALID_OFFSET));
+            break;
+        }
+
+        auto chunk = db.subspan(offset).first(min<size_t>(db.size() - offset, VALUE_MAX));
+        auto size = response(header, 0);
+        memcpy(&g_tx_payload[size], chunk.data(), chunk.size());
+        send(size + chunk.size());
+    } break;
+
+    default: send(response(header, ATT_ERROR_REQUEST_NOT_SUPPORTED)); break;
+    }
+}
+
+void drain_pending() {
+    for (;;) {
+        taskENTER_CRITICAL();
+        auto* cb = reinterpret_cast<btstack_context_callback_registration_t*>(
+                btstack_linked_list_pop(&g_pending));
+        taskEXIT_CRITICAL();
+        if (!cb) break;
+
+        cb->callback(cb->context);
+    }
+}
+
+btstack_context_callback_registration_t g_drain_pending{.callback = [](void*) { drain_pending(); }};
+btstack_context_callback_registration_t g_process_request{.callback = [](void*) {
+    process(g_request);
+    xSemaphoreGive(g_request_done);
+}};
+
+// Requests are handled one at a time, in order. Hosts pipeline by not waiting for replies to
+// `WriteCommand`s (e.g. WS2812 updates); USB flow control pushes back if we fall behind.
+void execute(span<uint8_t> request) {
+    if constexpr (NEVERMORE_PICO_W_BT) {
+        g_request = request;
+        btstack_run_loop_execute_on_main_thread(&g_process_request);
+        xSemaphoreTake(g_request_done, portMAX_DELAY);
+    } else
+        process(request);  // no BTstack run loop, we are the GATT context
+}
+
+void frame_received(span<uint8_t> frame) {
+    auto n = cobs_decode(frame, frame);
+    if (!n || *n < sizeof(Header) + sizeof(CRC32_t)) return;
+
+    auto payload = frame.first(*n - sizeof(CRC32_t));
+    CRC32_t crc;
+    memcpy(&crc, &frame[payload.size()], sizeof(crc));
+    if (crc != crc32(payload)) return;
+
+    execute(payload);
+}
+
+void receive(uint8_t x) {
+    if (x != 0) {
+        if (g_rx_size < g_rx.size())
+            g_rx[g_rx_size++] = x;
+        else
+            g_rx_overflow = true;
+        return;
+    }
+
+    // Every delimiter ends the frame in progress (if any) and starts the next.
+    if (g_rx_size && !g_rx_overflow) frame_received(span(g_rx).first(g_rx_size));
+    g_rx_size = 0;
+    g_rx_overflow = false;
+}
+
+void task() {
+    array<char, 64> buffer;  // one FS USB packet
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if constexpr (!NEVERMORE_PICO_W_BT) drain_pending();
+
+        for (int n; 0 < (n = stdio_usb.in_chars(buffer.data(), int(buffer.size())));)
+            for (auto x : span(buffer).first(n))
+                receive(uint8_t(x));
+    }
+}
+
+}  // namespace
+
+bool init() {
+    g_request_done = g_request_done_storage.mk_binary();
+
+    static TaskStorage<1024> storage;
+    g_task = mk_task("gatt-serial", Priority::Communication, storage)(task).release();
+
+    // NB: Called from the USB IRQ. Only wakes us on new data, the task drains everything available.
+    stdio_set_chars_available_callback(
+            [](void*) {
+                BaseType_t woken = pdFALSE;
+                vTaskNotifyGiveFromISR(g_task, &woken);
+                portYIELD_FROM_ISR(woken);
+            },
+            nullptr);
+
+    return true;
+}
+
+void request_to_send(btstack_context_callback_registration_t& cb) {
+    taskENTER_CRITICAL();
+    btstack_linked_list_add_tail(&g_pending, reinterpret_cast<btstack_linked_item_t*>(&cb));
+    taskEXIT_CRITICAL();
+
+    if constexpr (NEVERMORE_PICO_W_BT)
+        btstack_run_loop_execute_on_main_thread(&g_drain_pending);
+    else
+        xTaskNotifyGive(g_task);
+}
+
+void cancel(btstack_context_callback_registration_t& cb) {
+    taskENTER_CRITICAL();
+    btstack_linked_list_remove(&g_pending, reinterpret_cast<btstack_linked_item_t*>(&cb));
+    taskEXIT_CRITICAL();
+}
+
+uint8_t notify(uint16_t attr, span<uint8_t const> value) {
+    if (VALUE_MAX < value.size()) return ERROR_CODE_MEMORY_CAPACITY_EXCEEDED;
+
+    Header header{uint8_t(Op::Notify), 0, attr};
+    memcpy(g_tx_payload.data(), &header, sizeof(header));
+    memcpy(&g_tx_payload[sizeof(header)], value.data(), value.size());
+    if (!send(sizeof(header) + value.size())) return ERROR_CODE_UNKNOWN_CONNECTION_IDENTIFIER;
+
+    return ERROR_CODE_SUCCESS;
+}
+
+}  // namespace nevermore::gatt::serial
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "bluetooth.h"
+#include "btstack_defines.h"
+#include <cstdint>
+#include <span>
+
+// Wired GATT transport: the same attributes & handlers as BLE, over the USB CDC serial port.
+// Shares the port w/ `stdio` logging, frames are COBS encoded & `0x00` delimited so hosts can pick them
+// out of the log text. See `serial.cpp` for the frame format.
+namespace nevermore::gatt::serial {
+
+// Pseudo connection for the wired client. Outside of the HCI range (0x0000 - 0x0EFF).
+// There's only ever one; a new `Hello` drops the previous session's subscriptions.
+constexpr hci_con_handle_t CON_HANDLE = 0x0F00;
+
+bool init();
+
+// Same contract as `att_server_request_to_send_notification`. Safe to call from any task.
+// `cb` is invoked from the GATT context (the BTstack run loop if there is one, else the serial task).
+void request_to_send(btstack_context_callback_registration_t&);
+// Drops `cb` if it's still pending. Only call from the GATT context.
+void cancel(btstack_context_callback_registration_t&);
+
+// Same contract as `att_server_notify`. Only call from the GATT context.
+uint8_t notify(uint16_t attr, std::span<uint8_t const> value);
+
+}  // namespace nevermore::gatt::serial
@@ -0,0 +1,254 @@
+#include "status.hpp"
+#include "config.hpp"
+#include "gatt/connection.hpp"
+#include "gatt/environmental.hpp"
+#include "gatt/fan.hpp"
+#include "handler_helpers.hpp"
+#include "nevermore.h"
+#include "sdk/ble_data_types.hpp"
+#include "sdk/i2c_hw.hpp"
+#include "sdk/i2c_pio.hpp"
+#include "sdk/tickless.hpp"
+#include "sensors.hpp"
+#include "sensors/async_sensor.hpp"
+#include "settings.hpp"
+#include "utility/timer.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+using namespace std;
+
+#define STATUS_BULK 5054026d_913e_45fc_a1f6_0500b5c9ab8d_01
+#define STATUS_MEMORY 1a8f2c5e_6b3d_4e71_9c0a_7d24e5f81b36_01
+
+namespace nevermore::gatt::status {
+
+namespace {
+
+// Bulk state format:
+//  version : u8
+//  records : { type : u8, length : u8, value : u8[length] }*
+// Values use the same encoding as their dedicated characteristics.
+// Records are written in priority order and skipped if they don't fit in the connection's ATT MTU.
+// Hosts must ignore unknown record types and any trailing bytes of a record they don't know about.
+// `VERSION` only changes for incompatible changes to existing records.
+constexpr uint8_t VERSION = 1;
+
+enum class Record : uint8_t {
+    Environmental = 0x01,
+    Fan = 0x02,
+    FanPolicy = 0x03,
+    Config = 0x04,
+    Filter = 0x05,
+    Diagnostics = 0x06,
+    Zones = 0x07,
+};
+
+constexpr uint16_t ATT_NOTIFY_HEADER = 3;  // opcode + handle
+
+// `sensors::SensorsV0` w/ fallbacks, same as the environmental aggregate characteristic
+using RecordEnvironmental = sensors::SensorsV0;
+
+// NB: `power` & `tachometer` first, same as the fan power & tachometer aggregate characteristic
+struct [[gnu::packed]] RecordFan {
+    BLE::Percentage8 power = fan::fan_power();
+    fan::RPM16 tachometer = fan::fan_rpm();
+    BLE::Percentage8 power_override = fan::fan_power_override();
+    BLE::Percentage8 power_passive = settings::g_active.fan_power_passive;
+    BLE::Percentage8 power_automatic = settings::g_active.fan_power_automatic;
+    BLE::Percentage8 power_coefficient = settings::g_active.fan_power_coefficient;
+    FanControlMode control_mode = settings::g_active.fan_control_mode;
+};
+
+struct [[gnu::packed]] RecordFanPolicy {
+    FanPolicyEnvironmental environmental = settings::g_active.fan_policy_env;
+    FanPolicyThermal thermal = settings::g_active.fan_policy_thermal;
+    sensors::NOxIndex nox_passive_max = settings::g_active.fan_policy_nox_passive_max;
+    sensors::ZonePair zones = settings::g_active.fan_policy_zones;
+};
+
+struct [[gnu::packed]] RecordConfig {
+    // same bit order as the configuration flags characteristic
+    uint8_t flags = uint8_t(sensors::g_config.fallback) << 0 |
+                    uint8_t(sensors::g_config.fallback_exhaust_mcu) << 1 |
+                    uint8_t(settings::g_active.advertise_telemetry) << 2;
+    sensors::VOCIndex voc_gating_threshold = settings::g_active.voc_gating_threshold;
+    sensors::VOCIndex voc_gating_threshold_override = settings::g_active.voc_gating_threshold_override;
+    bool voc_calibration_enabled = settings::g_active.voc_calibration_enabled;
+    settings::DisplayUI display_ui = settings::g_active.display_ui;
+    BLE::Percentage8 display_brightness = settings::g_active.display_brightness * 100;
+};
+
+struct [[gnu::packed]] RecordFilter {
+    BLE::Percentage8 life_remaining = fan::filter_life_remaining() * 100;
+};
+
+struct [[gnu::packed]] RecordDiagnostics {
+    uint32_t uptime_sec = chrono::steady_clock::now().time_since_epoch() / 1s;
+    uint32_t heap_free = xPortGetFreeHeapSize();
+    uint32_t heap_free_min = xPortGetMinimumEverFreeHeapSize();
+    uint32_t tick_interrupts = tickless::stats().tick_interrupts;
+    uint32_t tickless_sleeps = tickless::stats().sleeps;
+    uint32_t ticks_slept = tickless::stats().ticks_slept;
+    uint32_t sensor_reads = sensors::SensorPeriodic::stats().reads;
+    uint32_t sensor_reads_deferred = sensors::SensorPeriodic::stats().reads_deferred;
+    uint32_t i2c_transactions = i2c[0].transactions() + i2c[1].transactions() + i2c_pio_transactions();
+    uint32_t i2c_pio_polled = i2c_pio_stats().polled;
+    uint32_t i2c_pio_polled_cpu_us = i2c_pio_stats().polled_cpu_us;
+    uint32_t i2c_pio_dma = i2c_pio_stats().dma;
+    uint32_t i2c_pio_dma_cpu_us = i2c_pio_stats().dma_cpu_us;
+};
+
+struct TLVWriter {
+    span<uint8_t> buffer;
+    size_t size = 0;
+
+    template <typename A>
+        requires(is_trivially_copyable_v<A>)
+    void record(Record type, A const& value) {
+        static_assert(sizeof(A) <= numeric_limits<uint8_t>::max());
+        if (buffer.size() < size + 2 + sizeof(A)) return;  // doesn't fit, try the next one
+
+        buffer[size++] = uint8_t(type);
+        buffer[size++] = uint8_t(sizeof(A));
+        memcpy(&buffer[size], &value, sizeof(A));
+        size += sizeof(A);
+    }
+
+    void record(Record type, span<uint8_t const> value) {
+        assert(value.size() <= numeric_limits<uint8_t>::max());
+        if (buffer.size() < size + 2 + value.size()) return;  // doesn't fit, try the next one
+
+        buffer[size++] = uint8_t(type);
+        buffer[size++] = uint8_t(value.size());
+        memcpy(&buffer[size], value.data(), value.size());
+        size += value.size();
+    }
+};
+
+// Only ever touched from the BTstack context.
+array<uint8_t, connection::ATT_MTU_MAX - ATT_NOTIFY_HEADER> g_bulk_state;
+
+// Sized to fit a single notification for `conn`, which also fits a single read response.
+span<uint8_t const> bulk_state(hci_con_handle_t conn) {
+    auto mtu = max(att_server_get_mtu(conn), connection::ATT_MTU_DEFAULT);
+    TLVWriter out{span(g_bulk_state).first(min<size_t>(g_bulk_state.size(), mtu - ATT_NOTIFY_HEADER))};
+
+    out.buffer[out.size++] = VERSION;
+    out.record(Record::Environmental, RecordEnvironmental{sensors::with_fallbacks().v0()});
+    out.record(Record::Fan, RecordFan{});
+    out.record(Record::Filter, RecordFilter{});
+    out.record(Record::FanPolicy, RecordFanPolicy{});
+    out.record(Record::Config, RecordConfig{});
+    out.record(Record::Diagnostics, RecordDiagnostics{});
+    // NB: last, it's the largest & only of interest to hosts tracking more than intake/exhaust
+    out.record(Record::Zones, environmental::zones_state());
+    return out.buffer.first(out.size);
+}
+
+// Memory report format:
+//  version         : u8
+//  heap_size       : u32
+//  heap_free       : u32
+//  heap_free_min   : u32
+//  tasks           : { stack_free_min : u16, name_length : u8, name : u8[name_length] }*
+// All sizes are in bytes. `stack_free_min` is the task's stack high-water mark.
+constexpr uint8_t MEMORY_VERSION = 1;
+// NB: `uxTaskGetSystemState` reports nothing at all if there are more tasks than this.
+constexpr size_t MEMORY_TASKS_MAX = 32;
+
+struct [[gnu::packed]] MemoryHeader {
+    uint8_t version = MEMORY_VERSION;
+    uint32_t heap_size = configTOTAL_HEAP_SIZE;
+    uint32_t heap_free = xPortGetFreeHeapSize();
+    uint32_t heap_free_min = xPortGetMinimumEverFreeHeapSize();
+};
+
+// Only ever touched from the BTstack context.
+array<TaskStatus_t, MEMORY_TASKS_MAX> g_memory_tasks;
+array<uint8_t, sizeof(MemoryHeader) + MEMORY_TASKS_MAX * (3 + configMAX_TASK_NAME_LEN)> g_memory_report;
+
+// NB: Rebuilt on every ATT read, so chunks of a long read can come from different snapshots.
+//     Harmless unless a task is created/deleted mid-read, which shifts the layout.
+span<uint8_t const> memory_report() {
+    MemoryHeader header;
+    memcpy(g_memory_report.data(), &header, sizeof(header));
+    size_t size = sizeof(header);
+
+    auto n = uxTaskGetSystemState(g_memory_tasks.data(), g_memory_tasks.size(), nullptr);
+    for (auto&& task : span(g_memory_tasks).first(n)) {
+        auto stack_free = uint16_t(min<size_t>(
+                task.usStackHighWaterMark * sizeof(StackType_t), numeric_limits<uint16_t>::max()));
+        auto name_len = uint8_t(strnlen(task.pcTaskName, configMAX_TASK_NAME_LEN));
+
+        memcpy(&g_memory_report[size], &stack_free, sizeof(stack_free));
+        size += sizeof(stack_free);
+        g_memory_report[size++] = name_len;
+        memcpy(&g_memory_report[size], task.pcTaskName, name_len);
+        size += name_len;
+    }
+
+    return span(g_memory_report).first(size);
+}
+
+auto g_notify_bulk_state = NotifyState<[](hci_con_handle_t conn) {
+    auto state = bulk_state(conn);
+    att_server_notify(conn, HANDLE_ATTR(STATUS_BULK, VALUE), state.data(), state.size());
+}>();
+
+}  // namespace
+
+bool init() {
+    // HACK:  We'd like to notify on write changes, but the code base isn't setup
+    //        for that yet. Everything in here changes at most once per sensor update anyways.
+    mk_timer("gatt-status-notify", SENSOR_UPDATE_PERIOD)([](auto*) { g_notify_bulk_state.notify(); });
+
+    return true;
+}
+
+void disconnected(hci_con_handle_t conn) {
+    g_notify_bulk_state.unregister(conn);
+}
+
+optional<uint16_t> attr_read(
+        hci_con_handle_t conn, uint16_t att_handle, uint16_t offset, uint8_t* buffer, uint16_t buffer_size) {
+    switch (att_handle) {
+        USER_DESCRIBE(STATUS_BULK, "Bulk State")
+        USER_DESCRIBE(STATUS_MEMORY, "Memory Usage")
+
+        READ_CLIENT_CFG(STATUS_BULK, g_notify_bulk_state)
+
+    case HANDLE_ATTR(STATUS_BULK, VALUE): {
+        auto state = bulk_state(conn);
+        return ::att_read_callback_handle_blob(state.data(), state.size(), offset, buffer, buffer_size);
+    }
+
+    case HANDLE_ATTR(STATUS_MEMORY, VALUE): {
+        auto report = memory_report();
+        return ::att_read_callback_handle_blob(report.data(), report.size(), offset, buffer, buffer_size);
+    }
+
+    default: return {};
+    }
+}
+
+optional<int> attr_write(hci_con_handle_t conn, uint16_t att_handle, uint16_t offset, uint8_t const* buffer,
+        uint16_t buffer_size) {
+    if (buffer_size < offset) return ATT_ERROR_INVALID_OFFSET;
+    WriteConsumer consume{offset, buffer, buffer_size};
+
+    switch (att_handle) {
+        WRITE_CLIENT_CFG(STATUS_BULK, g_notify_bulk_state)
+
+    default: return {};
+    }
+}
+
+}  // namespace nevermore::gatt::status
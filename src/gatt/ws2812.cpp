@@ -1,5 +1,6 @@
 #include "ws2812.hpp"
 #include "../ws2812.hpp"
+#include "connection.hpp"
 #include "handler_helpers.hpp"
 #include "nevermore.h"
 #include "sdk/ble_data_types.hpp"
@@ -81,8 +82,8 @@ optional<uint16_t> attr_read(
     }
 }
 
-optional<int> attr_write(
-        hci_con_handle_t, uint16_t att_handle, uint16_t offset, uint8_t const* buffer, uint16_t buffer_size) {
+optional<int> attr_write(hci_con_handle_t conn, uint16_t att_handle, uint16_t offset, uint8_t const* buffer,
+        uint16_t buffer_size) {
     if (buffer_size < offset) return ATT_ERROR_INVALID_OFFSET;
     WriteConsumer consume{offset, buffer, buffer_size};
 
@@ -97,6 +98,7 @@ optional<int> attr_write(
 
     case HANDLE_ATTR(WS2812_UPDATE_SPAN_01, VALUE): {
         DBG_update_rate_log();
+        connection::streaming(conn, buffer_size);
 
         UpdateSpanHeader header = consume;
         // be extra picky, reject any pending extra data
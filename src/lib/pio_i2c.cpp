@@ -382,3 +382,51 @@ int pio_i2c_write_blocking(PIO pio, uint sm, uint8_t addr, uint8_t const* txbuf,
 int pio_i2c_read_blocking(PIO pio, uint sm, uint8_t addr, uint8_t* rxbuf, size_t len) {
     return pio_i2c_read_blocking_internal(pio, sm, addr, rxbuf, len, nullptr, nullptr);
 }
+
+size_t pio_i2c_encode(uint16_t* dst, uint8_t const addr, uint8_t const* txbuf, size_t const len) {
+    uint16_t* out = dst;
+    // START, same sequence as `Context::start`
+    *out++ = 1u << PIO_I2C_ICOUNT_LSB;
+    *out++ = set_scl_sda_program_instructions[I2C_SC1_SD0];
+    *out++ = set_scl_sda_program_instructions[I2C_SC0_SD0];
+
+    *out++ = (addr << 2) | (txbuf ? 1u : 3u);
+    for (size_t i = 0; i < len; ++i) {
+        bool const final = i + 1 == len;
+        if (txbuf)
+            *out++ = (txbuf[i] << PIO_I2C_DATA_LSB) | (final << PIO_I2C_FINAL_LSB) | 1u;
+        else  // stuff 0xff to get clocks, NAK the last byte
+            *out++ = (0xffu << 1) | (final ? (1u << PIO_I2C_FINAL_LSB) | (1u << PIO_I2C_NAK_LSB) : 0);
+    }
+
+    // STOP, same sequence as `Context::stop`
+    *out++ = 2u << PIO_I2C_ICOUNT_LSB;
+    *out++ = set_scl_sda_program_instructions[I2C_SC0_SD0];
+    *out++ = set_scl_sda_program_instructions[I2C_SC1_SD0];
+    *out++ = set_scl_sda_program_instructions[I2C_SC1_SD1];
+
+    assert(size_t(out - dst) == pio_i2c_encoded_len(len));
+    return out - dst;
+}
+
+void pio_i2c_prepare(PIO pio, uint sm) {
+    Context ctx{pio, sm, nullptr, nullptr};
+    // NB: RX is on for writes too, the RX count is how the DMA side knows every byte went out.
+    //     Autopush stalls the SM if RX is full, so the caller must drain all `len + 1` entries.
+    ctx.rx_enable(true);
+    while (!ctx.rx_empty())
+        (void)ctx.get();
+}
+
+int pio_i2c_wait_done(PIO pio, uint sm) {
+    Context ctx{pio, sm, nullptr, nullptr};
+    ctx.wait_idle();
+    return ctx.check_error();
+}
+
+void pio_i2c_abort(PIO pio, uint sm) {
+    Context ctx{pio, sm, nullptr, nullptr};
+    ctx.resume_after_error();
+    ctx.stop();
+    ctx.wait_idle();
+}
@@ -40,6 +40,27 @@ static inline int pio_i2c_read_timeout_us(
     return pio_i2c_read_blocking_until(pio, sm, addr, rxbuf, len, t);
 }
 
+// ----------------------------------------------------------------------------
+// Pre-encoded transactions, for feeding the SM via DMA instead of polling the FIFOs.
+// Every byte clocked (incl. the address) pushes one RX FIFO entry, so a `len` byte transaction yields
+// exactly `len + 1` entries. The first is the address echo, reads' data follows it.
+
+// # of TX FIFO entries (16-bit) needed to encode a `len` byte transaction.
+static inline size_t pio_i2c_encoded_len(size_t len) {
+    return len + 8;  // 3 START + 1 address + `len` data + 4 STOP
+}
+
+// Encodes a complete START..STOP transaction into `dst`. Reads if `txbuf` is null, writes otherwise.
+// Returns # of entries written, always `pio_i2c_encoded_len(len)`.
+size_t pio_i2c_encode(uint16_t* dst, uint8_t addr, uint8_t const* txbuf, size_t len);
+// Readies the SM for an encoded transaction: RX autopush on & RX FIFO drained.
+void pio_i2c_prepare(PIO pio, uint sm);
+// Spins until the SM has run out of TX (i.e. issued STOP) or flagged an error.
+// Returns 0 or `PICO_ERROR_GENERIC` on NAK.
+int pio_i2c_wait_done(PIO pio, uint sm);
+// Recovers from an errored/abandoned transaction: flushes the SM, clears the error & issues STOP.
+void pio_i2c_abort(PIO pio, uint sm);
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,9 +9,11 @@
 #include "pico/stdio.h"
 #include "pico/time.h"
 #include "sdk/i2c.hpp"
+#include "sdk/tickless.hpp"
 #include "sensors.hpp"
 #include "settings.hpp"
 #include "task.h"  // IWYU pragma: keep
+#include "utility/boot_timeline.hpp"
 #include "utility/i2c.hpp"
 #include "utility/task.hpp"
 #include "utility/timer.hpp"
@@ -33,7 +35,9 @@ using namespace std;
 using namespace nevermore;
 
 extern "C" {
-void vApplicationTickHook() {}
+void vApplicationTickHook() {
+    tickless::tick_hook();
+}
 
 void vApplicationStackOverflowHook(TaskHandle_t Task, char* pcTaskName) {
     panic("PANIC - stack overflow in task %s\n", pcTaskName);
@@ -43,12 +47,51 @@ void vApplicationMallocFailedHook() {
     panic("PANIC - heap alloc failed\n");
 }
 
+#if NEVERMORE_STATIC_ALLOCATION
+void vApplicationGetIdleTaskMemory(
+        StaticTask_t** tcb, StackType_t** stack, configSTACK_DEPTH_TYPE* stack_depth) {
+    static StaticTask_t g_tcb;
+    static StackType_t g_stack[configMINIMAL_STACK_SIZE];
+    *tcb = &g_tcb;
+    *stack = g_stack;
+    *stack_depth = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(
+        StaticTask_t** tcb, StackType_t** stack, configSTACK_DEPTH_TYPE* stack_depth) {
+    static StaticTask_t g_tcb;
+    static StackType_t g_stack[configTIMER_TASK_STACK_DEPTH];
+    *tcb = &g_tcb;
+    *stack = g_stack;
+    *stack_depth = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+
 // declared/defined by `pico_stdio_usb`
 bool stdio_usb_connected();
 }
 
 namespace {
 
+#if NEVERMORE_STATIC_ALLOCATION
+constexpr auto HEAP_WATCH_PERIOD = 1min;
+
+// Everything we allocate ourselves is static, so the heap shouldn't grow after boot.
+// Complain if it does, it's either a leak or fragmentation (remaining users are the SDK, BTstack, etc.).
+void heap_watch_start() {
+    static size_t g_heap_free_min = xPortGetMinimumEverFreeHeapSize();
+    printf("heap - %u bytes free after boot\n", unsigned(g_heap_free_min));
+
+    mk_timer("heap-watch", HEAP_WATCH_PERIOD)([](TimerHandle_t) {
+        auto free_min = xPortGetMinimumEverFreeHeapSize();
+        if (g_heap_free_min <= free_min) return;
+
+        printf("WARN - heap - usage grew %u bytes since boot\n", unsigned(g_heap_free_min - free_min));
+        g_heap_free_min = free_min;
+    });
+}
+#endif
+
 // Leave pins {0, 1} set to UART TX/RX.
 // Clear everything else.
 void pins_clear_user_defined() {
@@ -104,6 +147,7 @@ void startup() {
             sleep(100ms);
     }
 
+    boot_timeline("startup");
     settings::init();
 
     pins_clear_user_defined();
@@ -115,8 +159,10 @@ void startup() {
 
     ws2812::init();
     if (!gatt::init()) return;
+    boot_timeline("gatt - init done");
     // display must be init before sensors b/c some sensors are display input devices
     if (!display::init_with_ui()) return;
+    boot_timeline("display - init done");
     if (!sensors::init()) return;
 
     mk_timer("led-blink", SENSOR_UPDATE_PERIOD)([](TimerHandle_t) {
@@ -139,13 +185,19 @@ void startup() {
     });
 
     if constexpr (NEVERMORE_PICO_W_BT) {
-        mk_task("bluetooth", Priority::Communication, 1024)(btstack_run_loop_execute).release();
+        static TaskStorage<1024> storage;
+        mk_task("bluetooth", Priority::Communication, storage)(btstack_run_loop_execute).release();
     }
+
+#if NEVERMORE_STATIC_ALLOCATION
+    heap_watch_start();
+#endif
 }
 
 int main() {
     // has to be done on core 0 for `stdio_init_all`.
-    mk_task("startup", Priority::Startup, 1024, 1 << 0)([]() {
+    static TaskStorage<1024> storage;
+    mk_task("startup", Priority::Startup, storage, 1 << 0)([]() {
         startup();
         vTaskDelete(nullptr);  // we're done, delete ourselves
     }).release();
@@ -6,6 +6,7 @@
 #include <climits>
 #include <cmath>
 #include <compare>
+#include <concepts>
 #include <cstdint>
 #include <limits>
 #include <type_traits>
@@ -140,9 +141,10 @@ constexpr A check_for_overflow(A x) {
     return x;
 }
 
+// NB: `BLE_DECL_SCALAR` types have a `nullptr` not-known value, i.e. none.
 template <typename A>
 concept has_not_known = requires {
-    { std::is_same_v<decltype(A::not_known_value), typename A::Raw> };
+    requires !std::is_null_pointer_v<std::remove_cvref_t<decltype(A::not_known_value)>>;
 };
 
 constexpr double raw_to_repr_coeff(int M, int d, int b) {
@@ -160,6 +162,13 @@ constexpr double raw_to_repr_coeff(int M, int d, int b) {
     return M * pow(10., d) * pow(2., b);
 }
 
+constexpr int64_t pow10_int(int i) {
+    int64_t r = 1;
+    for (; i > 0; --i)
+        r *= 10;
+    return r;
+}
+
 template <typename Unit, typename Raw_, int32_t M_ = 1, int32_t D = 0, int32_t B = 0,
         auto NOT_KNOWN_VALUE = nullptr>
 struct [[gnu::packed]] Scalar {
@@ -174,6 +183,17 @@ struct [[gnu::packed]] Scalar {
     static constexpr double scale = raw_to_repr_coeff(M, d, b);
     static constexpr auto not_known_value = NOT_KNOWN_VALUE;
 
+    // The RP2040 has no FPU, soft-float divides are ~2x the cost of multiplies.
+    // Decimal scales (`M == 1`, `b == 0`, `d <= 0`) get an exact reciprocal instead of `1 / 0.01` etc.
+    static constexpr bool scale_decimal = M == 1 && b == 0 && d <= 0;
+    static constexpr int64_t scale_decimal_unit = pow10_int(-d);  // raw units per repr unit
+    static constexpr double scale_inv = scale_decimal ? double(scale_decimal_unit) : 1 / scale;
+    // Integers convert/compare w/o touching soft-float at all.
+    static constexpr bool integer_fast_path = scale_decimal && std::is_integral_v<Raw>;
+
+    // Difference between two readings (`operator-`). Signed & always known, e.g. `Humidity` is unsigned.
+    using Delta = Scalar<Unit, int32_t, M_, D, B, nullptr>;
+
     static constexpr Scalar from_raw(Raw raw) {
         Scalar x{0};  // zero init to avoid default ctor & constexpr lifetime ordering issue
         x.raw_value = raw;
@@ -195,7 +215,15 @@ struct [[gnu::packed]] Scalar {
         raw_value = NOT_KNOWN_VALUE;
     }
 
-    constexpr Scalar(double value) : raw_value(static_cast<Raw>(value / scale)) {}
+    constexpr Scalar(double value) : raw_value(static_cast<Raw>(value * scale_inv)) {}
+
+    template <std::integral I>
+    constexpr Scalar(I value) {
+        if constexpr (integer_fast_path)
+            raw_value = static_cast<Raw>(int64_t(value) * scale_decimal_unit);
+        else
+            raw_value = static_cast<Raw>(double(value) * scale_inv);
+    }
 
     constexpr explicit operator double() const {
         if constexpr (has_not_known<Scalar>) {
@@ -217,6 +245,12 @@ struct [[gnu::packed]] Scalar {
         return *this == NOT_KNOWN ? x : double(*this);
     }
 
+    // `double(*this) / Divisor`, w/ the divide folded into the scale. PRECONDITION: known
+    template <double Divisor>
+    [[nodiscard]] constexpr double scaled() const {
+        return raw_value * (scale / Divisor);
+    }
+
     // sadly, because we're not doing `<=> = default`, we don't get the free definitions for <, ==, etc..
     constexpr bool operator==(Scalar const&) const = default;
 };
@@ -239,6 +273,19 @@ constexpr auto operator<=>(Scalar<Unit, Raw, M, D, B, NKV> const& lhs, double co
     return lhs <=> Scalar<Unit, Raw, M, D, B, NKV>(rhs);
 }
 
+template <typename Unit, typename Raw, int32_t M, int32_t D, int32_t B, auto NKV, std::integral I>
+constexpr auto operator<=>(Scalar<Unit, Raw, M, D, B, NKV> const& lhs, I const& rhs) {
+    using S = Scalar<Unit, Raw, M, D, B, NKV>;
+    if constexpr (!S::integer_fast_path) {
+        return lhs <=> S(rhs);
+    } else if constexpr (has_not_known<S>) {
+        if (lhs == NOT_KNOWN) return std::partial_ordering::unordered;
+        return std::partial_ordering(int64_t(lhs.raw_value) <=> int64_t(rhs) * S::scale_decimal_unit);
+    } else {
+        return int64_t(lhs.raw_value) <=> int64_t(rhs) * S::scale_decimal_unit;
+    }
+}
+
 template <typename Unit, typename Raw, int32_t M, int32_t D, int32_t B, auto NKV>
 constexpr auto operator<=>(Scalar<Unit, Raw, M, D, B, NKV> const& lhs, struct NOT_KNOWN const& rhs)
     requires has_not_known<Scalar<Unit, Raw, M, D, B, NKV>>
@@ -246,6 +293,46 @@ constexpr auto operator<=>(Scalar<Unit, Raw, M, D, B, NKV> const& lhs, struct NO
     return lhs <=> Scalar<Unit, Raw, M, D, B, NKV>(rhs);
 }
 
+// Arithmetic stays on the raw values, same unit & exponents so no rescaling (or soft-float) needed.
+// PRECONDITION: operands are known
+template <typename Unit, typename Raw, int32_t M, int32_t D, int32_t B, auto NKV>
+constexpr auto operator-(
+        Scalar<Unit, Raw, M, D, B, NKV> const& lhs, Scalar<Unit, Raw, M, D, B, NKV> const& rhs) {
+    using S = Scalar<Unit, Raw, M, D, B, NKV>;
+    if constexpr (has_not_known<S>) assert(lhs != NOT_KNOWN && rhs != NOT_KNOWN);
+    return S::Delta::from_raw(int32_t(int64_t(lhs.raw_value) - int64_t(rhs.raw_value)));
+}
+
+template <typename Unit, typename Raw, int32_t M, int32_t D, int32_t B, auto NKV>
+constexpr auto operator+(Scalar<Unit, Raw, M, D, B, NKV> const& lhs,
+        typename Scalar<Unit, Raw, M, D, B, NKV>::Delta const& rhs) {
+    using S = Scalar<Unit, Raw, M, D, B, NKV>;
+    if constexpr (has_not_known<S>) assert(lhs != NOT_KNOWN);
+    return S::from_raw(Raw(int64_t(lhs.raw_value) + rhs.raw_value));
+}
+
+template <typename Unit, typename Raw, int32_t M, int32_t D, int32_t B, auto NKV>
+    requires(!std::is_same_v<Scalar<Unit, Raw, M, D, B, NKV>,
+            typename Scalar<Unit, Raw, M, D, B, NKV>::Delta>)  // else it's the `Delta - Delta` above
+constexpr auto operator-(Scalar<Unit, Raw, M, D, B, NKV> const& lhs,
+        typename Scalar<Unit, Raw, M, D, B, NKV>::Delta const& rhs) {
+    using S = Scalar<Unit, Raw, M, D, B, NKV>;
+    if constexpr (has_not_known<S>) assert(lhs != NOT_KNOWN);
+    return S::from_raw(Raw(int64_t(lhs.raw_value) - rhs.raw_value));
+}
+
+// Ratio of two deltas, e.g. how far into a range a reading is. One soft-float divide.
+template <typename Unit, int32_t M, int32_t D, int32_t B>
+constexpr double operator/(Scalar<Unit, int32_t, M, D, B, nullptr> const& lhs,
+        Scalar<Unit, int32_t, M, D, B, nullptr> const& rhs) {
+    return double(lhs.raw_value) / rhs.raw_value;
+}
+
+template <typename Unit, int32_t M, int32_t D, int32_t B>
+constexpr auto abs(Scalar<Unit, int32_t, M, D, B, nullptr> const& x) {
+    return Scalar<Unit, int32_t, M, D, B, nullptr>::from_raw(x.raw_value < 0 ? -x.raw_value : x.raw_value);
+}
+
 }  // namespace internal
 
 using internal::has_not_known;
@@ -278,6 +365,16 @@ BLE_DECL_SCALAR_OPTIONAL(Percentage16_10, uint16_t, 1, -2, 0, 0xFFFFu);  // rang
 
 constexpr Pressure PRESSURE_1_ATMOSPHERE{101.325 * 1000};  // 101.325 kPa
 
+static_assert(Temperature(21).raw_value == 2100 && Temperature(21.5).raw_value == 2150);
+static_assert(Temperature(-5) < 0 && 0 < Temperature(0.01) && Humidity(50) == 50.);
+static_assert(!(Temperature() < 0) && !(0 <= Temperature()), "not-known is unordered");
+static_assert(Percentage8(100).raw_value == 200, "non-decimal scales take the `double` path");
+static_assert((Humidity(40) - Humidity(45)).raw_value == -500, "deltas are signed");
+static_assert(Humidity(40) + (Humidity(45) - Humidity(40)) == Humidity(45) && Temperature(20) - 0.5 == 19.5);
+static_assert(abs(Temperature(20) - Temperature(21)) == 1 && Temperature::Delta(0.1) < 0.11);
+static_assert((Temperature(55) - Temperature(50)) / (Temperature(60) - Temperature(50)) == 0.5);
+static_assert(Pressure(101'325).scaled<1e2>() == 1013.25);
+
 //////////////////////////////////////////////
 // Common Utility Characteristics
 //////////////////////////////////////////////
@@ -12,6 +12,9 @@ using namespace std::literals::chrono_literals;
 constexpr auto BT_ADVERTISEMENT_INTERVAL_TICK = 625us;
 // Cannot advertise more frequently than every 100ms.
 constexpr auto BT_ADVERTISEMENT_INTERVAL_MIN = 100ms;
+// Connection parameters are specified in terms of ticks of 1.25 ms (interval) and 10 ms (supervision timeout)
+constexpr auto BT_CONNECTION_INTERVAL_TICK = 1250us;
+constexpr auto BT_CONNECTION_SUPERVISION_TIMEOUT_TICK = 10ms;
 
 template <typename Dur0, typename Dur1>
 void gap_advertisements_set_params(Dur0 const& advert_min, Dur1 const& advert_max) {
@@ -22,4 +25,13 @@ void gap_advertisements_set_params(Dur0 const& advert_min, Dur1 const& advert_ma
             advert_max / BT_ADVERTISEMENT_INTERVAL_TICK, 0, 0, null_addr, 0b0111, 0x00);
 }
 
+// NB: Only a request, the central is free to reject it or pick something else in range.
+template <typename Dur0, typename Dur1, typename Dur2>
+int gap_request_connection_parameter_update(hci_con_handle_t conn, Dur0 const& interval_min,
+        Dur1 const& interval_max, uint16_t latency, Dur2 const& supervision_timeout) {
+    return ::gap_request_connection_parameter_update(conn, interval_min / BT_CONNECTION_INTERVAL_TICK,
+            interval_max / BT_CONNECTION_INTERVAL_TICK, latency,
+            supervision_timeout / BT_CONNECTION_SUPERVISION_TIMEOUT_TICK);
+}
+
 }  // namespace nevermore
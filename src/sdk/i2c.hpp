@@ -4,9 +4,11 @@
 #include "semphr.h"    // IWYU pragma: keep [doesn't notice `SemaphoreHandle_t`]
 #include "utility/crc.hpp"
 #include "utility/scope_guard.hpp"
+#include "utility/semaphore.hpp"
 #include <cassert>
 #include <climits>
 #include <cstdarg>
+#include <cstdint>
 #include <cstdio>
 #include <optional>
 #include <type_traits>
@@ -37,7 +39,7 @@ constexpr bool i2c_address_reserved(uint8_t addr) {
 }
 
 struct I2C_Bus {  // NOLINT(cppcoreguidelines-special-member-functions)
-    I2C_Bus(SemaphoreHandle_t lock = xSemaphoreCreateMutex()) : lock(lock){};
+    I2C_Bus() : lock(lock_storage.mk_mutex()){};
     I2C_Bus(I2C_Bus const&) = delete;
     virtual ~I2C_Bus() {
         vSemaphoreDelete(lock);
@@ -51,6 +53,7 @@ struct I2C_Bus {  // NOLINT(cppcoreguidelines-special-member-functions)
     [[nodiscard]] bool write(char const* name, uint8_t addr, uint8_t const* src, size_t len) {
         assert(len <= INT_MAX && "success unrepresentable");
         auto _ = guard();
+        transactions_++;
         int r = write(addr, src, len);
         if (r < 0 || size_t(r) != len) {
             log_error(name, addr, "write failed; len=%d result=%d", len, r);
@@ -63,6 +66,7 @@ struct I2C_Bus {  // NOLINT(cppcoreguidelines-special-member-functions)
     [[nodiscard]] bool read(char const* name, uint8_t addr, uint8_t* dst, size_t len) {
         assert(len <= INT_MAX && "success unrepresentable");
         auto _ = guard();
+        transactions_++;
         int r = read(addr, dst, len);
         if (r < 0 || size_t(r) != len) {
             log_error(name, addr, "read failed; len=%d result=%d", len, r);
@@ -133,6 +137,11 @@ struct I2C_Bus {  // NOLINT(cppcoreguidelines-special-member-functions)
 
     [[nodiscard]] virtual const char* name() const = 0;
 
+    // # of reads/writes issued since boot, for diagnostics. Wraps.
+    [[nodiscard]] uint32_t transactions() const {
+        return transactions_;
+    }
+
 protected:
     // return # of bytes written, < 0 if error
     [[nodiscard]] virtual int write(uint8_t addr, uint8_t const* src, size_t len) = 0;
@@ -140,7 +149,9 @@ protected:
     [[nodiscard]] virtual int read(uint8_t addr, uint8_t* dst, size_t len) = 0;
 
 private:
+    [[no_unique_address]] SemaphoreStorage lock_storage;
     SemaphoreHandle_t lock;
+    uint32_t transactions_ = 0;  // guarded by `lock`
 };
 
 }  // namespace nevermore
@@ -1,32 +1,247 @@
 #include "i2c_pio.hpp"
 #include "config.hpp"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
 #include "hardware/pio.h"
+#include "hardware/timer.h"
 #include "lib/pio_i2c.h"
+#include "pico/error.h"
 #include "pio_i2c.pio.h"
 #include "sdk/i2c.hpp"
+#include "task.h"  // IWYU pragma: keep [xTaskGetSchedulerState]
 #include "utility/format.hpp"
+#include "utility/scope_guard.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <optional>
+
+using namespace std;
 
 namespace nevermore {
 
+namespace {
+
+// `pio0` hosts the WS2812 driver, keep the I2C SMs off of it so they can all share one program load.
+auto* const I2C_PIO_BLOCK = pio1;  // NOLINT
+
+// NB: DMA_IRQ_0 is shared by the display & WS2812 drivers, which expect it to be quiet.
+constexpr auto I2C_PIO_DMA_IRQ = DMA_IRQ_1;
+
+struct Entry {
+    GPIO pin_sda;
+    optional<I2C_PIO> bus;
+};
+
+array<Entry, Pins::BusI2C::PIO_MAX> g_buses;
+
+array<optional<uint>, NUM_PIOS> g_program_offset;
+array<bool, NUM_PIOS> g_pio_isr_installed{};
+bool g_dma_isr_installed = false;
+
+// NB: Only written by `isr_dma` & `isr_pio`. Same core & priority, they don't nest.
+volatile uint32_t g_isr_us = 0;
+
+uint program_offset(PIO pio) {
+    auto& offset = g_program_offset.at(pio_get_index(pio));
+    if (!offset) offset = pio_add_program(pio, &i2c_program);
+    return *offset;
+}
+
+pio_interrupt_source pio_nak_source(uint sm) {
+    return pio_interrupt_source(uint(pis_interrupt0) + sm);
+}
+
+}  // namespace
+
 I2C_PIO::I2C_PIO(PIO pio, uint32_t baud_rate, GPIO pin_sda, GPIO pin_scl)
         : I2C_PIO(pio, baud_rate, pio_claim_unused_sm(pio, true), pin_sda, pin_scl) {}
 
 I2C_PIO::I2C_PIO(PIO pio, uint32_t baud_rate, uint sm, GPIO pin_sda, GPIO pin_scl)
-        : pio(pio), sm(sm), _name(format_string("PIO-%02d/%02d", pin_sda.gpio, pin_scl.gpio)) {
-    uint offset = pio_add_program(pio, &i2c_program);
-    i2c_program_init(baud_rate, pio, sm, offset, pin_sda, pin_scl);
+        : pio(pio), sm(sm), dma_tx(dma_claim_unused_channel(true)), dma_rx(dma_claim_unused_channel(true)),
+          done(done_storage.mk_binary()), _name(format_string("PIO-%02d/%02d", pin_sda.gpio, pin_scl.gpio)) {
+    i2c_program_init(baud_rate, pio, sm, program_offset(pio), pin_sda, pin_scl);
+
+    // NB: 16-bit TX writes, same as `pio_i2c_put16`, so the entry is immediately available in the OSR.
+    auto tx = dma_channel_get_default_config(dma_tx);
+    channel_config_set_transfer_data_size(&tx, DMA_SIZE_16);
+    channel_config_set_read_increment(&tx, true);
+    channel_config_set_write_increment(&tx, false);
+    channel_config_set_dreq(&tx, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(dma_tx, &tx, &pio->txf[sm], nullptr, 0, false);
+
+    // RX is left-shifted w/ 8-bit autopush, the byte is in the low lane.
+    auto rx = dma_channel_get_default_config(dma_rx);
+    channel_config_set_transfer_data_size(&rx, DMA_SIZE_8);
+    channel_config_set_read_increment(&rx, false);
+    channel_config_set_write_increment(&rx, true);
+    channel_config_set_dreq(&rx, pio_get_dreq(pio, sm, false));
+    dma_channel_configure(dma_rx, &rx, nullptr, &pio->rxf[sm], 0, false);
+
+    if (!g_dma_isr_installed) {
+        g_dma_isr_installed = true;
+        irq_add_shared_handler(I2C_PIO_DMA_IRQ, isr_dma, PICO_DEFAULT_IRQ_PRIORITY);
+        irq_set_enabled(I2C_PIO_DMA_IRQ, true);
+    }
+    dma_channel_set_irq1_enabled(dma_rx, true);
+
+    if (!g_pio_isr_installed.at(pio_get_index(pio))) {
+        g_pio_isr_installed.at(pio_get_index(pio)) = true;
+        auto irq = pio_get_index(pio) == 0 ? PIO0_IRQ_0 : PIO1_IRQ_0;
+        irq_add_shared_handler(irq, isr_pio, PICO_DEFAULT_IRQ_PRIORITY);
+        irq_set_enabled(irq, true);
+    }
+}
+
+I2C_PIO::~I2C_PIO() {
+    dma_channel_set_irq1_enabled(dma_rx, false);
+    pio_set_irq0_source_enabled(pio, pio_nak_source(sm), false);
+    dma_channel_unclaim(dma_tx);
+    dma_channel_unclaim(dma_rx);
+    vSemaphoreDelete(done);
 }
 
 int I2C_PIO::write(uint8_t addr, uint8_t const* src, size_t len) {
-    return pio_i2c_write_timeout_us(pio, sm, addr, src, len, I2C_TIMEOUT_US);
+    if (DMA_TRANSFER_MAX < len || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+        return polled([&] { return pio_i2c_write_timeout_us(pio, sm, addr, src, len, I2C_TIMEOUT_US); });
+
+    return transfer(addr, src, nullptr, len);
 }
 
 int I2C_PIO::read(uint8_t addr, uint8_t* dst, size_t len) {
-    return pio_i2c_read_timeout_us(pio, sm, addr, dst, len, I2C_TIMEOUT_US);
+    if (DMA_TRANSFER_MAX < len || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+        return polled([&] { return pio_i2c_read_timeout_us(pio, sm, addr, dst, len, I2C_TIMEOUT_US); });
+
+    return transfer(addr, nullptr, dst, len);
+}
+
+// INVARIANT: caller holds the bus lock
+template <typename F>
+int I2C_PIO::polled(F&& go) {
+    auto begin = time_us_32();
+    int r = go();
+    stats.polled++;
+    stats.polled_cpu_us += time_us_32() - begin;
+    return r;
+}
+
+// INVARIANT: caller holds the bus lock, the staging buffers are per-bus
+int I2C_PIO::transfer(uint8_t addr, uint8_t const* src, uint8_t* dst, size_t len) {
+    assert(len <= DMA_TRANSFER_MAX);
+    auto begin = time_us_32();
+    uint32_t blocked_us = 0;
+    SCOPE_GUARD {
+        stats.dma++;
+        stats.dma_cpu_us += time_us_32() - begin - blocked_us;
+    };
+
+    auto n_words = pio_i2c_encode(tx_words.data(), addr, src, len);
+
+    pio_i2c_prepare(pio, sm);
+    xSemaphoreTake(done, 0);  // clear any stale give
+
+    // Every clocked byte pushes an RX entry -> RX completing means the whole transaction went out.
+    // A NAK stalls the SM (and so both channels) on its IRQ flag instead, which `isr_pio` picks up.
+    dma_channel_transfer_to_buffer_now(dma_rx, rx_bytes.data(), len + 1);
+    pio_set_irq0_source_enabled(pio, pio_nak_source(sm), true);
+    dma_channel_transfer_from_buffer_now(dma_tx, tx_words.data(), n_words);
+
+    auto blocked = time_us_32();
+    bool completed = xSemaphoreTake(done, pdMS_TO_TICKS(I2C_TIMEOUT_US / 1000));
+    blocked_us = time_us_32() - blocked;
+
+    // at most the STOP is left, ~1 bit time
+    int err = completed ? pio_i2c_wait_done(pio, sm) : PICO_ERROR_TIMEOUT;
+
+    pio_set_irq0_source_enabled(pio, pio_nak_source(sm), false);
+
+    if (err) {
+        // NB: RP2040-E13: aborting can raise a spurious completion IRQ, mask it for the duration.
+        dma_channel_set_irq1_enabled(dma_rx, false);
+        dma_channel_abort(dma_tx);
+        dma_channel_abort(dma_rx);
+        dma_channel_acknowledge_irq1(dma_rx);
+        dma_channel_set_irq1_enabled(dma_rx, true);
+
+        pio_i2c_abort(pio, sm);
+        return err;
+    }
+
+    if (dst) memcpy(dst, rx_bytes.data() + 1, len);  // skip the address echo
+    return int(len);
+}
+
+void I2C_PIO::isr_dma() {
+    auto begin = time_us_32();
+    BaseType_t woken = pdFALSE;
+    for (auto&& entry : g_buses) {
+        auto& bus = entry.bus;
+        if (!bus || !dma_channel_get_irq1_status(bus->dma_rx)) continue;
+
+        dma_channel_acknowledge_irq1(bus->dma_rx);
+        xSemaphoreGiveFromISR(bus->done, &woken);
+    }
+    g_isr_us = g_isr_us + (time_us_32() - begin);
+    portYIELD_FROM_ISR(woken);
+}
+
+void I2C_PIO::isr_pio() {
+    auto begin = time_us_32();
+    BaseType_t woken = pdFALSE;
+    for (auto&& entry : g_buses) {
+        auto& bus = entry.bus;
+        // NB: masked status, another bus' flag may be raised while it's recovering w/ its source off
+        if (!bus || !(bus->pio->ints0 & (1u << pio_nak_source(bus->sm)))) continue;
+
+        // NB: Leave the flag raised, `pio_i2c_wait_done` reports it & `pio_i2c_abort` clears it.
+        //     Mask the source instead so it doesn't keep firing.
+        pio_set_irq0_source_enabled(bus->pio, pio_nak_source(bus->sm), false);
+        xSemaphoreGiveFromISR(bus->done, &woken);
+    }
+    g_isr_us = g_isr_us + (time_us_32() - begin);
+    portYIELD_FROM_ISR(woken);
 }
 
 char const* I2C_PIO::name() const {
     return _name.c_str();
 }
 
+I2C_PIO* i2c_pio_find(GPIO pin_sda) {
+    for (auto&& entry : g_buses)
+        if (entry.bus && entry.pin_sda == pin_sda) return &*entry.bus;
+
+    return nullptr;
+}
+
+I2C_PIO& i2c_pio_add(uint32_t baud_rate, GPIO pin_sda, GPIO pin_scl) {
+    auto it = ranges::find_if(g_buses, [](auto&& entry) { return !entry.bus; });
+    assert(it != g_buses.end() && "`Pins::validate_or_throw` should've capped the # of PIO buses");
+
+    it->pin_sda = pin_sda;
+    return it->bus.emplace(I2C_PIO_BLOCK, baud_rate, pin_sda, pin_scl);
+}
+
+uint32_t i2c_pio_transactions() {
+    uint32_t n = 0;
+    for (auto&& entry : g_buses)
+        if (entry.bus) n += entry.bus->transactions();
+
+    return n;
+}
+
+// NB: Unlocked, a read racing a transaction may be off by one.
+I2C_PIO_Stats i2c_pio_stats() {
+    I2C_PIO_Stats total{.dma_cpu_us = g_isr_us};
+    for (auto&& entry : g_buses) {
+        if (!entry.bus) continue;
+
+        auto& x = entry.bus->stats;
+        total.polled += x.polled;
+        total.polled_cpu_us += x.polled_cpu_us;
+        total.dma += x.dma;
+        total.dma_cpu_us += x.dma_cpu_us;
+    }
+    return total;
+}
+
 }  // namespace nevermore
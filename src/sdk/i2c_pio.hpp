@@ -3,13 +3,33 @@
 #include "config/pins.hpp"
 #include "hardware/pio.h"
 #include "i2c.hpp"
+#include "utility/semaphore.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace nevermore {
 
+// Per path totals, for diagnostics. Wrap.
+// `*_cpu_us` is core time spent on them: all of it when polled, only encoding, setup, teardown & the ISRs
+// w/ DMA (the task is blocked in between). Includes any preemption, so an upper bound.
+struct I2C_PIO_Stats {
+    uint32_t polled = 0;
+    uint32_t polled_cpu_us = 0;
+    uint32_t dma = 0;
+    uint32_t dma_cpu_us = 0;
+};
+
+// Transactions are fed to/from the SM by DMA, the calling task blocks until they complete (or NAK).
+// Transactions too large for the staging buffers fall back to polling the FIFOs.
 struct I2C_PIO final : I2C_Bus {  // NOLINT(cppcoreguidelines-special-member-functions)
+    // Covers every sensor transaction in the tree, the largest is the BME68x's 51 byte field dump.
+    static constexpr size_t DMA_TRANSFER_MAX = 64;
+
     I2C_PIO(PIO, uint32_t baud_rate, GPIO pin_sda, GPIO pin_scl);
     I2C_PIO(PIO, uint32_t baud_rate, uint sm, GPIO pin_sda, GPIO pin_scl);
+    ~I2C_PIO() override;
 
     [[nodiscard]] char const* name() const override;
 
@@ -18,9 +38,35 @@ protected:
     [[nodiscard]] int read(uint8_t addr, uint8_t* dst, size_t len) override;
 
 private:
+    [[nodiscard]] int transfer(uint8_t addr, uint8_t const* src, uint8_t* dst, size_t len);
+    template <typename F>
+    [[nodiscard]] int polled(F&& go);
+
+    static void isr_dma();
+    static void isr_pio();
+
     PIO pio;
     uint sm;
+    uint dma_tx;
+    uint dma_rx;
+    [[no_unique_address]] SemaphoreStorage done_storage;
+    SemaphoreHandle_t done;  // given by the ISRs on RX complete or NAK
+    std::array<uint16_t, DMA_TRANSFER_MAX + 8> tx_words{};
+    std::array<uint8_t, DMA_TRANSFER_MAX + 1> rx_bytes{};  // +1 for the address echo
     std::string _name;
+    I2C_PIO_Stats stats;  // guarded by `lock`, excl. ISR time (see `i2c_pio_stats`)
+
+    friend I2C_PIO_Stats i2c_pio_stats();
 };
 
+// PIO buses bound by `Pins::apply`, all on `pio1` (`pio0` drives the WS2812s).
+// Returns `nullptr` if there's no PIO bus w/ that data pin.
+I2C_PIO* i2c_pio_find(GPIO pin_sda);
+I2C_PIO& i2c_pio_add(uint32_t baud_rate, GPIO pin_sda, GPIO pin_scl);
+
+// Total transactions across all PIO buses, for diagnostics. Wraps.
+uint32_t i2c_pio_transactions();
+// Across all PIO buses.
+I2C_PIO_Stats i2c_pio_stats();
+
 }  // namespace nevermore
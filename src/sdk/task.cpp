@@ -0,0 +1,48 @@
+#include "task.hpp"
+#include "pico/platform.h"
+#include "pico/time.h"
+
+using namespace std;
+using namespace std::literals::chrono_literals;
+
+namespace nevermore {
+
+namespace {
+
+// Shorter than this isn't worth blocking for, a context switch each way costs about as much.
+constexpr auto ALARM_WAIT_MIN = 50us;
+
+// Index 0 is used by drivers (e.g. CST816S's touch IRQ), keep out of their way.
+constexpr UBaseType_t NOTIFY_INDEX_DELAY = 1;
+static_assert(NOTIFY_INDEX_DELAY < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+
+int64_t alarm_fired(alarm_id_t, void* task) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveIndexedFromISR(static_cast<TaskHandle_t>(task), NOTIFY_INDEX_DELAY, &woken);
+    portYIELD_FROM_ISR(woken);
+    return 0;  // one-shot
+}
+
+}  // namespace
+
+void task_delay_alarm(chrono::microseconds delay) {
+    if (delay <= 0us) return;
+
+    if (delay < ALARM_WAIT_MIN || __get_current_exception() != 0 ||
+            xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+        busy_wait(delay);
+        return;
+    }
+
+    ulTaskNotifyTakeIndexed(NOTIFY_INDEX_DELAY, pdTRUE, 0);  // clear any stale give
+    auto id = add_alarm_in_us(delay / 1us, alarm_fired, xTaskGetCurrentTaskHandle(), false);
+    if (id == 0) return;  // already elapsed
+    if (id < 0) {         // out of alarm slots
+        busy_wait(delay);
+        return;
+    }
+
+    ulTaskNotifyTakeIndexed(NOTIFY_INDEX_DELAY, pdTRUE, portMAX_DELAY);
+}
+
+}  // namespace nevermore
@@ -10,6 +10,9 @@
 
 namespace nevermore {
 
+static_assert(1'000'000 % configTICK_RATE_HZ == 0, "tick period must be a whole # of microseconds");
+constexpr std::chrono::microseconds TICK_PERIOD{1'000'000 / configTICK_RATE_HZ};
+
 template <typename A, typename Ratio>
 consteval TickType_t to_ticks_safe(std::chrono::duration<A, Ratio> delay, bool allow_underflow = false) {
     using namespace std::literals::chrono_literals;
@@ -24,18 +27,24 @@ consteval TickType_t to_ticks_safe(std::chrono::duration<A, Ratio> delay, bool a
     return delay_ticks;
 }
 
+// Sub-tick delay. Blocks on a HW timer alarm instead of spinning, so the core can idle.
+// Busy waits if it's too short to be worth a context switch, or if we can't block (ISR, no scheduler).
+void task_delay_alarm(std::chrono::microseconds delay);
+
 template <typename A, typename Period>
 void task_delay(std::chrono::duration<A, Period> delay) {
     if (delay <= std::chrono::duration<A, Period>(0)) return;
 
-    auto delay_ms = std::chrono::duration_cast<std::chrono::duration<int64_t, std::milli>>(delay);
-    if (delay_ms.count() <= 0) {  // too small for task-delay -> busy wait instead
-        busy_wait(delay);
+    auto delay_us = std::chrono::ceil<std::chrono::microseconds>(delay);
+    if (delay_us < TICK_PERIOD) {
+        task_delay_alarm(delay_us);
         return;
     }
 
-    assert(delay_ms.count() <= std::numeric_limits<TickType_t>::max());
-    vTaskDelay(pdMS_TO_TICKS(delay_ms.count()));
+    // +1: `vTaskDelay(n)` wakes on the n-th tick boundary, i.e. after (n-1, n] ticks. Never return early.
+    auto ticks = (delay_us + TICK_PERIOD - std::chrono::microseconds(1)) / TICK_PERIOD + 1;
+    assert(ticks <= std::numeric_limits<TickType_t>::max());
+    vTaskDelay(TickType_t(ticks));
 }
 
 }  // namespace nevermore
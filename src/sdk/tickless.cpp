@@ -0,0 +1,101 @@
+#include "tickless.hpp"
+#include "FreeRTOS.h"  // IWYU pragma: keep
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "pico/platform.h"
+#include "sdk/task.hpp"
+#include "task.h"  // IWYU pragma: keep
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+using namespace std::literals::chrono_literals;
+
+namespace nevermore::tickless {
+
+namespace {
+
+// Bounds how long the other core can be left w/ a stale tick count, see `other_core_idle`.
+constexpr TickType_t SLEEP_TICKS_MAX = pdMS_TO_TICKS(100);
+static_assert(2 <= configEXPECTED_IDLE_TIME_BEFORE_SLEEP, "sleep math assumes at least 2 ticks");
+
+constexpr uint64_t TICK_US = TICK_PERIOD / 1us;
+
+// Only touched from the tick core w/ interrupts disabled.
+int g_alarm = -1;       // HW alarm we wake on, claimed lazily so its IRQ is enabled on the tick core
+uint64_t g_lag_us = 0;  // time owed to the tick count, see `suppress_ticks_and_sleep`
+Stats g_stats;
+
+// Only the tick core's SysTick advances the tick count. If the other core is running a task it'd see the
+// count stall while we sleep. Not bulletproof: an IRQ on the other core can still wake a task there
+// mid-sleep, which is why sleeps are capped at `SLEEP_TICKS_MAX`.
+bool other_core_idle() {
+    auto* other = xTaskGetCurrentTaskHandleCPU(1 - get_core_num());
+    auto const* idle = xTaskGetIdleTaskHandle();
+    return any_of(idle, idle + configNUM_CORES, [&](auto* x) { return x == other; });
+}
+
+void suppress_ticks_and_sleep(TickType_t expected_idle_ticks) {
+    if (get_core_num() != configTICK_CORE || !other_core_idle()) return;
+
+    if (g_alarm < 0) {
+        g_alarm = hardware_alarm_claim_unused(false);
+        if (g_alarm < 0) return;  // none free, keep ticking
+
+        hardware_alarm_set_callback(g_alarm, [](uint) {});  // only need the IRQ to wake `wfi`
+    }
+
+    auto const status = save_and_disable_interrupts();  // pending IRQs still wake `wfi`
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        restore_interrupts(status);
+        return;
+    }
+
+    systick_hw->csr &= ~M0PLUS_SYST_CSR_ENABLE_BITS;
+    auto const begin = time_us_64();
+    auto const cycles_per_us = clock_get_hz(clk_sys) / 1'000'000;
+    auto const since_tick_us = TICK_US - min<uint64_t>(TICK_US, systick_hw->cvr / cycles_per_us);
+
+    // Wake 1 tick short of the expected idle time, restarting SysTick provides the last one.
+    // Same as the FreeRTOS reference ports, means `vTaskStepTick` never overshoots the next unblock.
+    auto const ticks_max = min(expected_idle_ticks, SLEEP_TICKS_MAX);
+    auto const target = begin - since_tick_us + (ticks_max - 1) * TICK_US;
+    if (!hardware_alarm_set_target(g_alarm, from_us_since_boot(target))) {
+        __dsb();
+        __wfi();
+        __isb();
+    }
+    hardware_alarm_cancel(g_alarm);
+
+    // NB: Restarting SysTick begins a whole new tick period, dropping whatever fraction of one we slept.
+    //     Carry that over to the next sleep so the tick count doesn't drift behind wall time.
+    auto const slept_us = since_tick_us + (time_us_64() - begin) + g_lag_us;
+    auto const ticks = TickType_t(min<uint64_t>(slept_us / TICK_US, expected_idle_ticks - 1));
+    g_lag_us = slept_us - ticks * TICK_US;
+
+    systick_hw->cvr = 0;  // any write clears it, next period starts from the reload value
+    systick_hw->csr |= M0PLUS_SYST_CSR_ENABLE_BITS;
+    if (ticks) vTaskStepTick(ticks);
+
+    g_stats.sleeps++;
+    g_stats.ticks_slept += ticks;
+    restore_interrupts(status);
+}
+
+}  // namespace
+
+Stats stats() {
+    return g_stats;
+}
+
+void tick_hook() {
+    g_stats.tick_interrupts++;
+}
+
+}  // namespace nevermore::tickless
+
+extern "C" void nevermore_suppress_ticks_and_sleep(TickType_t expected_idle_ticks) {
+    nevermore::tickless::suppress_ticks_and_sleep(expected_idle_ticks);
+}
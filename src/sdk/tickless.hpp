@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nevermore::tickless {
+
+// Counters since boot, for checking we're actually idling.
+struct Stats {
+    uint32_t tick_interrupts = 0;  // ticks actually taken (skipped ones aren't counted)
+    uint32_t sleeps = 0;           // # of times the tick was suppressed
+    uint32_t ticks_slept = 0;      // ticks skipped while suppressed
+};
+
+Stats stats();
+
+// Call from `vApplicationTickHook`.
+void tick_hook();
+
+}  // namespace nevermore::tickless
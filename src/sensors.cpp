@@ -14,33 +14,90 @@
 #include "sensors/htu2xd.hpp"
 #include "sensors/sgp30.hpp"
 #include "sensors/sgp40.hpp"
+#include "sensors/sgp41.hpp"
+#include "semphr.h"  // IWYU pragma: keep
+#include "settings.hpp"
+#include "task.h"  // IWYU pragma: keep [taskENTER_CRITICAL]
+#include "utility/boot_timeline.hpp"
+#include "utility/semaphore.hpp"
+#include "utility/sensor_topology.hpp"
+#include "utility/static_vector.hpp"
+#include "utility/task.hpp"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstdio>
+#include <span>
 #include <vector>
 
 using namespace std;
 
 namespace nevermore::sensors {
 
-Sensors g_sensors;
-Config g_config;
-
 namespace {
 
 constexpr uint32_t ADC_CHANNEL_TEMP_SENSOR = 4;
 
-constexpr auto SENSOR_POWER_ON_DELAY = max({
-        AHTxx_POWER_ON_DELAY,
-        BME280_POWER_ON_DELAY,
-        BME68x_POWER_ON_DELAY,
-        BMP280_POWER_ON_DELAY,
-        ENS16x_POWER_ON_DELAY,
-        HTU21D_POWER_ON_DELAY,
-        SGP30_POWER_ON_DELAY,
-        SGP40_POWER_ON_DELAY,
-});
+constexpr uint32_t PROBE_STACK_DEPTH = 512;
+
+// NB: Only bumped w/in a critical section, the M0+ has no atomic RMW.
+atomic<uint32_t> g_revision = 0;
+
+// Double buffered so a recompute doesn't rewrite the snapshot a reader is still looking at.
+struct FallbacksCache {
+    array<Sensors, 2> slots;
+    atomic<uint8_t> current = 0;
+    atomic<uint32_t> generation = 0;           // bumped on every flip of `current`, see `with_fallbacks`
+    atomic<uint32_t> revision = ~uint32_t(0);  // of `slots[current]`
+    atomic<bool> updating = false;             // claimed w/in a critical section
+};
 
+FallbacksCache g_fallbacks;
+
+#if NEVERMORE_STATIC_ALLOCATION
+using VecSensors = StaticVector<unique_ptr<Sensor>, SENSOR_POOL_CAPACITY>;
+#else
 using VecSensors = vector<unique_ptr<Sensor>>;
+#endif
+
+using Drivers = SensorTopology::Drivers;
+
+struct Probe {
+    unique_ptr<SensorPeriodic> (*mk)(I2C_Bus&, EnvironmentalFilter);
+    chrono::microseconds power_on_delay;
+    SensorDriver driver;
+    // Probes w/ the same non-zero group share addresses. Probing one may reset another's device.
+    uint8_t address_group = 0;
+    // Skipped if any of these were found on the lane, e.g. the same device would answer both probes.
+    Drivers excludes = 0;
+};
+
+constexpr uint8_t ADDRESS_GROUP_BOSCH = 1;
+constexpr uint8_t ADDRESS_GROUP_SENSIRION = 2;
+
+// Probes are split into lanes which run concurrently, I2C transactions are serialised by the bus lock.
+// A lane's devices must not share addresses with another lane's (e.g. BME280/BME68x/BMP280 must share one).
+// Lanes are sorted by power-on delay so a slow device doesn't hold up probing the rest.
+// VOC sensors get their own lane b/c their self-tests (SGP4x 320 ms, SGP30 220 ms) leave the bus idle.
+// SGP41 goes before SGP40, an SGP41 also passes the SGP40 probe.
+constexpr array PROBES_ENVIRONMENTAL{
+        Probe{bme280, BME280_POWER_ON_DELAY, SensorDriver::BME280, ADDRESS_GROUP_BOSCH},
+        Probe{bmp280, BMP280_POWER_ON_DELAY, SensorDriver::BMP280, ADDRESS_GROUP_BOSCH},
+        Probe{bme68x, BME68x_POWER_ON_DELAY, SensorDriver::BME68x, ADDRESS_GROUP_BOSCH},
+        Probe{htu2xd, HTU21D_POWER_ON_DELAY, SensorDriver::HTU2xD},
+        Probe{ahtxx, AHTxx_POWER_ON_DELAY, SensorDriver::AHTxx},
+};
+constexpr array PROBES_VOC{
+        Probe{sgp41, SGP41_POWER_ON_DELAY, SensorDriver::SGP41, ADDRESS_GROUP_SENSIRION},
+        Probe{sgp40, SGP40_POWER_ON_DELAY, SensorDriver::SGP40, ADDRESS_GROUP_SENSIRION,
+                SensorTopology::bit(SensorDriver::SGP41)},
+        Probe{ens16x, ENS16x_POWER_ON_DELAY, SensorDriver::ENS16x},
+        Probe{sgp30, SGP30_POWER_ON_DELAY, SensorDriver::SGP30},
+};
+static_assert(ranges::is_sorted(PROBES_ENVIRONMENTAL, {}, &Probe::power_on_delay));
+static_assert(ranges::is_sorted(PROBES_VOC, {}, &Probe::power_on_delay));
 
 VecSensors g_sensor_devices;
 
@@ -49,8 +106,20 @@ struct McuTemperature final : SensorPeriodic {
         return "MCU Temperature";
     }
 
+    [[nodiscard]] chrono::milliseconds update_period() const override {
+        return pacing.period;
+    }
+
     void read() override {
-        nevermore::sensors::g_sensors.temperature_mcu = measure();
+        BLE::Temperature temperature = measure();
+        auto before = g_sensors.temperature_mcu;
+        changed = before == BLE::NOT_KNOWN || STABLE_DELTA_TEMPERATURE <= abs(temperature - before);
+        g_sensors.temperature_mcu = temperature;
+        touch();
+    }
+
+    void read_done() override {
+        pacing.update(changed);
     }
 
 private:
@@ -69,35 +138,149 @@ private:
         auto deg_c = 27 - (reading - 0.706) / 0.001721;
         return deg_c;
     }
+
+    AdaptivePeriod pacing;
+    bool changed = false;
 } g_mcu_temperature_sensor;
 
-VecSensors sensors_init_bus(I2C_Bus& bus, optional<EnvironmentalFilter::Kind> state) {
-    printf("%s - initializing sensors...\n", bus.name());
+// Sensors are assumed to have been powered up when we started probing.
+chrono::steady_clock::time_point g_power_on;
 
-    VecSensors sensors;
-    auto add = [&](auto p) {
-        if (!p) return;
-        printf("Found %s\n", p->name());
+void delay_until(chrono::steady_clock::time_point deadline) {
+    task_delay(deadline - chrono::steady_clock::now());
+}
+
+struct Lane {
+    I2C_Bus* bus = nullptr;
+    GPIO data;  // identifies the bus in `SensorTopology`
+    optional<Zone> zone;
+    span<Probe const> probes;
+    Drivers skip = 0;
+    bool cached = false;  // only probing drivers which found something last boot
+    bool touch_screen = false;
+
+    SemaphoreStorage done_storage;
+    SemaphoreHandle_t done = nullptr;
+    VecSensors found;  // NB: only touched by the lane's task until `done` is given
+    Drivers found_drivers = 0;
+
+    bool add(I2C_Bus& bus, unique_ptr<SensorPeriodic> p, chrono::microseconds power_on_delay) {
+        if (!p) return false;
+
+        boot_timeline("%s - found %s", bus.name(), p->name());
+        // probing might be implemented by sending a reset command to the sensor
+        delay_until(chrono::steady_clock::now() + power_on_delay);
         p->start();
-        sensors.push_back(std::move(p));
-    };
+        found.push_back(std::move(p));
+        return true;
+    }
+
+    void run() {
+        if (zone) {
+            for (auto&& probe : probes) {
+                if (skip & SensorTopology::bit(probe.driver)) continue;
+                if (probe.excludes & found_drivers) continue;
+
+                delay_until(g_power_on + probe.power_on_delay);
+                if (add(*bus, probe.mk(*bus, *zone), probe.power_on_delay))
+                    found_drivers |= SensorTopology::bit(probe.driver);
+            }
+        }
 
-    if (state) {
-        auto add_env = [&](auto&& fn) { add(fn(bus, *state)); };
-        add_env(ahtxx);
-        add_env(bme280);
-        add_env(bme68x);
-        add_env(bmp280);
-        add_env(ens16x);
-        add_env(htu2xd);
-        add_env(sgp30);
-        add_env(sgp40);
+        if (touch_screen) add(*bus, CST816S::mk(*bus), {});
     }
 
-    add(CST816S::mk(bus));
+    // Found drivers + any that would collide w/ them (e.g. probing for a BME68x soft-resets a BME280).
+    [[nodiscard]] Drivers claimed() const {
+        Drivers xs = found_drivers;
+        for (auto&& a : probes) {
+            if (!(found_drivers & SensorTopology::bit(a.driver)) || !a.address_group) continue;
 
-    if (sensors.empty()) printf("!! No sensors found?\n");
-    return sensors;
+            for (auto&& b : probes)
+                if (a.address_group == b.address_group) xs |= SensorTopology::bit(b.driver);
+        }
+        return xs;
+    }
+};
+
+// environmental (+ touch screen), VOC
+constexpr size_t LANES_PER_BUS = 2;
+constexpr size_t LANES_MAX = LANES_PER_BUS * (tuple_size_v<decltype(i2c)> + Pins::BusI2C::PIO_MAX);
+array<Lane, LANES_MAX> g_lanes;
+// NB: separate from `Lane` to keep big temporaries off the stack when (re)initialising a lane
+array<TaskStorage<PROBE_STACK_DEPTH>, LANES_MAX> g_lane_tasks;
+size_t g_lanes_used = 0;
+
+TaskStorage<PROBE_STACK_DEPTH> g_reprobe_task_storage;
+
+size_t sensors_probe_start(
+        I2C_Bus& bus, optional<Zone> zone, GPIO data, size_t lane_idx) {
+    // Sensors don't get swapped out often. Only probe for what we found last time, the rest is re-probed
+    // in the background once we're up and running.
+    auto const* cached = zone ? settings::g_active.sensor_topology.find(data) : nullptr;
+    if (cached)
+        boot_timeline("%s - probing sensors (cached: 0x%04x)...", bus.name(), unsigned(cached->drivers));
+    else
+        boot_timeline("%s - probing sensors...", bus.name());
+
+    auto start = [&](span<Probe const> probes, bool touch_screen) {
+        auto& task_storage = g_lane_tasks.at(lane_idx);
+        auto& lane = g_lanes.at(lane_idx++);
+        lane = {.bus = &bus,
+                .data = data,
+                .zone = zone,
+                .probes = probes,
+                .skip = Drivers(cached ? ~cached->drivers : 0),
+                .cached = !!cached,
+                .touch_screen = touch_screen};
+        lane.done = lane.done_storage.mk_binary();
+        assert(lane.done);
+
+        Task(
+                [](void* lane_) {
+                    auto& lane = *static_cast<Lane*>(lane_);
+                    lane.run();
+                    xSemaphoreGive(lane.done);
+                    vTaskDelete(nullptr);
+                },
+                &lane, "sensor-probe", task_storage, Priority::Startup)
+                .release();
+    };
+    start(PROBES_ENVIRONMENTAL, true);
+    start(PROBES_VOC, false);
+    static_assert(LANES_PER_BUS == 2);
+
+    return lane_idx;
+}
+
+// Probe for whatever the cached lanes skipped, in case sensors were added or swapped since last boot.
+void sensors_reprobe_task(void*) {
+    size_t found = 0;
+    for (size_t i = 0; i < g_lanes_used; i += LANES_PER_BUS) {
+        auto lanes = span(g_lanes).subspan(i, LANES_PER_BUS);
+        if (!lanes[0].cached) continue;
+
+        Drivers drivers = 0;
+        for (auto& lane : lanes) {
+            lane.skip = lane.claimed();
+            lane.touch_screen = false;
+            lane.run();
+            drivers |= lane.found_drivers;
+        }
+
+        vTaskSuspendAll();
+        for (auto& lane : lanes) {
+            found += lane.found.size();
+            std::move(begin(lane.found), end(lane.found), back_inserter(g_sensor_devices));
+            lane.found = {};
+        }
+        xTaskResumeAll();
+
+        settings::g_active.sensor_topology.set(lanes[0].data, drivers);
+    }
+
+    printf("sensors - background re-probe done, %u new found\n", unsigned(found));
+    vTaskDelete(nullptr);
 }
 
 template <typename F>
@@ -105,42 +288,64 @@ void foreach_sensor_bus(F&& go) {
     for (auto const& bus_pins : Pins::active().i2c) {
         if (!bus_pins) continue;
 
-        optional<EnvironmentalFilter::Kind> kind;
+        optional<Zone> zone;
         switch (bus_pins.kind) {
-        default: break;
-        case Pins::BusI2C::Kind::intake: kind = EnvironmentalFilter::Kind::Intake; break;
-        case Pins::BusI2C::Kind::exhaust: kind = EnvironmentalFilter::Kind::Exhaust; break;
+        case Pins::BusI2C::Kind::generic: break;
+        case Pins::BusI2C::Kind::intake: zone = Zone::Intake; break;
+        case Pins::BusI2C::Kind::exhaust: zone = Zone::Exhaust; break;
+        case Pins::BusI2C::Kind::chamber: zone = Zone::Chamber; break;
+        case Pins::BusI2C::Kind::auxiliary: zone = Zone::Auxiliary; break;
         }
 
-        I2C_Bus* bus;
-        if (auto hw = bus_pins.hardware_bus_num()) {
-            assert(hw <= 1);
+        // NB: Check PIO first, a HW mappable bus is on PIO if another bus claimed its controller first.
+        I2C_Bus* bus = i2c_pio_find(bus_pins.data);
+        if (!bus) {
+            auto hw = bus_pins.hardware_bus_num();
+            assert(hw && hw <= 1);
             bus = &i2c.at(*hw);
-        } else {
-            assert(false && "PIO I2C not impl");
-            continue;
         }
 
-        go(*bus, kind);
+        go(*bus, zone, bus_pins.data);
     }
 }
 
 }  // namespace
 
-Sensors Sensors::with_fallbacks(Config const& config) const {
-    EnvironmentalFilter intake{EnvironmentalFilter::Kind::Intake};
-    EnvironmentalFilter exhaust{EnvironmentalFilter::Kind::Exhaust};
-    auto apply = [&]<typename A>(A& x, EnvironmentalFilter side) { x = side.get<A>(*this, config); };
-    Sensors sensors = *this;
-    apply(sensors.temperature_intake, intake);
-    apply(sensors.humidity_intake, intake);
-    apply(sensors.pressure_intake, intake);
-    apply(sensors.voc_index_intake, intake);
-    apply(sensors.temperature_exhaust, exhaust);
-    apply(sensors.humidity_exhaust, exhaust);
-    apply(sensors.pressure_exhaust, exhaust);
-    apply(sensors.voc_index_exhaust, exhaust);
-    return sensors;
+void touch() {
+    taskENTER_CRITICAL();
+    g_revision = g_revision + 1;
+    taskEXIT_CRITICAL();
+}
+
+Sensors with_fallbacks() {
+    auto& cache = g_fallbacks;
+    // NB: Read before computing, a `touch` racing the recompute leaves the cache stale instead of lost.
+    auto revision = g_revision.load();
+    if (cache.revision != revision) {
+        taskENTER_CRITICAL();
+        bool claimed = !cache.updating;
+        cache.updating = true;
+        taskEXIT_CRITICAL();
+
+        // Someone else is already recomputing, the current snapshot is at most one update behind.
+        if (claimed) {
+            auto next = uint8_t(1 - cache.current);
+            cache.slots.at(next) = g_sensors.with_fallbacks();
+            cache.current = next;
+            cache.generation = cache.generation + 1;  // NB: only the claimant writes it, no RMW needed
+            cache.revision = revision;
+            cache.updating = false;
+        }
+    }
+
+    // NB: Seqlock-style copy. Two recomputes during the copy would rewrite the slot being copied, so retry
+    //     if `current` flipped at all in the meantime. Recomputes are rare, this practically never loops.
+    for (;;) {
+        auto generation = cache.generation.load();
+        auto snapshot = cache.slots.at(cache.current);
+        atomic_thread_fence(memory_order_acquire);  // copy must complete before re-checking
+        if (generation == cache.generation) return snapshot;
+    }
 }
 
 bool init() {
@@ -152,20 +357,53 @@ bool init() {
     CST816S::reset_all();
     CST816S::register_isr();
 
-    printf("Waiting %u ms for sensor init\n", unsigned(SENSOR_POWER_ON_DELAY / 1ms));
-    task_delay(SENSOR_POWER_ON_DELAY);
+    g_power_on = chrono::steady_clock::now();
 
-    foreach_sensor_bus([](auto&& bus, auto&& kind) {
-        auto xs = sensors_init_bus(bus, kind);
-        std::move(begin(xs), end(xs), back_inserter(g_sensor_devices));
+    foreach_sensor_bus([&](auto&& bus, auto&& zone, GPIO data) {
+        if (zone) {
+            g_sensors.zones_used = max<uint8_t>(g_sensors.zones_used, uint8_t(*zone) + 1);
+            touch();
+        }
+
+        if (g_lanes.size() < g_lanes_used + LANES_PER_BUS) {
+            printf("WARN - %s - no probe lanes left, skipping\n", bus.name());
+            return;
+        }
+
+        g_lanes_used = sensors_probe_start(bus, zone, data, g_lanes_used);
     });
 
+    bool reprobe = false;
+    for (size_t i = 0; i < g_lanes_used; i += LANES_PER_BUS) {
+        Drivers drivers = 0;
+        for (auto& lane : span(g_lanes).subspan(i, LANES_PER_BUS)) {
+            xSemaphoreTake(lane.done, portMAX_DELAY);
+            vSemaphoreDelete(lane.done);
+            lane.done = nullptr;
+
+            std::move(begin(lane.found), end(lane.found), back_inserter(g_sensor_devices));
+            lane.found = {};
+            drivers |= lane.found_drivers;
+            reprobe |= lane.cached;
+        }
+
+        // NB: persisted by the periodic settings save
+        if (!settings::g_active.sensor_topology.set(g_lanes.at(i).data, drivers))
+            printf("WARN - sensors - no space to cache sensor topology\n");
+    }
+
+    if (g_sensor_devices.empty()) printf("!! No sensors found?\n");
+
     // honestly if we low on space or are getting fragmentation issues we might
     // as well just reserve a `sizeof(P*) * 32` block and call it a day.
     g_sensor_devices.shrink_to_fit();
 
-    // wait again b/c probing might be implemented by sending a reset command to the sensor
-    task_delay(SENSOR_POWER_ON_DELAY);
+    boot_timeline("sensors - probing done, %u found", unsigned(g_sensor_devices.size()));
+
+    if (reprobe) {
+        Task(sensors_reprobe_task, nullptr, "sensor-reprobe", g_reprobe_task_storage, Priority::Idle)
+                .release();
+    }
 
     return true;
 }
@@ -2,7 +2,10 @@
 
 #include "sdk/ble_data_types.hpp"
 #include "sensors/gas_index_ble.hpp"
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
 
 #define DBG_MEASURE_VOC_TEMPERATURE_HUMIDITY_EFFECT 0
 
@@ -10,6 +13,7 @@ namespace nevermore::sensors {
 
 BLE_DECL_SCALAR_OPTIONAL(VOCIndex, uint16_t, 1, 0, 0, 0);      // range [0, 500], 0 = not-known;
 BLE_DECL_SCALAR_OPTIONAL(VOCRaw, uint16_t, 1, 0, 0, 0xFFFFu);  // range [0, 2^16-2], 0xFFFF = not-known;
+BLE_DECL_SCALAR_OPTIONAL(NOxIndex, uint16_t, 1, 0, 0, 0);      // range [1, 500], 0 = not-known;
 
 #if DBG_MEASURE_VOC_TEMPERATURE_HUMIDITY_EFFECT
 
@@ -25,7 +29,7 @@ struct [[gnu::packed]] VOCRawBreakdown {
 #endif
 
 struct Config {
-    // If a sensor in a `FilterSide` is missing, then try to fall back to the other side's sensor.
+    // If a zone's sensor is missing, then try to fall back to another zone's sensor (see `zone_fallbacks`).
     bool fallback = false;
     // StealthMax MCU is positioned inside the exhaust airflow.
     // Disabled by default because not all Nevermores are StealthMaxes.
@@ -34,16 +38,91 @@ struct Config {
 
 extern Config g_config;
 
+// Intake & exhaust are the filter's two sides and always exist. The rest are optional extra sensor groups
+// (e.g. a chamber sensor away from the filter, or a second filter's intake).
+enum class Zone : uint8_t { Intake = 0, Exhaust = 1, Chamber = 2, Auxiliary = 3 };
+constexpr size_t ZONES_MAX = 4;
+constexpr size_t ZONES_MIN = 2;  // intake & exhaust
+
+// Fallback order for `zone`: the v0 intake <-> exhaust pairing first, then every other zone in order.
+constexpr std::array<Zone, ZONES_MAX - 1> zone_fallbacks(Zone zone) {
+    std::array<Zone, ZONES_MAX - 1> xs{};
+    size_t n = 0;
+    if (zone == Zone::Intake) xs.at(n++) = Zone::Exhaust;
+    if (zone == Zone::Exhaust) xs.at(n++) = Zone::Intake;
+    for (size_t i = 0; i < ZONES_MAX; ++i) {
+        auto z = Zone(i);
+        if (z == zone || (n != 0 && xs.at(0) == z)) continue;
+        xs.at(n++) = z;
+    }
+    return xs;
+}
+
+static_assert(zone_fallbacks(Zone::Intake) == std::array{Zone::Exhaust, Zone::Chamber, Zone::Auxiliary});
+static_assert(zone_fallbacks(Zone::Chamber) == std::array{Zone::Intake, Zone::Exhaust, Zone::Auxiliary});
+
+// A pair of zones to compare, e.g. for the fan policy's `intake - exhaust` improvement check.
+struct [[gnu::packed]] ZonePair {
+    Zone intake = Zone::Intake;    // air going into the filter
+    Zone exhaust = Zone::Exhaust;  // air coming out of it
+
+    [[nodiscard]] constexpr bool validate() const {
+        return size_t(intake) < ZONES_MAX && size_t(exhaust) < ZONES_MAX && intake != exhaust;
+    }
+
+    auto operator<=>(ZonePair const&) const = default;
+};
+
+struct [[gnu::packed]] ZoneReadings {
+    BLE::Temperature temperature;
+    BLE::Humidity humidity;
+    // Officially there's no not-known constant for pressure. We define an unofficial one in BLE data types.
+    BLE::Pressure pressure;
+    VOCIndex voc_index;
+    VOCRaw voc_raw;
+    GIAState gia;
+    NOxIndex nox_index;
+
+#if DBG_MEASURE_VOC_TEMPERATURE_HUMIDITY_EFFECT
+    VOCRawBreakdown voc_raw_breakdown;
+#endif
+
+    // Field by type, every field has a distinct type.
+    template <typename A>
+    [[nodiscard]] constexpr A& get() {
+#if DBG_MEASURE_VOC_TEMPERATURE_HUMIDITY_EFFECT
+        if constexpr (std::is_same_v<A, VOCRawBreakdown>) return voc_raw_breakdown;
+        else
+#endif
+        if constexpr (std::is_same_v<A, BLE::Temperature>) return temperature;
+        else if constexpr (std::is_same_v<A, BLE::Humidity>) return humidity;
+        else if constexpr (std::is_same_v<A, BLE::Pressure>) return pressure;
+        else if constexpr (std::is_same_v<A, VOCIndex>) return voc_index;
+        else if constexpr (std::is_same_v<A, VOCRaw>) return voc_raw;
+        else if constexpr (std::is_same_v<A, GIAState>) return gia;
+        else if constexpr (std::is_same_v<A, NOxIndex>) return nox_index;
+        else static_assert(sizeof(A) == 0, "not a zone reading");
+    }
+
+    template <typename A>
+    [[nodiscard]] constexpr A const& get() const {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        return const_cast<ZoneReadings&>(*this).get<A>();
+    }
+
+    auto operator<=>(ZoneReadings const&) const = default;
+};
+
+// v0 environmental aggregate, a fixed intake/exhaust view of `Sensors`. Kept for existing clients.
 // Requirements:
 // * Must match declared order of characteristics in environmental service
 // * Must be packed.
-struct [[gnu::packed]] Sensors {
+struct [[gnu::packed]] SensorsV0 {
     BLE::Temperature temperature_intake;
     BLE::Temperature temperature_exhaust;
     BLE::Temperature temperature_mcu;
     BLE::Humidity humidity_intake;
     BLE::Humidity humidity_exhaust;
-    // Officially there's no not-known constant for pressure. We define an unofficial one in BLE data types.
     BLE::Pressure pressure_intake;
     BLE::Pressure pressure_exhaust;
     VOCIndex voc_index_intake;
@@ -52,19 +131,49 @@ struct [[gnu::packed]] Sensors {
     VOCRaw voc_raw_exhaust;
     GIAState gia_intake;
     GIAState gia_exhaust;
+    NOxIndex nox_index_intake;
+    NOxIndex nox_index_exhaust;
 
 #if DBG_MEASURE_VOC_TEMPERATURE_HUMIDITY_EFFECT
     VOCRawBreakdown voc_raw_breakdown_intake;
     VOCRawBreakdown voc_raw_breakdown_exhaust;
 #endif
 
+    auto operator<=>(SensorsV0 const&) const = default;
+};
+
+struct Sensors {
+    std::array<ZoneReadings, ZONES_MAX> zones{};
+    BLE::Temperature temperature_mcu;
+    // # of zones in use, `[ZONES_MIN, ZONES_MAX]`. Set by `init`, 1 + the highest zone w/ a sensor bus.
+    uint8_t zones_used = ZONES_MIN;
+
+    [[nodiscard]] constexpr ZoneReadings& operator[](Zone zone) {
+        return zones.at(size_t(zone));
+    }
+
+    [[nodiscard]] constexpr ZoneReadings const& operator[](Zone zone) const {
+        return zones.at(size_t(zone));
+    }
+
+    [[nodiscard]] constexpr bool used(Zone zone) const {
+        return size_t(zone) < zones_used;
+    }
+
     [[nodiscard]] Sensors with_fallbacks(Config const& config = g_config) const;
+    [[nodiscard]] SensorsV0 v0() const;
 
     auto operator<=>(Sensors const&) const = default;
 };
 
 extern Sensors g_sensors;
 
+// Call after writing `g_sensors` or `g_config`, invalidates `with_fallbacks()`.
+void touch();
+// `g_sensors.with_fallbacks()`, only recomputed if `touch` was called since the last time.
+// By value, a consistent copy even if a recompute races the call.
+[[nodiscard]] Sensors with_fallbacks();
+
 // Sensors are registered as periodic workers for the context.
 bool init();
 void calibrations_reset();
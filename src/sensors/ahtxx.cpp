@@ -118,6 +118,8 @@ struct AHTxxSensor final : SensorPeriodicEnvI2C<Reg, "AHTxx"> {
 
 }  // namespace
 
+static_assert(sensor_pool_fits<AHTxxSensor>(), "grow `SENSOR_POOL_BLOCK_SIZE`");
+
 unique_ptr<SensorPeriodic> ahtxx(I2C_Bus& bus, EnvironmentalFilter side) {
     for (auto address : ADDRESSES)
         if (auto p = make_unique<AHTxxSensor>(bus, address, side); p->setup()) return p;
@@ -1,6 +1,14 @@
 #include "async_sensor.hpp"
+#include "pico.h"  // IWYU pragma: keep [panic]
+#include "utility/boot_timeline.hpp"
 #include "utility/task.hpp"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
 
 using namespace std;
@@ -9,8 +17,69 @@ namespace nevermore::sensors {
 
 namespace {
 
-constexpr uint32_t SENSOR_STACK_DEPTH = 256;
+atomic<SensorPeriodic::ReadListener> g_read_listener = nullptr;
+atomic<bool> g_hurry = false;
+SensorPeriodic::Stats g_stats;  // guarded by a critical section
 
+#if NEVERMORE_STATIC_ALLOCATION
+
+static_assert(sizeof(SensorPeriodic) < SENSOR_POOL_BLOCK_SIZE);
+
+using SensorPoolBlock = array<byte, SENSOR_POOL_BLOCK_SIZE>;
+
+alignas(max_align_t) array<SensorPoolBlock, SENSOR_POOL_CAPACITY> g_sensor_pool;
+uint32_t g_sensor_pool_used = 0;  // bitset, guarded by a critical section
+static_assert(SENSOR_POOL_CAPACITY <= 32);
+
+#endif
+
+}  // namespace
+
+#if NEVERMORE_STATIC_ALLOCATION
+
+void* Sensor::operator new(size_t size) {
+    if (SENSOR_POOL_BLOCK_SIZE < size)
+        panic("PANIC - sensor driver too large for pool, size=%u\n", unsigned(size));
+
+    taskENTER_CRITICAL();
+    auto i = size_t(countr_one(g_sensor_pool_used));
+    if (i < SENSOR_POOL_CAPACITY) g_sensor_pool_used |= 1u << i;
+    taskEXIT_CRITICAL();
+
+    if (SENSOR_POOL_CAPACITY <= i) panic("PANIC - sensor driver pool exhausted\n");
+    return g_sensor_pool.at(i).data();
+}
+
+void Sensor::operator delete(void* p) noexcept {
+    if (!p) return;
+
+    auto i = size_t(static_cast<SensorPoolBlock*>(p) - g_sensor_pool.data());
+    assert(i < SENSOR_POOL_CAPACITY);
+
+    taskENTER_CRITICAL();
+    g_sensor_pool_used &= ~(1u << i);
+    taskEXIT_CRITICAL();
+}
+
+#endif
+
+void SensorPeriodic::read_listener(ReadListener listener) {
+    g_read_listener = listener;
+}
+
+SensorPeriodic::Stats SensorPeriodic::stats() {
+    taskENTER_CRITICAL();
+    auto stats = g_stats;
+    taskEXIT_CRITICAL();
+    return stats;
+}
+
+void SensorPeriodic::hurry(bool hurry) {
+    g_hurry = hurry;
+}
+
+bool SensorPeriodic::hurry() {
+    return g_hurry;
 }
 
 void SensorPeriodic::start() {
@@ -20,15 +89,26 @@ void SensorPeriodic::start() {
     auto go = [](void* self_) {
         auto* self = reinterpret_cast<SensorPeriodic*>(self_);
         auto last_wake = xTaskGetTickCount();
-        for (;;) {
+        for (bool first = true;; first = false) {
             self->read();
+            self->read_done();
+            if (first) boot_timeline("%s - first read done", self->name());
+            if (auto listener = g_read_listener.load()) listener();
+
+            auto period = self->update_period();
+            taskENTER_CRITICAL();
+            g_stats.reads++;
+            if (SENSOR_UPDATE_PERIOD < period) g_stats.reads_deferred += period / SENSOR_UPDATE_PERIOD - 1;
+            taskEXIT_CRITICAL();
 
-            auto delay_ticks = pdMS_TO_TICKS(self->update_period() / 1ms);
-            xTaskDelayUntil(&last_wake, delay_ticks);
+            if (0ms < period)
+                xTaskDelayUntil(&last_wake, pdMS_TO_TICKS(period / 1ms));
+            else
+                last_wake = xTaskGetTickCount();
         }
     };
 
-    task = Task(go, this, name(), SENSOR_STACK_DEPTH, Priority::Sensors);
+    task = Task(go, this, name(), task_storage, Priority::Sensors);
 }
 
 void SensorPeriodic::stop() {
@@ -2,12 +2,44 @@
 
 #include "config.hpp"
 #include "utility/task.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 
 namespace nevermore::sensors {
 
+constexpr uint32_t SENSOR_STACK_DEPTH = 256;
+
+#if NEVERMORE_STATIC_ALLOCATION
+// Max # of drivers alive at once, including ones being probed (at most 1 per probe lane).
+// Bump these if you hit the panics in `Sensor::operator new`.
+constexpr size_t SENSOR_POOL_CAPACITY = 12;
+// Largest driver: SGP41, ~1.6 KiB (1 KiB stack + TCB + 2 GIA states). BME68x is next, ~1.5 KiB.
+constexpr size_t SENSOR_POOL_BLOCK_SIZE = 1792;
+#endif
+
+// Every driver asserts this next to its factory, an oversized driver fails the build instead of panicking
+// in `Sensor::operator new` at probe time.
+template <typename Driver>
+constexpr bool sensor_pool_fits() {
+#if NEVERMORE_STATIC_ALLOCATION
+    return sizeof(Driver) <= SENSOR_POOL_BLOCK_SIZE;
+#else
+    return true;
+#endif
+}
+
 struct Sensor {
     virtual ~Sensor() = default;
 
+#if NEVERMORE_STATIC_ALLOCATION
+    // Drivers are allocated from a fixed capacity pool instead of the heap.
+    // Probing creates & destroys drivers, a pool of fixed size blocks can't fragment.
+    static void* operator new(std::size_t);
+    static void operator delete(void*) noexcept;
+#endif
+
     [[nodiscard]] virtual char const* name() const = 0;
 
     virtual void calibration_reset() {};
@@ -18,10 +50,18 @@ struct Sensor {
 // Useful for sensors that take a long time (10ms+) to measure/respond.
 // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
 struct SensorPeriodic : Sensor {
+    using ReadListener = void (*)();
+
+    struct Stats {
+        uint32_t reads = 0;           // across all periodic sensors
+        uint32_t reads_deferred = 0;  // `SENSOR_UPDATE_PERIOD` reads skipped b/c a sensor backed off
+    };
+
     SensorPeriodic() = default;
     SensorPeriodic(SensorPeriodic const&) = delete;  // copying is almost certainly a mistake
     SensorPeriodic(SensorPeriodic&&) = delete;       // not safe to move b/c we're pinned once registered
 
+    // 0 -> no delay between reads, `read` paces itself (e.g. blocks on an IRQ)
     [[nodiscard]] virtual std::chrono::milliseconds update_period() const {
         return SENSOR_UPDATE_PERIOD;
     }
@@ -29,10 +69,46 @@ struct SensorPeriodic : Sensor {
     virtual void start();
     virtual void stop();
 
+    // Invoked from the sensor's own task after every `read`, i.e. concurrently. Must be cheap.
+    // Only one listener for now (fan policy), setting another replaces it.
+    static void read_listener(ReadListener);
+
+    static Stats stats();
+
+    // While set, adaptive sensors stay at their base period. e.g. the fan's running, things are changing.
+    static void hurry(bool);
+    [[nodiscard]] static bool hurry();
+
 protected:
     virtual void read() = 0;
+    // Invoked from the sensor's own task after every `read`, before `update_period`.
+    virtual void read_done() {}
+
+    // NOLINTBEGIN(cppcoreguidelines-non-private-member-variables-in-classes)
+    TaskStorage<SENSOR_STACK_DEPTH> task_storage;  // NB: declared before `task` so it outlives it
+    Task task;
+    // NOLINTEND(cppcoreguidelines-non-private-member-variables-in-classes)
+};
 
-    Task task;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+// Backs a sensor's update period off while its readings are stable.
+// Snaps back to the base period as soon as a reading changes or `SensorPeriodic::hurry` is set.
+struct AdaptivePeriod {
+    static constexpr uint8_t STABLE_READS_BEFORE_BACKOFF = 4;
+
+    std::chrono::milliseconds base = SENSOR_UPDATE_PERIOD;
+    std::chrono::milliseconds period = base;
+    uint8_t stable_reads = 0;
+
+    void update(bool changed) {
+        if (changed || SensorPeriodic::hurry()) {
+            period = base;
+            stable_reads = 0;
+        } else if (stable_reads < STABLE_READS_BEFORE_BACKOFF) {
+            stable_reads++;
+        } else {
+            period = std::min<std::chrono::milliseconds>(period * 2, SENSOR_UPDATE_PERIOD_STABLE_MAX);
+        }
+    }
 };
 
 }  // namespace nevermore::sensors
@@ -2,6 +2,7 @@
 #include "lib/bme280.h"
 #include "sdk/ble_data_types.hpp"
 #include "sdk/i2c.hpp"
+#include "sdk/task.hpp"
 #include "sensors/environmental_i2c.hpp"
 #include <chrono>
 #include <cstdint>
@@ -43,7 +44,8 @@ struct BME280 final : SensorPeriodicEnvI2C<Reg, "BME280"> {
             .intf_ptr = this,
             .read = i2c_read_,
             .write = i2c_write_,
-            .delay_us = [](uint32_t delay_us, void*) { busy_wait_us_32(delay_us); },
+            // yields, only spins for waits too short to be worth a context switch
+            .delay_us = [](uint32_t delay_us, void*) { task_delay(chrono::microseconds(delay_us)); },
     };
 
     BME280(BME280 const&) = delete;
@@ -106,6 +108,8 @@ struct BME280 final : SensorPeriodicEnvI2C<Reg, "BME280"> {
 
 }  // namespace
 
+static_assert(sensor_pool_fits<BME280>(), "grow `SENSOR_POOL_BLOCK_SIZE`");
+
 unique_ptr<SensorPeriodic> bme280(I2C_Bus& bus, EnvironmentalFilter side) {
     for (auto address : ADDRESSES)
         if (auto p = make_unique<BME280>(bus, address, side); p->setup()) return p;
@@ -2,9 +2,16 @@
 #include "lib/bme68x.h"
 #include "sdk/ble_data_types.hpp"
 #include "sdk/i2c.hpp"
+#include "sdk/task.hpp"
+#include "sensors.hpp"
 #include "sensors/environmental_i2c.hpp"
+#include "sensors/gas_index.hpp"
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
+#include <span>
 
 using namespace std;
 
@@ -20,7 +27,29 @@ constexpr uint8_t ADDRESSES[] = {
         0b0111'0111,
 };
 
-constexpr auto BME68x_MODE = BME68X_FORCED_MODE;
+// Parallel mode: the device cycles through `HEATER_PROFILE` on its own, measuring T/H/P & gas each step.
+// We only touch the bus to read the last 3 steps' results in one burst, heater time never holds the bus.
+// Once VOC is left to another sensor the heater is switched off & we fall back to forced mode, T/H/P only.
+constexpr auto BME68x_MODE = BME68X_PARALLEL_MODE;
+
+struct HeaterStep {
+    uint16_t temperature;  // c
+    uint16_t duration;     // multiple of the shared heater duration
+};
+
+// Preheat, then 2 steps at Bosch's recommended 320 c for air quality. Only the last one feeds `GasIndex`.
+// Kept to 3 steps b/c the device only buffers 3 results, & sized to cycle at about the GIA's 1 Hz.
+// FUTURE WORK: The other steps could feed a gas classifier.
+constexpr array<HeaterStep, 3> HEATER_PROFILE{{{200, 2}, {320, 2}, {320, 3}}};
+constexpr uint8_t HEATER_STEP_GAS_INDEX = HEATER_PROFILE.size() - 1;
+constexpr auto HEATER_CYCLE = 1s;
+
+// Maps gas resistance onto an SGP4x style raw signal for `GasIndex`.
+// SGP4x raw ticks track the log of the MOX resistance & GIA normalises the mean/variance itself,
+// so only the shape matters: 1000 ticks per doubling, offset to clear GIA's 20k floor from ~1 kOhm up.
+uint16_t gas_raw(double ohms) {
+    return uint16_t(clamp(11'000 + 1'000 * log2(max(ohms, 1.)), 0., 65'534.));
+}
 
 bme68x_conf BME68x_SETTINGS{
         .os_hum = BME68X_OS_1X,
@@ -45,7 +74,8 @@ struct BME68x final : SensorPeriodicEnvI2C<Reg, "BME68x"> {
             .intf = BME68X_I2C_INTF,
             .read = i2c_read_,
             .write = i2c_write_,
-            .delay_us = [](uint32_t delay_us, void*) { busy_wait_us_32(delay_us); },
+            // yields, only spins for waits too short to be worth a context switch
+            .delay_us = [](uint32_t delay_us, void*) { task_delay(chrono::microseconds(delay_us)); },
     };
 
     BME68x(BME68x const&) = delete;
@@ -67,10 +97,27 @@ struct BME68x final : SensorPeriodicEnvI2C<Reg, "BME68x"> {
             return false;
         }
 
-        // Disable the heater; we are not current using the device's gas sensor.
-        // (It doesn't detect the VOCs we're interested in, and we don't want to
-        //  override any attached SGP40s.)
-        bme68x_heatr_conf heater_cfg{.enable = false};
+        auto step_duration_sum = 0u;
+        for (auto&& step : HEATER_PROFILE)
+            step_duration_sum += step.duration;
+        auto meas_dur_ms = bme68x_get_meas_dur(BME68x_MODE, &BME68x_SETTINGS, &dev) / 1000;
+        auto shared_dur_ms = HEATER_CYCLE / 1ms / step_duration_sum;
+        assert(meas_dur_ms < shared_dur_ms && "heater profile too short for a T/H/P measurement");
+
+        array<uint16_t, HEATER_PROFILE.size()> temperatures;
+        array<uint16_t, HEATER_PROFILE.size()> durations;
+        for (size_t i = 0; i < HEATER_PROFILE.size(); ++i) {
+            temperatures[i] = HEATER_PROFILE[i].temperature;
+            durations[i] = HEATER_PROFILE[i].duration;
+        }
+
+        bme68x_heatr_conf heater_cfg{
+                .enable = BME68X_ENABLE,
+                .heatr_temp_prof = temperatures.data(),
+                .heatr_dur_prof = durations.data(),
+                .profile_len = uint8_t(HEATER_PROFILE.size()),
+                .shared_heatr_dur = uint16_t(shared_dur_ms - meas_dur_ms),
+        };
 
         if (auto r = bme68x_set_heatr_conf(BME68x_MODE, &heater_cfg, &dev); r != BME68X_OK) {
             i2c.log_error("failed to set device heater settings (code %+d)", r);
@@ -82,23 +129,104 @@ struct BME68x final : SensorPeriodicEnvI2C<Reg, "BME68x"> {
             return false;
         }
 
+        calibration_reset();
+        index.restore(side.voc_calibration_blob(), i2c);
         return true;
     }
 
+    void calibration_reset() override {
+        index = {GasIndexAlgorithm_ALGORITHM_TYPE_VOC};
+    }
+
+    void calibration_force_checkpoint() override {
+        index.checkpoint_clear();
+    }
+
+    // GIA is calibrated for a fixed sampling interval. Only back off once VOC is left to another sensor.
+    [[nodiscard]] chrono::milliseconds update_period() const override {
+        return voc_yielded ? SensorPeriodicEnvI2C::update_period() : SENSOR_UPDATE_PERIOD;
+    }
+
     void read() override {
-        bme68x_data comp_data{};
+        if (voc_yielded) {
+            read_forced();
+            return;
+        }
+
+        array<bme68x_data, 3> fields{};  // parallel mode always reads the 3 buffered results
+        uint8_t n_fields = 0;
+        if (auto r = bme68x_get_data(BME68x_MODE, fields.data(), &n_fields, &dev); r < 0) {
+            i2c.log_error("failed read (code %+d)", r);
+            return;
+        }
+        if (n_fields == 0) return;
+
+        for (auto&& field : span(fields).first(n_fields)) {
+            constexpr auto GAS_VALID = BME68X_GASM_VALID_MSK | BME68X_HEAT_STAB_MSK;
+            if (field.gas_index == HEATER_STEP_GAS_INDEX && (field.status & GAS_VALID) == GAS_VALID)
+                gas_process(field.gas_resistance);
+        }
+
+        publish(fields.at(n_fields - 1));
+    }
+
+    // Heater off: one T/H/P measurement per read, the device sleeps in between.
+    void read_forced() {
+        if (auto r = bme68x_set_op_mode(BME68X_FORCED_MODE, &dev); r != BME68X_OK) {
+            i2c.log_error("failed to start measurement (code %+d)", r);
+            return;
+        }
+
+        task_delay(chrono::microseconds(bme68x_get_meas_dur(BME68X_FORCED_MODE, &BME68x_SETTINGS, &dev)));
+
+        bme68x_data data{};
         uint8_t n_fields = 0;
-        if (auto r = bme68x_get_data(BME68x_MODE, &comp_data, &n_fields, &dev); r < 0) {
+        if (auto r = bme68x_get_data(BME68X_FORCED_MODE, &data, &n_fields, &dev); r < 0) {
             i2c.log_error("failed read (code %+d)", r);
             return;
         }
         if (n_fields == 0) return;
 
-        side.set(BLE::Temperature(comp_data.temperature));
-        side.set(BLE::Humidity(comp_data.humidity));
-        side.set(BLE::Pressure(comp_data.pressure));
+        publish(data);
     }
 
+    void publish(bme68x_data const& data) {
+        side.set(BLE::Temperature(data.temperature));
+        side.set(BLE::Humidity(data.humidity));
+        side.set(BLE::Pressure(data.pressure));
+    }
+
+    // Parallel mode keeps cycling the heater by itself. Left on it wastes power & self-heats the T/H
+    // readings we still publish. Also drops the device to sleep, `read_forced` wakes it per measurement.
+    void heater_off() {
+        bme68x_heatr_conf heater_cfg{.enable = BME68X_DISABLE};
+        if (auto r = bme68x_set_heatr_conf(BME68X_FORCED_MODE, &heater_cfg, &dev); r != BME68X_OK)
+            i2c.log_error("failed to disable the heater (code %+d)", r);
+    }
+
+    // Dedicated VOC sensors (SGP40, etc.) are much better at this. If one is writing this side's VOC,
+    // stop publishing instead of fighting over the slot.
+    void gas_process(double ohms) {
+        if (voc_yielded) return;
+        if (side.get<VOCRaw>(g_sensors, Config{}) != voc_raw_published) {
+            i2c.log("another VOC sensor is on this side, not publishing gas readings, heater off");
+            voc_yielded = true;
+            heater_off();
+            return;
+        }
+
+        auto voc_raw = gas_raw(ohms);
+        voc_raw_published = VOCRaw(voc_raw);
+        side.set(voc_raw_published);
+        side.set(index.process(voc_raw));
+        side.set(GIAState(index.gia));
+        index.checkpoint(side.voc_calibration_blob(), i2c);
+    }
+
+    GasIndex index;
+    VOCRaw voc_raw_published;  // not-known until we've published, same as an unset slot
+    bool voc_yielded = false;
+
     static BME68X_INTF_RET_TYPE i2c_read_(uint8_t reg_addr, uint8_t* reg_data, uint32_t len, void* intf_ptr) {
         auto* self = reinterpret_cast<BME68x*>(intf_ptr);
         if (!self->i2c.read(reg_addr, reg_data, len)) return BME68X_E_COM_FAIL;
@@ -117,6 +245,8 @@ struct BME68x final : SensorPeriodicEnvI2C<Reg, "BME68x"> {
 
 }  // namespace
 
+static_assert(sensor_pool_fits<BME68x>(), "grow `SENSOR_POOL_BLOCK_SIZE`");
+
 unique_ptr<SensorPeriodic> bme68x(I2C_Bus& bus, EnvironmentalFilter side) {
     for (auto address : ADDRESSES)
         if (auto p = make_unique<BME68x>(bus, address, side); p->setup()) return p;
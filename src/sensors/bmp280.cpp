@@ -3,7 +3,9 @@
 #include "lib/bmp280_defs.h"
 #include "sdk/ble_data_types.hpp"
 #include "sdk/i2c.hpp"
+#include "sdk/task.hpp"
 #include "sensors/environmental_i2c.hpp"
+#include <chrono>
 #include <cstdint>
 
 using namespace std;
@@ -39,7 +41,7 @@ struct BMP280 final : SensorPeriodicEnvI2C<Reg, "BMP280"> {
             .intf_ptr = this,
             .read = i2c_read_,
             .write = i2c_write_,
-            .delay_ms = [](uint32_t delay_ms) { busy_wait_ms(delay_ms); },
+            .delay_ms = [](uint32_t delay_ms) { task_delay(chrono::milliseconds(delay_ms)); },
     };
 
     BMP280(BMP280 const&) = delete;
@@ -107,6 +109,8 @@ struct BMP280 final : SensorPeriodicEnvI2C<Reg, "BMP280"> {
 
 }  // namespace
 
+static_assert(sensor_pool_fits<BMP280>(), "grow `SENSOR_POOL_BLOCK_SIZE`");
+
 unique_ptr<SensorPeriodic> bmp280(I2C_Bus& bus, EnvironmentalFilter side) {
     for (auto address : ADDRESSES)
         if (auto p = make_unique<BMP280>(bus, address, side); p->setup()) return p;
@@ -6,6 +6,8 @@
 #include "lvgl.h"  // IWYU pragma: keep
 #include "sdk/i2c.hpp"
 #include "timers.h"  // IWYU pragma: keep [xTimerPend....]
+#include "ui.hpp"
+#include "utility/semaphore.hpp"
 #include <algorithm>
 #include <array>
 #include <cassert>
@@ -84,6 +86,9 @@ enum class Cmd : uint8_t {
     DISABLE_AUTO_SLEEP = 0xFE,
 };
 
+// Bits for `Cmd::MOTION_MASK`. Slides & clicks are always reported.
+constexpr uint8_t MOTION_DOUBLE_CLICK = 1u << 0;
+
 [[maybe_unused]] uint8_t operator|(IRQ a, IRQ b) {
     return uint8_t(a) | uint8_t(b);
 }
@@ -131,6 +136,12 @@ optional<uint8_t> reg_write(I2C_Bus& bus, Cmd const cmd, uint8_t value, uint8_t
 // all of them if any interrupt fires.
 //
 // Sensors are pinned in memory, and are never destroyed.
+//
+// The input device is event driven: its read timer is paused while nothing is touching the panel and
+// resumed by `CST816S::read` when the controller reports. LVGL still needs periodic reads while pressed
+// to detect long presses, so it keeps running until a release has been read.
+// Anything the sensor task does to LVGL (register, resume, ...) is under `ui::lock`, LVGL lives in the
+// display task.
 struct InstanceMetadata {
     InstanceMetadata() {
         lv_indev_drv_init(&driver);
@@ -151,8 +162,12 @@ private:
         assert(self);
         if (!self) return;
 
+        auto released = self->state.touch == CST816S::Touch::Up;
         data->point = {.x = lv_coord_t(self->state.x), .y = lv_coord_t(self->state.y)};
-        data->state = self->state.touch == CST816S::Touch::Up ? LV_INDEV_STATE_REL : LV_INDEV_STATE_PR;
+        data->state = released ? LV_INDEV_STATE_REL : LV_INDEV_STATE_PR;
+        // NB: Can race w/ a press landing between the `state` read & here. Harmless, the controller keeps
+        //     reporting (and so resuming us) for as long as the panel is touched.
+        if (released) lv_timer_pause(driver->read_timer);
     }
 };
 array<InstanceMetadata, NUM_I2CS> g_instances;
@@ -160,10 +175,11 @@ array<InstanceMetadata, NUM_I2CS> g_instances;
 }  // namespace
 
 struct CST816S::ISR {
+    static SemaphoreStorage lock_storage;
     static SemaphoreHandle_t lock;
 
     ISR() {
-        lock = xSemaphoreCreateBinary();
+        lock = lock_storage.mk_binary();
         xSemaphoreGive(lock);  // created w/ count 0, set it to 1
     }
 
@@ -205,13 +221,15 @@ struct CST816S::ISR {
     }
 } g_register_interrupt_callback;
 
+SemaphoreStorage CST816S::ISR::lock_storage;
 SemaphoreHandle_t CST816S::ISR::lock;
 
 void CST816S::register_isr() {
     // NOT IDEMPOTENT. Will consume a shared interrupt handler each time.
     // This is a horrible foot-gun of an API.
     if (auto pin = Pins::active().touch_interrupt) {
-        gpio_set_irq_enabled_with_callback(pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true, &ISR::isr);
+        // INT pulses low once per report, only need one edge of it
+        gpio_set_irq_enabled_with_callback(pin, GPIO_IRQ_EDGE_FALL, true, &ISR::isr);
     }
 }
 
@@ -228,8 +246,11 @@ CST816S::CST816S(I2C_Bus& bus) : bus(&bus) {
     if (auto [_, it] = ISR::first([](auto& x) { return x.driver.user_data == nullptr; }); it) {
         assert(!it->device);
         it->driver.user_data = this;
+        auto ui_guard = ui::lock();
         it->device = lv_indev_drv_register(&it->driver);
         assert(it->device && "failed to create LVGL input device");
+        lv_timer_pause(it->driver.read_timer);  // until the first report
+        instance = size_t(it - g_instances.data());
     } else
         assert(false && "unable to register CST816S, too many exist");
 }
@@ -237,7 +258,10 @@ CST816S::CST816S(I2C_Bus& bus) : bus(&bus) {
 // Ostensibly we'll never be destroyed, but hey, it's cheap to handle.
 CST816S::~CST816S() {
     if (auto [_, it] = ISR::first([&](auto& x) { return x.driver.user_data == this; }); it) {
-        if (it->device) lv_indev_delete(it->device);
+        if (it->device) {
+            auto ui_guard = ui::lock();
+            lv_indev_delete(it->device);
+        }
         it->device = nullptr;
         it->driver.user_data = nullptr;
     }
@@ -248,14 +272,13 @@ void CST816S::read() {
     xTaskNotifyWait(0, 0, nullptr, portMAX_DELAY);
 
     struct [[gnu::packed]] Batch {
-        // for now we don't care/bother to populate these
-        // uint8_t gesture;
-        // uint8_t fingers;
+        Gesture gesture;
+        uint8_t fingers;  // don't care, only ever reports 0 or 1
         uint16_t x;
         uint16_t y;
     };
 
-    auto read = reg_read<Batch>(*bus, Cmd::XPOS_H);
+    auto read = reg_read<Batch>(*bus, Cmd::GESTURE_ID);
     if (!read) {
         bus->log_error("CST816S", ADDRESS, "failed to read state");
         return;
@@ -264,9 +287,17 @@ void CST816S::read() {
     state.x = byteswap(read->x) & 0x0FFF;        // read in BE, need it in LE order
     state.y = byteswap(read->y) & 0x0FFF;        // read in BE, need it in LE order
     state.touch = Touch((read->x & 0xFF) >> 6);  // hi 2 bits in `x` are the event
-    // state.gesture = Gesture(read->gesture);
+    state.gesture = read->gesture;
+
+    if (auto* timer = g_instances.at(instance).driver.read_timer) {
+        auto ui_guard = ui::lock();
+        lv_timer_resume(timer);
+        lv_timer_ready(timer);
+    }
 }
 
+static_assert(sensor_pool_fits<CST816S>(), "grow `SENSOR_POOL_BLOCK_SIZE`");
+
 unique_ptr<CST816S> CST816S::mk(I2C_Bus& bus) {
     auto id = reg_read(bus, Cmd::CHIP_ID);
     if (!id) return {};  // nothing on the bus or error
@@ -281,11 +312,15 @@ unique_ptr<CST816S> CST816S::mk(I2C_Bus& bus) {
     else
         bus.log_warn("CST816S", ADDRESS, "failed to read FW revision");
 
-    if (!reg_write(bus, Cmd::IRQ_CTL, IRQ::EN_TOUCH | IRQ::EN_CHANGE, IRQ::EN_TOUCH | IRQ::EN_CHANGE)) {
+    auto const IRQS = IRQ::EN_TOUCH | IRQ::EN_CHANGE | IRQ::EN_MOTION;
+    if (!reg_write(bus, Cmd::IRQ_CTL, IRQS, IRQS)) {
         bus.log_error("CST816S", ADDRESS, "failed to change IRQ mode");
         return {};
     }
 
+    if (!reg_write(bus, Cmd::MOTION_MASK, MOTION_DOUBLE_CLICK))
+        bus.log_warn("CST816S", ADDRESS, "failed to enable double click gestures");
+
     return unique_ptr<CST816S>{new CST816S(bus)};
 }
 
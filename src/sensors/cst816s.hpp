@@ -2,6 +2,7 @@
 
 #include "async_sensor.hpp"
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 
@@ -45,8 +46,8 @@ struct CST816S final : SensorPeriodic {
         uint16_t x = 0;
         uint16_t y = 0;
         Touch touch = Touch::Up;
-        // FUTURE WORK: Gestures aren't read. LVGL can't make use of them anyways.
-        // Gesture gesture = Gesture::None;
+        // As decoded by the controller. LVGL does its own swipe detection, nothing binds these yet.
+        Gesture gesture = Gesture::None;
     };
 
     State state;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
@@ -60,8 +61,9 @@ struct CST816S final : SensorPeriodic {
         return "CST816S";
     }
 
+    // Purely IRQ driven, `read` blocks until the controller reports something.
     [[nodiscard]] std::chrono::milliseconds update_period() const override {
-        return 5ms;
+        return 0ms;
     }
 
 protected:
@@ -69,6 +71,7 @@ protected:
 
 private:
     I2C_Bus* bus;
+    size_t instance = 0;  // index into the LVGL input device table
 
     CST816S(I2C_Bus&);
 };
@@ -144,9 +144,12 @@ struct ENS16xSensor final : SensorPeriodicEnvI2C<Reg, "ENS16x"> {
     }
 
     void read() override {
+        // NB: Integer math on the raw (0.01 unit) values. Kelvin * 64, % * 512.
+        auto temperature = side.compensation_temperature();
+        auto humidity = side.compensation_humidity();
         Compensation compensation{
-                .temperature = uint16_t(max(0., (side.compensation_humidity() + 273.15) * 64)),
-                .humidity = uint16_t(side.compensation_humidity() * 512),
+                .temperature = uint16_t(max(0, (temperature.raw_value + 273'15) * 64 / 100)),
+                .humidity = uint16_t(min<uint32_t>(humidity.raw_value, 100'00) * 512 / 100),
         };
         if (!i2c.write(Reg::TemperatureIn, compensation)) return;
 
@@ -344,6 +347,8 @@ struct ENS16xSensor final : SensorPeriodicEnvI2C<Reg, "ENS16x"> {
 
 }  // namespace
 
+static_assert(sensor_pool_fits<ENS16xSensor>(), "grow `SENSOR_POOL_BLOCK_SIZE`");
+
 unique_ptr<SensorPeriodic> ens16x(I2C_Bus& bus, EnvironmentalFilter side) {
     for (auto address : ADDRESSES)
         if (auto p = make_unique<ENS16xSensor>(bus, address, side); p->setup()) return p;
@@ -2,9 +2,11 @@
 
 #include "sdk/ble_data_types.hpp"
 #include "sensors.hpp"
+#include "sensors/fusion.hpp"
 #include "sensors/gas_index_ble.hpp"
 #include "settings.hpp"
-#include <tuple>
+#include <cmath>
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 
@@ -14,11 +16,17 @@
 
 namespace nevermore::sensors {
 
+// Changes smaller than these don't count as activity for `AdaptivePeriod`. Roughly the sensors' noise floor.
+constexpr BLE::Temperature::Delta STABLE_DELTA_TEMPERATURE = 0.1;  // c
+constexpr BLE::Humidity::Delta STABLE_DELTA_HUMIDITY = 0.5;        // %
+constexpr BLE::Pressure::Delta STABLE_DELTA_PRESSURE = 20;         // Pa
+
 struct EnvironmentalFilter {
-    enum class Kind { Intake, Exhaust };
-    Kind kind;
+    Zone zone;
+    // Set by `set` when a temperature/humidity/pressure reading moves more than its `STABLE_DELTA_*`.
+    bool changed = false;
 
-    EnvironmentalFilter(Kind kind) : kind(kind) {}
+    EnvironmentalFilter(Zone zone) : zone(zone) {}
 
     // The Right Thing(TM) would be to have refs to config/service-data.
     // For now, just use `EnvironmentalService::g_sensors` and `EnvironmentalService::g_config`.
@@ -31,29 +39,48 @@ struct EnvironmentalFilter {
 
     template <typename A>
     void set(A x, Sensors& sensors = g_sensors) {
-        auto [main, _] = pick(sensors);
+        auto& main = sensors[zone];
 
 #if DBG_MEASURE_VOC_TEMPERATURE_HUMIDITY_EFFECT
+        // NB: Breakdown-only writes don't `touch`, they show up w/ the next regular reading.
         if constexpr (std::is_same_v<A, VOCRaw>) {
             dbg_voc_breakdown_state = (dbg_voc_breakdown_state + 1) % 4;
             switch (dbg_voc_breakdown_state) {
             case 0: {
-                std::get<VOCRawBreakdown&>(main).uncompensated = x;
+                main.voc_raw_breakdown.uncompensated = x;
                 dbg_print_voc_breakdown(main);
                 return;
             }
             case 1: break;  // update standard VOC-raw value
-            case 2: std::get<VOCRawBreakdown&>(main).humidity = x; return;
-            case 3: std::get<VOCRawBreakdown&>(main).temperature = x; return;
+            case 2: main.voc_raw_breakdown.humidity = x; return;
+            case 3: main.voc_raw_breakdown.temperature = x; return;
             }
         }
 #endif
-        std::get<A&>(main) = x;
+        // Several drivers can report the same quantity, the zone's slot holds their fused estimate.
+        // NB: keyed by `this`, drivers are pinned in memory so it's a stable identity.
+        auto& fusion = g_fusion.at(size_t(zone));
+        if constexpr (std::is_same_v<A, BLE::Temperature>) {
+            x = fusion.temperature.update(this, x);
+            changed |= significant(main.get<A>(), x, STABLE_DELTA_TEMPERATURE);
+        }
+        if constexpr (std::is_same_v<A, BLE::Humidity>) {
+            x = fusion.humidity.update(this, x);
+            changed |= significant(main.get<A>(), x, STABLE_DELTA_HUMIDITY);
+        }
+        if constexpr (std::is_same_v<A, BLE::Pressure>) {
+            x = fusion.pressure.update(this, x);
+            changed |= significant(main.get<A>(), x, STABLE_DELTA_PRESSURE);
+        }
+
+        main.get<A>() = x;
+        touch();
     }
 
-    [[nodiscard]] double compensation_temperature(
+    // Always known, falls back to typical values if there's no reading.
+    [[nodiscard]] BLE::Temperature compensation_temperature(
             Sensors const& sensors = g_sensors, Config const& config = g_config) const;
-    [[nodiscard]] double compensation_humidity(
+    [[nodiscard]] BLE::Humidity compensation_humidity(
             Sensors const& sensors = g_sensors, Config const& config = g_config) const;
 
     // PRECONDITION: called immediately after `set<VOCRaw>`
@@ -65,89 +92,71 @@ struct EnvironmentalFilter {
 #endif
     }
 
+    // NB: Intake & exhaust keep their original slots, the other zones' were appended to the settings.
     // GIVE ME "DEDUCING THIS" FFS. >:( GCC 14+ required
     [[nodiscard]] auto& voc_calibration_blob(settings::Settings& settings = settings::g_active) const {
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
-        return settings.voc_calibration[kind == EnvironmentalFilter::Kind::Intake ? 0 : 1];
+        if (size_t(zone) < settings.voc_calibration.size()) return settings.voc_calibration.at(size_t(zone));
+        return settings.voc_calibration_extra.at(size_t(zone) - settings.voc_calibration.size());
     }
 
 private:
+    template <typename A>
+    [[nodiscard]] static bool significant(A before, A after, typename A::Delta delta) {
+        if ((before == BLE::NOT_KNOWN) != (after == BLE::NOT_KNOWN)) return true;
+        if (after == BLE::NOT_KNOWN) return false;
+        return delta <= abs(after - before);
+    }
+
 #if DBG_MEASURE_VOC_TEMPERATURE_HUMIDITY_EFFECT
-    using Side = std::tuple<BLE::Temperature&, BLE::Humidity&, BLE::Pressure&, VOCIndex&, VOCRaw&, GIAState&,
-            VOCRawBreakdown&>;
     uint8_t dbg_voc_breakdown_state = 0;  // 0 => measuring full compensation, 3 => no comp
 
-    static void dbg_print_voc_breakdown(Side const& side) {
-        int f = std::get<VOCRaw&>(side).raw_value;
-        int h = std::get<VOCRawBreakdown&>(side).humidity.raw_value;
-        int t = std::get<VOCRawBreakdown&>(side).temperature.raw_value;
-        int n = std::get<VOCRawBreakdown&>(side).uncompensated.raw_value;
+    static void dbg_print_voc_breakdown(ZoneReadings const& zone) {
+        int f = zone.voc_raw.raw_value;
+        int h = zone.voc_raw_breakdown.humidity.raw_value;
+        int t = zone.voc_raw_breakdown.temperature.raw_value;
+        int n = zone.voc_raw_breakdown.uncompensated.raw_value;
         printf("VOC Breakdown - both=% 7d  humid=% 7d  temp=% 7d  none=% 7d\n", f, h, t, n);
         printf("                              humid=% 7d  temp=% 7d  none=% 7d\n", h - f, t - f, n - f);
     }
-#else
-    using Side = std::tuple<BLE::Temperature&, BLE::Humidity&, BLE::Pressure&, VOCIndex&, VOCRaw&, GIAState&>;
 #endif
 
     template <typename A>
         requires(!std::is_reference_v<A>)
     [[nodiscard]] A get_(Sensors const& sensors = g_sensors, Config const& config = g_config) const {
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-        auto [main, other] = pick(const_cast<Sensors&>(sensors));
+        auto value = sensors[zone].get<A>();
         if constexpr (BLE::has_not_known<A>) {
-            if (auto value = std::get<A&>(main); value != BLE::NOT_KNOWN) return value;
-            if (auto value = std::get<A&>(other); config.fallback) return value;
-            return BLE::NOT_KNOWN;
-        } else {
-            return std::get<A&>(main);
-        }
-    }
+            if (value != BLE::NOT_KNOWN || !config.fallback) return value;
 
-    [[nodiscard]] std::tuple<Side, Side> pick(Sensors& sensors = g_sensors) const {
-#if DBG_MEASURE_VOC_TEMPERATURE_HUMIDITY_EFFECT
-        Side intake{sensors.temperature_intake, sensors.humidity_intake, sensors.pressure_intake,
-                sensors.voc_index_intake, sensors.voc_raw_intake, sensors.gia_intake,
-                sensors.voc_raw_breakdown_intake};
-        Side exhaust{sensors.temperature_exhaust, sensors.humidity_exhaust, sensors.pressure_exhaust,
-                sensors.voc_index_exhaust, sensors.voc_raw_exhaust, sensors.gia_exhaust,
-                sensors.voc_raw_breakdown_exhaust};
-#else
-        Side intake{sensors.temperature_intake, sensors.humidity_intake, sensors.pressure_intake,
-                sensors.voc_index_intake, sensors.voc_raw_intake, sensors.gia_intake};
-        Side exhaust{sensors.temperature_exhaust, sensors.humidity_exhaust, sensors.pressure_exhaust,
-                sensors.voc_index_exhaust, sensors.voc_raw_exhaust, sensors.gia_exhaust};
-#endif
+            for (auto other : zone_fallbacks(zone))
+                if (sensors.used(other))
+                    if (auto x = sensors[other].get<A>(); x != BLE::NOT_KNOWN) return x;
 
-        switch (kind) {
-        case Kind::Intake: return {intake, exhaust};
-        case Kind::Exhaust: return {exhaust, intake};
+            return BLE::NOT_KNOWN;
+        } else {
+            return value;
         }
-
-        std::unreachable();  // stupid lack of case analysis
     }
 };
 
-// special: exhaust can prefer to fall back too the MCU temperature (always known) instead of intake
+// special: exhaust can prefer to fall back too the MCU temperature (always known) instead of other zones
 template <>
 inline BLE::Temperature EnvironmentalFilter::get<BLE::Temperature>(
         Sensors const& sensors, Config const& config) const {
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-    auto [main, other] = pick(const_cast<Sensors&>(sensors));
-    if (auto value = std::get<BLE::Temperature&>(main); value != BLE::NOT_KNOWN) return value;
+    if (auto value = sensors[zone].temperature; value != BLE::NOT_KNOWN) return value;
     // Exhaust falls back to MCU first, if enabled
-    if (g_config.fallback_exhaust_mcu && kind == Kind::Exhaust) return sensors.temperature_mcu;
+    if (g_config.fallback_exhaust_mcu && zone == Zone::Exhaust) return sensors.temperature_mcu;
     // No other fallbacks allowed
     if (!g_config.fallback) return BLE::NOT_KNOWN;
-    // Fall back to other side
-    if (auto value = std::get<BLE::Temperature&>(other); value != BLE::NOT_KNOWN) return value;
-    // we're intake, have no value, and neither does exhaust -> double fallback to MCU
+    // Fall back to other zones
+    if (auto value = get_<BLE::Temperature>(sensors, config); value != BLE::NOT_KNOWN) return value;
+    // no zone has a value -> double fallback to MCU
     if (g_config.fallback_exhaust_mcu) return sensors.temperature_mcu;
     return BLE::NOT_KNOWN;
 }
 
-inline double EnvironmentalFilter::compensation_temperature(
+inline BLE::Temperature EnvironmentalFilter::compensation_temperature(
         Sensors const& sensors, Config const& config) const {
-    auto fallback = [&]() { return 20.; };
+    auto fallback = [&]() { return BLE::Temperature(20); };
 
 #if DBG_MEASURE_VOC_TEMPERATURE_HUMIDITY_EFFECT
     switch (dbg_voc_breakdown_state) {
@@ -157,13 +166,14 @@ inline double EnvironmentalFilter::compensation_temperature(
     }
 #endif
 
-    return get<BLE::Temperature>(sensors, config).value_or(sensors.temperature_mcu.value_or(fallback()));
+    return get<BLE::Temperature>(sensors, config).or_(sensors.temperature_mcu.or_(fallback()));
 }
 
-inline double EnvironmentalFilter::compensation_humidity(Sensors const& sensors, Config const& config) const {
+inline BLE::Humidity EnvironmentalFilter::compensation_humidity(
+        Sensors const& sensors, Config const& config) const {
     // assume 25% humidity, which is not unreasonable in a hot printer
     // TODO: make fallback value based off temperature? is it worth the trouble?
-    auto fallback = [&]() { return 25.; };
+    auto fallback = [&]() { return BLE::Humidity(25); };
 
 #if DBG_MEASURE_VOC_TEMPERATURE_HUMIDITY_EFFECT
     switch (dbg_voc_breakdown_state) {
@@ -173,7 +183,7 @@ inline double EnvironmentalFilter::compensation_humidity(Sensors const& sensors,
     }
 #endif
 
-    return get<BLE::Humidity>(sensors, config).value_or(fallback());
+    return get<BLE::Humidity>(sensors, config).or_(fallback());
 }
 
 }  // namespace nevermore::sensors
@@ -4,6 +4,8 @@
 #include "sdk/i2c.hpp"
 #include "sensors/environmental.hpp"
 #include "utility/i2c_device.hpp"
+#include <chrono>
+#include <utility>
 
 namespace nevermore::sensors {
 
@@ -35,6 +37,18 @@ struct SensorPeriodicEnvI2C : SensorPeriodic {
     [[nodiscard]] char const* name() const final {
         return Name;
     }
+
+    // Backs off while stable, see `AdaptivePeriod`. VOC sensors must override this w/ a fixed period.
+    [[nodiscard]] std::chrono::milliseconds update_period() const override {
+        return pacing.period;
+    }
+
+protected:
+    AdaptivePeriod pacing;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+
+    void read_done() override {
+        pacing.update(std::exchange(side.changed, false));
+    }
 };
 
 }  // namespace nevermore::sensors
@@ -0,0 +1,76 @@
+#include "fusion.hpp"
+#include "FreeRTOS.h"  // IWYU pragma: keep
+#include "task.h"      // IWYU pragma: keep [taskENTER_CRITICAL]
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+using namespace std;
+
+namespace nevermore::sensors {
+
+array<ZoneFusion, ZONES_MAX> g_fusion;
+
+template <typename A>
+A Fusion<A>::update(void const* id, A x, Clock::time_point now) {
+    // NB: Critical section instead of a mutex, it's a handful of FP ops over <= `SOURCES_MAX` sources.
+    taskENTER_CRITICAL();
+
+    auto it = ranges::find(sources, id, &Source::id);
+    if (x == BLE::NOT_KNOWN) {
+        // NB: A source we aren't tracking gets no slot, it mustn't evict a live one on its way out.
+        if (it != sources.end()) *it = {};
+    } else {
+        if (it == sources.end()) it = ranges::find(sources, nullptr, &Source::id);
+        if (it == sources.end()) it = ranges::min_element(sources, {}, &Source::at);  // evict the stalest
+
+        auto value = x.value_or(0);
+        if (it->id == id)
+            it->jitter += (abs(value - it->value) - it->jitter) * JITTER_SMOOTHING;
+        else
+            *it = {.id = id};
+
+        it->value = value;
+        it->at = now;
+    }
+
+    for (auto& source : sources)
+        if (source.id && STALE_AFTER < now - source.at) source = {};
+
+    array<double, SOURCES_MAX> values;
+    size_t n = 0;
+    for (auto&& source : sources)
+        if (source.id) values.at(n++) = source.value;
+
+    double total = 0;
+    double weights = 0;
+    if (n) {
+        // NB: `nth_element`, not `sort`. Only need the median, & GCC 12 flags `sort`'s (dead) 16+ element
+        //     insertion sort path as out of bounds of `values`.
+        auto live = span(values).first(n);
+        auto median = live.begin() + (n - 1) / 2;  // lower median, always an actual reading
+        ranges::nth_element(live, median);
+
+        for (auto&& source : sources) {
+            if (!source.id) continue;
+            if (3 <= n && outlier_delta < abs(source.value - *median)) continue;
+
+            auto noise = max(source.jitter, jitter_floor);
+            auto weight = 1 / (noise * noise);
+            total += source.value * weight;
+            weights += weight;
+        }
+    }
+
+    taskEXIT_CRITICAL();
+
+    // NB: can't be empty w/ 3+ sources, the median source is never an outlier
+    if (weights <= 0) return BLE::NOT_KNOWN;
+    return A(total / weights);
+}
+
+template struct Fusion<BLE::Temperature>;
+template struct Fusion<BLE::Humidity>;
+template struct Fusion<BLE::Pressure>;
+
+}  // namespace nevermore::sensors
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "config.hpp"
+#include "sdk/ble_data_types.hpp"
+#include "sensors.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace nevermore::sensors {
+
+// Combines readings of one quantity from several drivers in the same zone into a single estimate.
+// e.g. a BME280 & an AHTxx both reporting the intake temperature.
+//  * Sources are weighted by the inverse square of their jitter, noisy sensors count for less.
+//  * Sources that haven't reported in `STALE_AFTER` are dropped (e.g. a sensor that fell off the bus).
+//  * W/ 3+ sources, readings further than `outlier_delta` from the median are ignored.
+//    W/ 2 there's no telling which one is wrong, so they're simply averaged.
+// Thread safe, drivers report from their own tasks.
+template <typename A>
+struct Fusion {
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t SOURCES_MAX = 4;
+    // Adaptive sensors report at least every `SENSOR_UPDATE_PERIOD_STABLE_MAX`, give them some slack.
+    static constexpr auto STALE_AFTER = SENSOR_UPDATE_PERIOD_STABLE_MAX * 2 + 1s;
+    static constexpr double JITTER_SMOOTHING = 0.25;  // EWMA factor, [0, 1]
+
+    struct Source {
+        void const* id = nullptr;  // `nullptr` -> unused slot
+        double value = 0;
+        double jitter = 0;  // EWMA of |delta| between consecutive readings
+        Clock::time_point at;
+    };
+
+    // `jitter_floor` keeps a perfectly quiet (or brand new) source from getting infinite weight
+    constexpr Fusion(double outlier_delta, double jitter_floor)
+            : outlier_delta(outlier_delta), jitter_floor(jitter_floor) {}
+
+    // `NOT_KNOWN` removes the source. Returns the fused estimate, `NOT_KNOWN` if there are no sources.
+    A update(void const* id, A x, Clock::time_point now = Clock::now());
+
+private:
+    double outlier_delta;
+    double jitter_floor;
+    std::array<Source, SOURCES_MAX> sources{};
+};
+
+struct ZoneFusion {
+    Fusion<BLE::Temperature> temperature{2, 0.05};  // c
+    Fusion<BLE::Humidity> humidity{5, 0.2};         // %
+    Fusion<BLE::Pressure> pressure{500, 5};         // Pa
+};
+
+extern std::array<ZoneFusion, ZONES_MAX> g_fusion;  // indexed by `Zone`
+
+}  // namespace nevermore::sensors
@@ -6,6 +6,7 @@
 #include <cassert>
 #include <chrono>
 #include <cstring>
+#include <type_traits>
 
 namespace nevermore::sensors {
 
@@ -23,19 +24,26 @@ struct GasIndex {
     }
 
     // ~330 us during steady-state, ~30 us during startup blackout
-    VOCIndex process(int32_t raw, settings::Settings const& settings = settings::g_active) {
+    // `Index` must match the algorithm type, e.g. `NOxIndex` for `GasIndexAlgorithm_ALGORITHM_TYPE_NOX`.
+    template <typename Index = VOCIndex>
+    Index process(int32_t raw, settings::Settings const& settings = settings::g_active) {
+        constexpr auto TYPE = std::is_same_v<Index, NOxIndex> ? GasIndexAlgorithm_ALGORITHM_TYPE_NOX
+                                                              : GasIndexAlgorithm_ALGORITHM_TYPE_VOC;
+        assert(gia.mAlgorithm_Type == TYPE);
+
+        // NB: The gating threshold setting is in VOC index units, NOx keeps the library's default.
         if (auto threshold = settings.voc_gating_threshold_override.or_(settings.voc_gating_threshold);
-                threshold != BLE::NOT_KNOWN) {
+                TYPE == GasIndexAlgorithm_ALGORITHM_TYPE_VOC && threshold != BLE::NOT_KNOWN) {
             assert(1 <= threshold && threshold <= 500);
             gia.mGating_Threshold = F16(threshold.value_or(0));
         }
 
         gia._gating_force = !settings.voc_calibration_enabled;
 
-        int32_t voc_index{};
-        GasIndexAlgorithm_process(&gia, raw, &voc_index);
-        assert(0 <= voc_index && voc_index <= 500);
-        return voc_index;
+        int32_t index{};
+        GasIndexAlgorithm_process(&gia, raw, &index);
+        assert(0 <= index && index <= 500);
+        return index;
     }
 
     // returns false IFF `src` doesn't contain a saved state
@@ -4,6 +4,7 @@
 #include "sdk/i2c.hpp"
 #include <bit>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <tuple>
 #include <utility>
@@ -102,6 +103,7 @@ optional<tuple<HTU2xD_Measure, double>> htu2xd_read_compensated(
 struct HTU2xDSensor final : SensorPeriodic {
     I2C_Bus& bus;  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
     EnvironmentalFilter side;
+    AdaptivePeriod pacing;
 
     HTU2xDSensor(I2C_Bus& bus, EnvironmentalFilter side) : bus(bus), side(side) {}
 
@@ -109,6 +111,14 @@ struct HTU2xDSensor final : SensorPeriodic {
         return "HTU2xD";
     }
 
+    [[nodiscard]] chrono::milliseconds update_period() const override {
+        return pacing.period;
+    }
+
+    void read_done() override {
+        pacing.update(std::exchange(side.changed, false));
+    }
+
     void read() override {
         auto htu2xd_fetch = [&](auto kind, auto delay) {
             if (!htu2xd_issue(bus, kind)) return;
@@ -138,6 +148,8 @@ bool htu2xd_exists(I2C_Bus& bus) {
 
 }  // namespace
 
+static_assert(sensor_pool_fits<HTU2xDSensor>(), "grow `SENSOR_POOL_BLOCK_SIZE`");
+
 unique_ptr<SensorPeriodic> htu2xd(I2C_Bus& bus, EnvironmentalFilter side) {
     if (!htu2xd_exists(bus)) return {};  // nothing found
 
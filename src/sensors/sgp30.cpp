@@ -126,13 +126,18 @@ struct SGP30Sensor final : SensorPeriodicEnvI2C<Reg, "SGP30", 0xFF> {
         index.checkpoint_clear();
     }
 
+    // Baseline & GIA are calibrated for a fixed sampling interval, never back off
+    [[nodiscard]] chrono::milliseconds update_period() const override {
+        return SENSOR_UPDATE_PERIOD;
+    }
+
     void read() override {
         // NB: clamp to a minimum rel humidity b/c 0% disables humidity compensation
         constexpr float MIN_REL_HUMIDITY = 0.25f;  // 0.25% is all we need for a lower bound.
         // compute abs humidity in float, double could get pointlessly expensive...
         auto abs_humidity_g_m3 =
-                humidity::absolute_fast(max(MIN_REL_HUMIDITY, (float)side.compensation_humidity()),
-                        (float)side.compensation_temperature());
+                humidity::absolute_fast(max(MIN_REL_HUMIDITY, float(double(side.compensation_humidity()))),
+                        float(double(side.compensation_temperature())));
         if (!humidity_absolute_set(uint32_t(abs_humidity_g_m3 * 1000))) {
             i2c.log_error("failed to set humidity compensation");
             return;
@@ -235,6 +240,8 @@ struct SGP30Sensor final : SensorPeriodicEnvI2C<Reg, "SGP30", 0xFF> {
 
 }  // namespace
 
+static_assert(sensor_pool_fits<SGP30Sensor>(), "grow `SENSOR_POOL_BLOCK_SIZE`");
+
 unique_ptr<SensorPeriodic> sgp30(I2C_Bus& bus, EnvironmentalFilter side) {
     for (auto address : ADDRESSES)
         if (auto p = make_unique<SGP30Sensor>(bus, address, side); p->setup()) return p;
@@ -3,9 +3,11 @@
 #include "sensors.hpp"
 #include "sensors/environmental_i2c.hpp"
 #include "sensors/gas_index.hpp"
+#include "sensors/sgp4x.hpp"
 #include "utility/numeric_suffixes.hpp"
 #include "utility/packed_tuple.hpp"
 #include <bit>
+#include <chrono>
 #include <cstdint>
 
 using namespace std;
@@ -32,12 +34,6 @@ enum class Cmd : uint16_t {
     SGP4x_SERIAL_NUMBER = std::byteswap(0x3682_u16),  // only available when in idle mode
 };
 
-constexpr uint16_t to_tick(double n, double min, double max) {
-    return uint16_t((clamp(n, min, max) - min) / (max - min) * UINT16_MAX);
-}
-static_assert(to_tick(50, 0, 100) == 0x8000 - 1, "humidity check");  // -1 b/c of truncation
-static_assert(to_tick(25, -45, 130) == 0x6666, "temperature check");
-
 struct SGP40 final : SensorPeriodicEnvI2C<Cmd, "SGP40", 0xFF> {
     using SensorPeriodicEnvI2C::SensorPeriodicEnvI2C;
 
@@ -66,6 +62,11 @@ struct SGP40 final : SensorPeriodicEnvI2C<Cmd, "SGP40", 0xFF> {
         index.checkpoint_clear();
     }
 
+    // GIA is calibrated for a fixed sampling interval, never back off
+    [[nodiscard]] chrono::milliseconds update_period() const override {
+        return SENSOR_UPDATE_PERIOD;
+    }
+
     void read() override {
         if (!measure(side.compensation_temperature(), side.compensation_humidity())) return;
 
@@ -83,9 +84,9 @@ struct SGP40 final : SensorPeriodicEnvI2C<Cmd, "SGP40", 0xFF> {
         index.checkpoint(side.voc_calibration_blob(), i2c);
     }
 
-    [[nodiscard]] bool measure(double temperature, double humidity) const {
-        uint16_t temperature_tick = byteswap(to_tick(temperature, -45, 130));
-        uint16_t humidity_tick = byteswap(to_tick(humidity, 0, 100));
+    [[nodiscard]] bool measure(BLE::Temperature temperature, BLE::Humidity humidity) const {
+        uint16_t temperature_tick = byteswap(sgp4x_tick(temperature));
+        uint16_t humidity_tick = byteswap(sgp4x_tick(humidity));
         PackedTuple params{
                 humidity_tick, crc8(humidity_tick, 0xFF), temperature_tick, crc8(temperature_tick, 0xFF)};
         if (!i2c.write(Cmd::SGP40_MEASURE, params)) return false;
@@ -109,6 +110,8 @@ struct SGP40 final : SensorPeriodicEnvI2C<Cmd, "SGP40", 0xFF> {
 
 }  // namespace
 
+static_assert(sensor_pool_fits<SGP40>(), "grow `SENSOR_POOL_BLOCK_SIZE`");
+
 unique_ptr<SensorPeriodic> sgp40(I2C_Bus& bus, EnvironmentalFilter side) {
     for (auto address : ADDRESSES)
         if (auto p = make_unique<SGP40>(bus, address, side); p->setup()) return p;
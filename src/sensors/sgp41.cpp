@@ -0,0 +1,175 @@
+#include "sgp41.hpp"
+#include "config.hpp"
+#include "sensors.hpp"
+#include "sensors/environmental_i2c.hpp"
+#include "sensors/gas_index.hpp"
+#include "sensors/sgp4x.hpp"
+#include "utility/numeric_suffixes.hpp"
+#include "utility/packed_tuple.hpp"
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+using namespace std;
+using namespace BLE;
+
+namespace nevermore::sensors {
+
+// SGP41 supports std-mode 100 kbits/s and fast mode 400 kbits/s
+static_assert(I2C_BAUD_RATE_SENSOR_MAX <= 400'000,
+        "`config.hpp`'s `I2C_BAUD_RATE_SENSOR_MAX` is too high for SGP41 (max 400 kbit/s)");
+
+namespace {
+
+constexpr uint8_t ADDRESSES[]{0x59};
+
+// Low byte is a bitset of failed pixels (VOC, NOx), high byte is reserved.
+constexpr uint16_t SELF_TEST_FAILED_MASK = 0b11;
+
+// Spec: run conditioning for 10 s after power-on, & no longer, it can damage the sensor.
+constexpr auto CONDITIONING_DURATION = 10s;
+
+// clangd bug: crash if `byteswap` is used w/o `std::` prefix in enum RHS.
+// SGP41 wants its cmds in BE order
+enum class Cmd : uint16_t {
+    SGP41_CONDITIONING = std::byteswap(0x2612_u16),   // transitions to measure mode, only reports VOC raw
+    SGP41_MEASURE_RAW = std::byteswap(0x2619_u16),    // transitions to measure mode
+    SGP41_SELF_TEST = std::byteswap(0x280E_u16),      // available in all modes, doesn't change mode
+    SGP4x_HEATER_OFF = std::byteswap(0x3615_u16),     // transitions to idle mode
+    SGP4x_SERIAL_NUMBER = std::byteswap(0x3682_u16),  // only available when in idle mode
+};
+
+struct [[gnu::packed]] Measurement {
+    uint16_t voc_raw;
+    CRC8_t voc_crc;
+    uint16_t nox_raw;
+    CRC8_t nox_crc;
+};
+static_assert(sizeof(Measurement) == 6);
+
+struct SGP41 final : SensorPeriodicEnvI2C<Cmd, "SGP41", 0xFF> {
+    using Clock = chrono::steady_clock;
+    using SensorPeriodicEnvI2C::SensorPeriodicEnvI2C;
+
+    GasIndex voc;
+    GasIndex nox{GasIndexAlgorithm_ALGORITHM_TYPE_NOX};
+    Clock::time_point conditioning_end;
+
+    bool setup() {
+        if (!i2c.touch(Cmd::SGP4x_HEATER_OFF)) {
+            // silently fail, likely there's no device on this address...
+            return false;
+        }
+
+        if (self_test() != 0) return false;
+
+        // SGP40s share our address & pass the same self-test. Only an SGP41 knows how to condition.
+        // NB: An SGP40 NACKs this, which logs a write error. Only on probes w/o a cached topology.
+        conditioning_end = Clock::now() + CONDITIONING_DURATION;
+        if (!command(Cmd::SGP41_CONDITIONING, side.compensation_temperature(), side.compensation_humidity()))
+            return false;
+        if (!i2c.read_crc<uint16_t>()) return false;
+
+        calibration_reset();
+        voc.restore(side.voc_calibration_blob(), i2c);
+
+        return true;
+    }
+
+    void calibration_reset() override {
+        // reinit also resets the checkpoint timeout
+        voc = {GasIndexAlgorithm_ALGORITHM_TYPE_VOC};
+        nox = {GasIndexAlgorithm_ALGORITHM_TYPE_NOX};
+    }
+
+    void calibration_force_checkpoint() override {
+        voc.checkpoint_clear();
+    }
+
+    // GIA is calibrated for a fixed sampling interval, never back off
+    [[nodiscard]] chrono::milliseconds update_period() const override {
+        return SENSOR_UPDATE_PERIOD;
+    }
+
+    void read() override {
+        // NOx isn't meaningful until conditioning is done, conditioning only reports VOC.
+        if (Clock::now() < conditioning_end) {
+            if (!command(Cmd::SGP41_CONDITIONING, side.compensation_temperature(),
+                        side.compensation_humidity()))
+                return;
+
+            auto response = i2c.read_crc<uint16_t>();
+            if (!response) return;
+
+            process(byteswap(*response), {});
+            return;
+        }
+
+        if (!command(Cmd::SGP41_MEASURE_RAW, side.compensation_temperature(), side.compensation_humidity()))
+            return;
+
+        // both raw signals in one read
+        auto response = i2c.read<Measurement>();
+        if (!response) return;
+        if (!crc(response->voc_raw, response->voc_crc)) return;
+        if (!crc(response->nox_raw, response->nox_crc)) return;
+
+        process(byteswap(response->voc_raw), byteswap(response->nox_raw));
+    }
+
+    // Both indices are stepped from the same sample in the same pass, so the GIA cost is fixed at
+    // 2 steps per sample (~0.7 ms/s) instead of each index getting its own schedule.
+    void process(uint16_t voc_raw, optional<uint16_t> nox_raw) {
+        side.set(VOCRaw(voc_raw));
+        if (side.was_voc_breakdown_measurement()) return;
+
+        side.set(voc.process(voc_raw));
+        side.set(GIAState(voc.gia));
+        if (nox_raw) side.set(nox.process<NOxIndex>(*nox_raw));
+
+        // NB: Only VOC state is checkpointed. The library doesn't support saving/restoring NOx state,
+        //     which re-learns within its (much shorter) blackout anyways.
+        voc.checkpoint(side.voc_calibration_blob(), i2c);
+    }
+
+    // Issues `cmd` w/ compensation params & waits for the result to be ready.
+    [[nodiscard]] bool command(Cmd cmd, BLE::Temperature temperature, BLE::Humidity humidity) const {
+        uint16_t temperature_tick = byteswap(sgp4x_tick(temperature));
+        uint16_t humidity_tick = byteswap(sgp4x_tick(humidity));
+        PackedTuple params{
+                humidity_tick, crc8(humidity_tick, 0xFF), temperature_tick, crc8(temperature_tick, 0xFF)};
+        if (!i2c.write(cmd, params)) return false;
+
+        task_delay(50ms);  // spec: max 50 ms for both conditioning & measure raw
+        return true;
+    }
+
+    // Returns the failed pixel bitset, 0 -> OK
+    [[nodiscard]] optional<uint16_t> self_test() const {
+        // spec says max delay of 320ms
+        auto const result = i2c.read_crc<uint16_t>(Cmd::SGP41_SELF_TEST, 320ms);
+        if (!result) {
+            i2c.log_error("self-test request failed");
+            return {};
+        }
+
+        auto failed = uint16_t(byteswap(*result) & SELF_TEST_FAILED_MASK);
+        if (failed) i2c.log_error("self-test failed, result 0x%04x", byteswap(*result));
+
+        return failed;
+    }
+};
+
+}  // namespace
+
+static_assert(sensor_pool_fits<SGP41>(), "grow `SENSOR_POOL_BLOCK_SIZE`");
+
+unique_ptr<SensorPeriodic> sgp41(I2C_Bus& bus, EnvironmentalFilter side) {
+    for (auto address : ADDRESSES)
+        if (auto p = make_unique<SGP41>(bus, address, side); p->setup()) return p;
+
+    return {};
+}
+
+}  // namespace nevermore::sensors
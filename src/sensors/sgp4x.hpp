@@ -0,0 +1,27 @@
+#pragma once
+
+#include "sdk/ble_data_types.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace nevermore::sensors {
+
+// SGP40/SGP41 compensation params: the full `uint16_t` range over [-45, 130] c & [0, 100] %.
+// NB: Integer math on the raw values, no soft-float. PRECONDITION: known, see `compensation_*`.
+constexpr uint16_t sgp4x_tick(BLE::Temperature x) {
+    constexpr int32_t MIN = -45 * BLE::Temperature::scale_decimal_unit;
+    constexpr int32_t MAX = 130 * BLE::Temperature::scale_decimal_unit;
+    return uint16_t((std::clamp<int32_t>(x.raw_value, MIN, MAX) - MIN) * UINT16_MAX / (MAX - MIN));
+}
+
+constexpr uint16_t sgp4x_tick(BLE::Humidity x) {
+    constexpr uint32_t MAX = 100 * BLE::Humidity::scale_decimal_unit;
+    return uint16_t(std::min<uint32_t>(x.raw_value, MAX) * UINT16_MAX / MAX);
+}
+
+static_assert(sgp4x_tick(BLE::Humidity(50)) == 0x8000 - 1, "humidity check");  // -1 b/c of truncation
+static_assert(sgp4x_tick(BLE::Temperature(25)) == 0x6666, "temperature check");
+static_assert(sgp4x_tick(BLE::Temperature(-50)) == 0 && sgp4x_tick(BLE::Temperature(140)) == UINT16_MAX);
+static_assert(sgp4x_tick(BLE::Humidity(0)) == 0 && sgp4x_tick(BLE::Humidity(100)) == UINT16_MAX);
+
+}  // namespace nevermore::sensors
@@ -3,11 +3,14 @@
 #include "async_sensor.hpp"
 #include "config/pins.hpp"
 #include "hardware/gpio.h"
+#include "pico/time.h"
 #include "sdk/pwm.hpp"
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <cstdint>
+#include <cstdio>
 
 namespace nevermore::sensors {
 
@@ -19,13 +22,18 @@ struct Tachometer final : SensorPeriodic {
     // need at least 100ms for a reasonable read and no point sampling longer than 1s
     constexpr static auto TACHOMETER_READ_PERIOD =
             std::clamp<std::chrono::milliseconds>(SENSOR_UPDATE_PERIOD, 100ms, 1s);
+    // Used while the fan reads as stopped. Enough to notice it spinning up, and lets the core idle
+    // for the rest of the update period instead of taking sampling IRQs.
+    constexpr static auto TACHOMETER_READ_PERIOD_STOPPED = std::min<std::chrono::milliseconds>(
+            TACHOMETER_READ_PERIOD, 100ms);
 
     // WORKAROUND:  There's EMI from the PWM wire (runs adjacent to tacho).
     // Proper fix:  Add a 2.2k pull-up & 0.1uF capacitor-to-0v to tachometer.
     //    Our fix:  Denoise the signal in software. Just wait for consensus
     //              over multiple samples before considering the state changed.
     //              Downside is that we need to do this in software instead of
-    //              using the PWM hardware.
+    //              using the PWM hardware. Samples are taken from a timer alarm
+    //              so the task sleeps through the read.
     // Credit to @Mario1up on Discord for confirming the EMI issue and proposing
     // and testing the hardware fix.
     using ConsensusSet = uint8_t;  // bigger type -> longer consensus period
@@ -50,43 +58,54 @@ struct Tachometer final : SensorPeriodic {
         return revolutions_per_second_;
     }
 
+    // # of completed reads, lets consumers tell when `revolutions_per_second` is fresh
+    [[nodiscard]] uint32_t readings() const {
+        return readings_;
+    }
+
     [[nodiscard]] char const* name() const override {
         return "Tachometer";
     }
 
 protected:
     void read() override {
-        // Since we're targetting relatively low pulse hz don't bother about
-        // keeping code in RAM to avoid flash penalty or function overhead;
-        // we're running at 125 MHz & reading <= 1 kHz pulse signals,
-        // we've plenty of room for sloppiness.
+        auto period = revolutions_per_second_ ? TACHOMETER_READ_PERIOD : TACHOMETER_READ_PERIOD_STOPPED;
+
+        pulse_start();
+        pulses_ = 0;
+        repeating_timer_t sampler;
         auto begin = std::chrono::steady_clock::now();
-        uint32_t pulses = pulse_count(begin);
+        // -ve -> period is measured between callback starts, i.e. no drift
+        if (!add_repeating_timer_us(-int64_t(PIN_SAMPLING_PERIOD / 1us), pulse_sample, this, &sampler)) {
+            printf("WARN - tachometer - no alarm slots free, skipping read\n");
+            return;
+        }
+        task_delay(period);
+        cancel_repeating_timer(&sampler);
         auto end = std::chrono::steady_clock::now();
+        uint32_t pulses = pulses_;
 
         auto duration_sec =
                 std::chrono::duration_cast<std::chrono::duration<float, std::ratio<1>>>(end - begin);
         // NOLINTNEXTLINE(bugprone-narrowing-conversions, cppcoreguidelines-narrowing-conversions)
         revolutions_per_second_ = pulses / duration_sec.count() / pulses_per_revolution;
+        ++readings_;
 
         // printf("tachometer_measure dur=%f s cnt=%u rev-per-sec=%f rpm=%f\n", duration_sec.count(),
         //         unsigned(pulses), revolutions_per_second_, revolutions_per_second_ * 60);
     }
 
 private:
-    // we're nowhere near high precision stuff
-    uint32_t pulse_count(std::chrono::steady_clock::time_point const begin) {
-        uint32_t pulses = 0;
-
-        pulse_start();
-
-        for (auto now = begin; (now - begin) < TACHOMETER_READ_PERIOD;
-                now = std::chrono::steady_clock::now()) {
-            pulses += pulse_poll();
-            task_delay(PIN_SAMPLING_PERIOD);
-        }
-
-        return pulses;
+    // Timer IRQ context. Since we're targetting relatively low pulse hz don't bother
+    // about keeping code in RAM to avoid flash penalty or function overhead;
+    // we're running at 125 MHz & reading <= 1 kHz pulse signals,
+    // we've plenty of room for sloppiness.
+    static bool pulse_sample(repeating_timer_t* timer) {
+        auto& self = *static_cast<Tachometer*>(timer->user_data);
+        // NB: only writer, no need for an atomic RMW (which the M0+ doesn't have anyways)
+        self.pulses_.store(self.pulses_.load(std::memory_order_relaxed) + self.pulse_poll(),
+                std::memory_order_relaxed);
+        return true;  // keep going
     }
 
     void pulse_start() {
@@ -126,6 +145,8 @@ private:
     std::array<ConsensusSet, Pins::ALTERNATIVES_MAX> denoise{};
     uint32_t pulses_per_revolution = 1;
     float revolutions_per_second_ = 0;
+    uint32_t readings_ = 0;
+    std::atomic<uint32_t> pulses_ = 0;  // this read's, written by `pulse_sample`
 
     static constexpr auto DENOISE_ALL = std::numeric_limits<ConsensusSet>::max();
 };
@@ -0,0 +1,54 @@
+#include "sensors.hpp"
+#include "sdk/ble_data_types.hpp"
+#include "sensors/environmental.hpp"
+#include <cstddef>
+
+// The zone model's SDK-free half, kept out of `sensors.cpp` so host tools (`bench/`) can build it.
+namespace nevermore::sensors {
+
+Sensors g_sensors;
+Config g_config;
+
+Sensors Sensors::with_fallbacks(Config const& config) const {
+    Sensors sensors = *this;
+    for (size_t i = 0; i < zones_used; ++i) {
+        EnvironmentalFilter side{Zone(i)};
+        auto& zone = sensors.zones.at(i);
+        auto apply = [&]<typename A>(A& x) { x = side.get<A>(*this, config); };
+        apply(zone.temperature);
+        apply(zone.humidity);
+        apply(zone.pressure);
+        apply(zone.voc_index);
+        apply(zone.nox_index);
+    }
+    return sensors;
+}
+
+SensorsV0 Sensors::v0() const {
+    auto const& intake = (*this)[Zone::Intake];
+    auto const& exhaust = (*this)[Zone::Exhaust];
+    SensorsV0 x{
+            .temperature_intake = intake.temperature,
+            .temperature_exhaust = exhaust.temperature,
+            .temperature_mcu = temperature_mcu,
+            .humidity_intake = intake.humidity,
+            .humidity_exhaust = exhaust.humidity,
+            .pressure_intake = intake.pressure,
+            .pressure_exhaust = exhaust.pressure,
+            .voc_index_intake = intake.voc_index,
+            .voc_index_exhaust = exhaust.voc_index,
+            .voc_raw_intake = intake.voc_raw,
+            .voc_raw_exhaust = exhaust.voc_raw,
+            .gia_intake = intake.gia,
+            .gia_exhaust = exhaust.gia,
+            .nox_index_intake = intake.nox_index,
+            .nox_index_exhaust = exhaust.nox_index,
+    };
+#if DBG_MEASURE_VOC_TEMPERATURE_HUMIDITY_EFFECT
+    x.voc_raw_breakdown_intake = intake.voc_raw_breakdown;
+    x.voc_raw_breakdown_exhaust = exhaust.voc_raw_breakdown;
+#endif
+    return x;
+}
+
+}  // namespace nevermore::sensors
@@ -7,6 +7,7 @@
 #include "utility/align.hpp"
 #include "utility/crc.hpp"
 #include "utility/scope_guard.hpp"
+#include "utility/semaphore.hpp"
 #include "utility/timer.hpp"
 #include <algorithm>
 #include <atomic>
@@ -285,6 +286,7 @@ constexpr bool operator&(ResetFlags lhs, ResetFlags rhs) {
     return std::to_underlying(lhs) & std::to_underlying(rhs);
 }
 
+SemaphoreStorage g_save_lock_storage;
 SemaphoreHandle_t g_save_lock;
 
 [[nodiscard]] auto save_guard() {
@@ -310,25 +312,36 @@ void Settings::reset(ResetFlags flags) {
     if (flags & sensor_calibration) {
         sensors::calibrations_reset();
         voc_calibration = Settings{}.voc_calibration;
+        voc_calibration_extra = Settings{}.voc_calibration_extra;
     }
 
     if (flags & policies) {
         // FIXME: This is a maintence nightmare. There must be a better way of doing things.
         auto header_ = g_active.header;
         auto voc_calibration_ = voc_calibration;
+        auto voc_calibration_extra_ = voc_calibration_extra;
         auto display_hw_ = display_hw;
         auto save_counter_ = save_counter;
+        auto fan_rpm_curve_ = fan_rpm_curve;
+        auto filter_life_ = filter_life;
+        auto sensor_topology_ = sensor_topology;
         *this = {};
         header = header_;
         voc_calibration = voc_calibration_;
+        voc_calibration_extra = voc_calibration_extra_;
         display_hw = display_hw_;
         save_counter = save_counter_;
+        fan_rpm_curve = fan_rpm_curve_;
+        filter_life = filter_life_;
+        sensor_topology = sensor_topology_;
     }
 
     if (flags & hardware) {
         // FIXME: This is a maintence nightmare. There must be a better way of doing things.
         display_hw = Settings{}.display_hw;
         pins = PINS_DEFAULT;
+        fan_rpm_curve = {};    // fans might've changed, re-characterise on next boot
+        sensor_topology = {};  // sensors might've changed, full probe on next boot
     }
 }
 
@@ -337,7 +350,7 @@ void init() {
     memcpy(g_flash_proxy, PICOWOTA_APP_STORE, sizeof(g_flash_proxy));
 #endif
 
-    g_save_lock = xSemaphoreCreateMutex();
+    g_save_lock = g_save_lock_storage.mk_mutex();
 
     if (auto const* latest = slot_latest()) {
         restore_from_slot(g_active, *latest);
@@ -406,6 +419,17 @@ void SettingsV0::merge_valid_fields(SettingsV0 const& x) {
     } catch (char const* msg) {
         printf("WARN - Settings - pins invalid, resetting to defaults. reason: %s\n", msg);
     }
+
+    if (x.fan_rpm_curve.validate()) fan_rpm_curve = x.fan_rpm_curve;
+    if (validate(x.fan_control_mode)) fan_control_mode = x.fan_control_mode;
+    if (x.filter_life.validate()) filter_life = x.filter_life;
+    advertise_telemetry = x.advertise_telemetry;
+    if (x.sensor_topology.validate()) sensor_topology = x.sensor_topology;
+    if (validate(x.display_buffering)) display_buffering = x.display_buffering;
+    if (x.fan_policy_nox_passive_max.raw_value <= 500)
+        fan_policy_nox_passive_max = x.fan_policy_nox_passive_max;
+    if (x.fan_policy_zones.validate()) fan_policy_zones = x.fan_policy_zones;
+    voc_calibration_extra = x.voc_calibration_extra;  // sensor specific, same as `voc_calibration`
 }
 
 }  // namespace nevermore::settings
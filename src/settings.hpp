@@ -4,10 +4,14 @@
 #include "utility/crc.hpp"
 #include "utility/fan_policy.hpp"
 #include "utility/fan_policy_thermal.hpp"
+#include "utility/fan_rpm_curve.hpp"
+#include "utility/filter_life.hpp"
+#include "utility/sensor_topology.hpp"
 #include <array>
 
 namespace nevermore::settings {
 
+using NOxIndex = sensors::NOxIndex;
 using VOCIndex = sensors::VOCIndex;
 
 // future work may allow it, but for now keep things simple
@@ -53,6 +57,15 @@ enum class DisplayUI : uint8_t {
     CIRCLE_240_NO_PLOT = 2,
 };
 
+// How LVGL renders into the display's draw arena. Takes effect on reboot.
+// Falls back to the largest strategy that fits if the arena is too small, see `display::init_with_ui`.
+enum class DisplayBuffering : uint8_t {
+    DOUBLE_HALF = 0,   // 2x half frame, render the next part while the previous is DMA'd
+    DOUBLE_TENTH = 1,  // 2x 1/10 frame, same as above w/ more flushes
+    SINGLE_TENTH = 2,  // 1x 1/10 frame, rendering stalls until the DMA finishes
+    DIRECT_FULL = 3,   // 1x full frame, only dirty areas are re-rendered; pushes a full frame per refresh
+};
+
 // Layout **cannot** change. This would break back-compatibility.
 // Fields **can** be appended w/o bumping the header version.
 // Padding **must** be explicitly declared using `Padding<N>`.
@@ -76,6 +89,17 @@ struct [[gnu::packed]] SettingsV0 {
     SaveCounter save_counter = {};
     Pins pins = PINS_DEFAULT;
     Padding<3> _1{};  // HACK: cannot remove, would screw with def-init of new members
+    FanRPMCurve fan_rpm_curve{};  // hardware characterisation, all zero -> re-characterise on boot
+    FanControlMode fan_control_mode = FanControlMode::PWM;
+    FilterLife filter_life{};          // checkpointed periodically, see `gatt::fan`
+    bool advertise_telemetry = false;  // include sensor/fan telemetry in BLE advertisements
+    SensorTopology sensor_topology{};  // updated after probing, see `sensors::init`
+    DisplayBuffering display_buffering = DisplayBuffering::DOUBLE_HALF;
+    // see `FanPolicyEnvironmental::Instance`. not-known -> disabled. Clean air sits at 1.
+    NOxIndex fan_policy_nox_passive_max = 100;
+    sensors::ZonePair fan_policy_zones{};  // see `FanPolicyEnvironmental::Instance`
+    // `voc_calibration` for the zones after intake & exhaust (i.e. chamber & aux), see `voc_calibration_blob`
+    std::array<SensorCalibrationBlob, 2> voc_calibration_extra{};
 
     // replaces valid fields from RHS into self
     void merge_valid_fields(SettingsV0 const&);
@@ -83,6 +107,10 @@ struct [[gnu::packed]] SettingsV0 {
 
 using SettingsPersisted = SettingsV0;
 static_assert(sizeof(SettingsPersisted) <= MAX_SIZE);
+static_assert(std::tuple_size_v<decltype(SettingsV0::voc_calibration)> +
+                      std::tuple_size_v<decltype(SettingsV0::voc_calibration_extra)> ==
+                sensors::ZONES_MAX,
+        "every zone needs a persisted VOC calibration slot");
 
 // The following not part of the settings structure because they are not to be
 // persisted across reboots.
@@ -136,4 +164,15 @@ constexpr bool validate(DisplayHW hw, DisplayUI ui) {
     }
 }
 
+constexpr bool validate(DisplayBuffering x) {
+    using enum DisplayBuffering;
+    switch (x) {
+    default: return false;
+    case DOUBLE_HALF:   // FALL THRU
+    case DOUBLE_TENTH:  // FALL THRU
+    case SINGLE_TENTH:  // FALL THRU
+    case DIRECT_FULL: return true;
+    }
+}
+
 }  // namespace nevermore::settings
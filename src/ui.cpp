@@ -8,6 +8,7 @@
 #include "sensors.hpp"
 #include "settings.hpp"
 #include "ui/circle_240/ui.hpp"
+#include "utility/semaphore.hpp"
 #include "utility/task.hpp"
 #include <algorithm>
 #include <chrono>
@@ -94,8 +95,9 @@ auto pretty_print_time(std::chrono::duration<A, Ratio> const& dur, char const* s
     return format("h", dur / 1.h);
 }
 
-template <typename A>
-auto label_set(lv_obj_t* obj, char const* unk, char const* fmt, A&& value, double scale = 1) {
+// Shows `value / Scale`. Scalars fold `Scale` into their own, one multiply & no soft-float divide.
+template <double Scale = 1., typename A>
+auto label_set(lv_obj_t* obj, char const* unk, char const* fmt, A&& value) {
     if (!obj) return;
 
     if constexpr (BLE::has_not_known<std::decay_t<A>>) {
@@ -107,7 +109,10 @@ auto label_set(lv_obj_t* obj, char const* unk, char const* fmt, A&& value, doubl
 
     // b/c we apparently don't have `<format>` yet in GCC 12.2.1
     char buffer[32];  // labels should be short, minimise stack usage
-    snprintf(buffer, size(buffer), fmt, double(value) / scale);
+    if constexpr (requires(std::decay_t<A> const& x) { x.template scaled<Scale>(); })
+        snprintf(buffer, size(buffer), fmt, value.template scaled<Scale>());
+    else
+        snprintf(buffer, size(buffer), fmt, double(value) / Scale);
     lv_label_set_text(obj, buffer);
 };
 
@@ -151,10 +156,10 @@ void fan_power_arc_colour_update() {
 }
 
 void display_update_labels() {
-    auto const& state = nevermore::sensors::g_sensors.with_fallbacks();
+    auto const& state = nevermore::sensors::with_fallbacks().v0();
 
-    label_set(ui.pressure_in, "--- hPa", "%.1f hPa", state.pressure_intake, 1e2);
-    label_set(ui.pressure_out, "--- hPa", "%.1f hPa", state.pressure_exhaust, 1e2);
+    label_set<1e2>(ui.pressure_in, "--- hPa", "%.1f hPa", state.pressure_intake);
+    label_set<1e2>(ui.pressure_out, "--- hPa", "%.1f hPa", state.pressure_exhaust);
     label_set(ui.humidity_in, "--- %", "%2.1f%%", state.humidity_intake);
     label_set(ui.humidity_out, "--- %", "%2.1f%%", state.humidity_exhaust);
 
@@ -165,6 +170,7 @@ void display_update_labels() {
 
     label_set(ui.fan_power, "", "%.0f%%", BLE::Percentage8(ceil(gatt::fan::fan_power())));
     label_set(ui.fan_rpm, "", "%.0f", gatt::fan::fan_rpm());
+    label_set<1e-2>(ui.filter_life, "", "%.0f%%", gatt::fan::filter_life_remaining());
 
     if (ui.fan_power_arc) {
         lv_arc_set_percent(ui.fan_power_arc, gatt::fan::fan_power() / 100);
@@ -175,7 +181,7 @@ void display_update_labels() {
 void display_update_plot() {
     if (!ui.chart) return;
 
-    auto const& state = nevermore::sensors::g_sensors.with_fallbacks();
+    auto const& state = nevermore::sensors::with_fallbacks().v0();
 
     if (lv_chart_get_point_count(ui.chart) < CHART_SERIES_ENTIRES_MAX) {
         // extend # of points until maximum
@@ -401,6 +407,7 @@ void on_chart_draw(bool begin, lv_event_t* e) {
     }
 }
 
+SemaphoreStorage g_ui_lock_storage;
 SemaphoreHandle_t g_ui_lock;
 auto using_semaphore(SemaphoreHandle_t& lock, TickType_t ticks_to_wait = portMAX_DELAY) {
     return [=](auto&& go) {
@@ -414,8 +421,13 @@ auto using_semaphore(SemaphoreHandle_t& lock, TickType_t ticks_to_wait = portMAX
 
 }  // namespace
 
+ScopeGuard<void (*)()> lock() {
+    xSemaphoreTake(g_ui_lock, portMAX_DELAY);
+    return {[] { xSemaphoreGive(g_ui_lock); }};
+}
+
 bool init() {
-    g_ui_lock = xSemaphoreCreateMutex();  // we panic on alloc failures, no need to handle null
+    g_ui_lock = g_ui_lock_storage.mk_mutex();  // we panic on alloc failures, no need to handle null
 
     using enum settings::DisplayUI;
     switch (settings::g_active.display_ui) {
@@ -488,10 +500,14 @@ bool init() {
     }
 #endif
 
-#define DISPLAY_TASK(name, period, stack_size, go)                \
-    mk_task(name, Priority::Display, stack_size)([]() {           \
-        periodic(period)([] { using_semaphore(g_ui_lock)(go); }); \
-    }).release()
+    // NB: each expansion is a distinct lambda, and so gets its own `storage`
+#define DISPLAY_TASK(name, period, stack_size, go)                    \
+    [] {                                                              \
+        static TaskStorage<stack_size> storage;                       \
+        mk_task(name, Priority::Display, storage)([]() {              \
+            periodic(period)([] { using_semaphore(g_ui_lock)(go); }); \
+        }).release();                                                 \
+    }()
 
     // must finish init-ing the UI *before* we start `lv_timer_handler` (which could otherwise interrupt)
     DISPLAY_TASK("display", DISPLAY_REFRESH_INTERVAL, 1024, lv_timer_handler);
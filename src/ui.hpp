@@ -1,8 +1,16 @@
 #pragma once
 
+#include "utility/scope_guard.hpp"
+
 namespace nevermore::ui {
 
 // Initialises the UI. Must be done using the same async context as the display.
 bool init();
 
+// Holds the UI lock until the guard is dropped. LVGL isn't thread safe, anything outside the display
+// tasks (e.g. input device drivers) must hold it to touch LVGL state.
+// NB: Not recursive, don't call from the display tasks, they already hold it.
+// REQUIRES: `init` succeeded
+[[nodiscard]] ScopeGuard<void (*)()> lock();
+
 }  // namespace nevermore::ui
@@ -19,6 +19,7 @@
 #define ui_XAxisScale (ui.chart_x_axis_scale)
 #define ui_FanPower (ui.fan_power)
 #define ui_FanRPM (ui.fan_rpm)
+#define ui_FilterLife (ui.filter_life)
 #define ui_TouchOverlay (ui.touch_overlay)
 #define ui_FanPowerArc (ui.fan_power_arc)
 
@@ -35,6 +36,7 @@ NevermoreDisplayUI nevermore_ui_screen_circle_240_classic() {
     lv_obj_t* ui_FanLabels;
     lv_obj_t* ui_FanPowerText;
     lv_obj_t* ui_FanRpmText;
+    lv_obj_t* ui_FilterLifeText;
     lv_obj_t* ui_FanValuesBox;
 
     NevermoreDisplayUI ui = {0};
@@ -309,6 +311,12 @@ NevermoreDisplayUI nevermore_ui_screen_circle_240_classic() {
     lv_obj_set_align(ui_FanRpmText, LV_ALIGN_CENTER);
     lv_label_set_text(ui_FanRpmText, "RPM:");
 
+    ui_FilterLifeText = lv_label_create(ui_FanLabels);
+    lv_obj_set_width(ui_FilterLifeText, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_FilterLifeText, LV_SIZE_CONTENT);  /// 1
+    lv_obj_set_align(ui_FilterLifeText, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_FilterLifeText, "Filter:");
+
     ui_FanValuesBox = lv_obj_create(ui_FanBox);
     lv_obj_remove_style_all(ui_FanValuesBox);
     lv_obj_set_height(ui_FanValuesBox, LV_SIZE_CONTENT);  /// 100
@@ -336,6 +344,14 @@ NevermoreDisplayUI nevermore_ui_screen_circle_240_classic() {
     lv_obj_set_style_text_color(ui_FanRPM, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_text_opa(ui_FanRPM, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
 
+    ui_FilterLife = lv_label_create(ui_FanValuesBox);
+    lv_obj_set_width(ui_FilterLife, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_FilterLife, LV_SIZE_CONTENT);  /// 1
+    lv_obj_set_align(ui_FilterLife, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_FilterLife, "---");
+    lv_obj_set_style_text_color(ui_FilterLife, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_opa(ui_FilterLife, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+
     ui_TouchOverlay = lv_obj_create(ui_classic);
     lv_obj_remove_style_all(ui_TouchOverlay);
     lv_obj_set_width(ui_TouchOverlay, lv_pct(100));
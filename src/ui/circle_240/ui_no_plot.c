@@ -16,6 +16,7 @@
 #define ui_VocOut2 (ui.voc_out)
 #define ui_FanPower2 (ui.fan_power)
 #define ui_FanRPM2 (ui.fan_rpm)
+#define ui_FilterLife2 (ui.filter_life)
 #define ui_TouchOverlay2 (ui.touch_overlay)
 #define ui_FanPowerArc2 (ui.fan_power_arc)
 
@@ -35,6 +36,7 @@ NevermoreDisplayUI nevermore_ui_screen_circle_240_no_plot() {
     lv_obj_t* ui_FanLabels2;
     lv_obj_t* ui_FanPowerText2;
     lv_obj_t* ui_FanRpmText2;
+    lv_obj_t* ui_FilterLifeText2;
     lv_obj_t* ui_FanValuesBox2;
 
     NevermoreDisplayUI ui = {0};
@@ -271,6 +273,14 @@ NevermoreDisplayUI nevermore_ui_screen_circle_240_no_plot() {
     lv_obj_set_style_text_color(ui_FanRpmText2, lv_color_hex(0xFF0000), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_text_opa(ui_FanRpmText2, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
 
+    ui_FilterLifeText2 = lv_label_create(ui_FanLabels2);
+    lv_obj_set_width(ui_FilterLifeText2, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_FilterLifeText2, LV_SIZE_CONTENT);  /// 1
+    lv_obj_set_align(ui_FilterLifeText2, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_FilterLifeText2, "Filter:");
+    lv_obj_set_style_text_color(ui_FilterLifeText2, lv_color_hex(0xFF0000), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_opa(ui_FilterLifeText2, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+
     ui_FanValuesBox2 = lv_obj_create(ui_FanBox2);
     lv_obj_remove_style_all(ui_FanValuesBox2);
     lv_obj_set_height(ui_FanValuesBox2, LV_SIZE_CONTENT);  /// 100
@@ -298,6 +308,14 @@ NevermoreDisplayUI nevermore_ui_screen_circle_240_no_plot() {
     lv_obj_set_style_text_color(ui_FanRPM2, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_text_opa(ui_FanRPM2, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
 
+    ui_FilterLife2 = lv_label_create(ui_FanValuesBox2);
+    lv_obj_set_width(ui_FilterLife2, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_FilterLife2, LV_SIZE_CONTENT);  /// 1
+    lv_obj_set_align(ui_FilterLife2, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_FilterLife2, "---");
+    lv_obj_set_style_text_color(ui_FilterLife2, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_opa(ui_FilterLife2, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+
     ui_TouchOverlay2 = lv_obj_create(ui_no_plot);
     lv_obj_remove_style_all(ui_TouchOverlay2);
     lv_obj_set_width(ui_TouchOverlay2, lv_pct(100));
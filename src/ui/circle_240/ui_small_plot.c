@@ -18,6 +18,7 @@
 #define ui_XAxisScale1 (ui.chart_x_axis_scale)
 #define ui_FanPower1 (ui.fan_power)
 #define ui_FanRPM1 (ui.fan_rpm)
+#define ui_FilterLife1 (ui.filter_life)
 #define ui_TouchOverlay1 (ui.touch_overlay)
 #define ui_FanPowerArc1 (ui.fan_power_arc)
 
@@ -48,6 +49,7 @@ NevermoreDisplayUI nevermore_ui_screen_circle_240_small_plot() {
     lv_obj_t* ui_FanLabels1;
     lv_obj_t* ui_FanPowerText1;
     lv_obj_t* ui_FanRpmText1;
+    lv_obj_t* ui_FilterLifeText1;
     lv_obj_t* ui_FanValuesBox1;
 
     NevermoreDisplayUI ui = {0};
@@ -467,6 +469,12 @@ NevermoreDisplayUI nevermore_ui_screen_circle_240_small_plot() {
     lv_obj_set_align(ui_FanRpmText1, LV_ALIGN_CENTER);
     lv_label_set_text(ui_FanRpmText1, "RPM:");
 
+    ui_FilterLifeText1 = lv_label_create(ui_FanLabels1);
+    lv_obj_set_width(ui_FilterLifeText1, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_FilterLifeText1, LV_SIZE_CONTENT);  /// 1
+    lv_obj_set_align(ui_FilterLifeText1, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_FilterLifeText1, "Filter:");
+
     ui_FanValuesBox1 = lv_obj_create(ui_FanBox1);
     lv_obj_remove_style_all(ui_FanValuesBox1);
     lv_obj_set_height(ui_FanValuesBox1, LV_SIZE_CONTENT);  /// 100
@@ -494,6 +502,14 @@ NevermoreDisplayUI nevermore_ui_screen_circle_240_small_plot() {
     lv_obj_set_style_text_color(ui_FanRPM1, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_style_text_opa(ui_FanRPM1, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
 
+    ui_FilterLife1 = lv_label_create(ui_FanValuesBox1);
+    lv_obj_set_width(ui_FilterLife1, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_FilterLife1, LV_SIZE_CONTENT);  /// 1
+    lv_obj_set_align(ui_FilterLife1, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_FilterLife1, "---");
+    lv_obj_set_style_text_color(ui_FilterLife1, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_opa(ui_FilterLife1, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+
     ui_TouchOverlay1 = lv_obj_create(ui_small_plot);
     lv_obj_remove_style_all(ui_TouchOverlay1);
     lv_obj_set_width(ui_TouchOverlay1, lv_pct(100));
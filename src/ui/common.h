@@ -32,6 +32,7 @@ typedef struct NevermoreDisplayUI {
     /* lv_label_t */ lv_obj_t* chart_x_axis_scale;
     /* lv_label_t */ lv_obj_t* fan_power;
     /* lv_label_t */ lv_obj_t* fan_rpm;
+    /* lv_label_t */ lv_obj_t* filter_life;
     /* lv_arc_t */ lv_obj_t* fan_power_arc;
     /* lv_obj_t */ lv_obj_t* touch_overlay;
 } NevermoreDisplayUI;
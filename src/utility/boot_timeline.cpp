@@ -0,0 +1,23 @@
+#include "boot_timeline.hpp"
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+
+using namespace std;
+using namespace std::literals::chrono_literals;
+
+namespace nevermore {
+
+void boot_timeline(char const* format, ...) {
+    auto ms = chrono::steady_clock::now().time_since_epoch() / 1ms;
+
+    // HACK: race-y, but whatever, stdio is race-y...
+    printf("BOOT +%u ms - ", unsigned(ms));
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    puts("");  // `puts` implicitly emits a newline after argument
+}
+
+}  // namespace nevermore
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace nevermore {
+
+// Logs `BOOT +<ms since boot> ms - <msg>` to serial.
+// Used to track time-to-first-reading and where startup time goes.
+[[gnu::format(printf, 1, 2)]] void boot_timeline(char const* format, ...);
+
+}  // namespace nevermore
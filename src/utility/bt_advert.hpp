@@ -91,4 +91,25 @@ BT_ADVERT_SERVICES(services_incomplete, BLUETOOTH_DATA_TYPE_INCOMPLETE_LIST_OF_1
 #undef BT_ADVERT_SERVICES0
 #undef BT_ADVERT_SERVICES
 
+namespace internal {
+
+template <typename A>
+struct [[gnu::packed]] ServiceData16 {
+    uint16_t service;
+    A data;
+};
+
+}  // namespace internal
+
+// `A` must be packed, it's sent as-is.
+template <uint16_t Service, typename A>
+constexpr auto service_data(A const& data) {
+    return internal::blob(
+            BLUETOOTH_DATA_TYPE_SERVICE_DATA_16_BIT_UUID, internal::ServiceData16<A>{Service, data});
+}
+static_assert(sizeof(service_data<0x181A>(uint8_t(0))) == 5);
+static_assert(std::get<1>(service_data<0x181A>(uint8_t(0))) == BLUETOOTH_DATA_TYPE_SERVICE_DATA_16_BIT_UUID);
+static_assert(std::get<2>(service_data<0x181A>(uint8_t(0x42))) == 0x1A);
+static_assert(std::get<4>(service_data<0x181A>(uint8_t(0x42))) == 0x42);
+
 }  // namespace bt::advert
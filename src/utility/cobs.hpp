@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace nevermore {
+
+// Consistent Overhead Byte Stuffing: encoded output never contains `0x00`, so it can be used as a frame
+// delimiter on a byte stream shared w/ other (text) traffic.
+// Worst case is 1 byte of overhead per 254 bytes of input (+1).
+constexpr size_t cobs_encoded_size_max(size_t n) {
+    return n + n / 254 + 1;
+}
+
+// Returns the encoded size, or `nullopt` if `dst` is too small.
+constexpr std::optional<size_t> cobs_encode(std::span<uint8_t const> src, std::span<uint8_t> dst) {
+    if (dst.size() < cobs_encoded_size_max(src.size())) return {};
+
+    size_t code_at = 0;
+    size_t n = 1;
+    uint8_t code = 1;
+    for (auto x : src) {
+        if (x != 0) {
+            dst[n++] = x;
+            code += 1;
+        }
+
+        if (x == 0 || code == 0xFF) {
+            dst[code_at] = code;
+            code_at = n++;
+            code = 1;
+        }
+    }
+
+    dst[code_at] = code;
+    return n;
+}
+
+// Decodes in place is fine (`dst.data() == src.data()`), output is never longer than the input.
+// Returns the decoded size, or `nullopt` if `src` isn't valid COBS (e.g. a truncated/corrupted frame).
+constexpr std::optional<size_t> cobs_decode(std::span<uint8_t const> src, std::span<uint8_t> dst) {
+    size_t n = 0;
+    for (size_t i = 0; i < src.size();) {
+        uint8_t code = src[i++];
+        if (code == 0 || src.size() < i + code - 1) return {};
+        if (dst.size() < n + code - 1) return {};
+
+        for (uint8_t j = 1; j < code; ++j)
+            dst[n++] = src[i++];
+
+        // a code of `0xFF` has no implicit zero, neither does the final block
+        if (code != 0xFF && i < src.size()) {
+            if (dst.size() <= n) return {};
+            dst[n++] = 0;
+        }
+    }
+
+    return n;
+}
+
+namespace internal {
+
+template <size_t N>
+constexpr std::array<uint8_t, N> filled(uint8_t x, size_t zero_at = N) {
+    std::array<uint8_t, N> xs{};
+    for (size_t i = 0; i < N; ++i)
+        xs[i] = i == zero_at ? 0 : x;
+    return xs;
+}
+
+// Encodes to exactly `encoded_size` bytes w/o any `0x00`, and decodes back to `src`.
+template <size_t N>
+constexpr bool round_trips(std::array<uint8_t, N> const& src, size_t encoded_size) {
+    std::array<uint8_t, cobs_encoded_size_max(N)> encoded{};
+    auto n = cobs_encode(src, encoded);
+    if (!n || *n != encoded_size) return false;
+    for (size_t i = 0; i < *n; ++i)
+        if (encoded[i] == 0) return false;
+
+    std::array<uint8_t, N> decoded{};
+    auto m = cobs_decode(std::span(encoded).first(*n), decoded);
+    return m && *m == N && decoded == src;
+}
+
+template <size_t N>
+constexpr bool decode_fails(std::array<uint8_t, N> const& src, size_t dst_size = N) {
+    std::array<uint8_t, N> dst{};
+    return !cobs_decode(src, std::span(dst).first(dst_size));
+}
+
+static_assert(round_trips<0>({}, 1));
+static_assert(round_trips<1>({0x00}, 2));
+static_assert(round_trips<3>({0x11, 0x00, 0x22}, 4));
+static_assert(round_trips<2>({0x00, 0x00}, 3));
+// block boundaries: a block holds <= 254 non-zero bytes (code `0xFF`, no implicit zero)
+static_assert(round_trips(filled<253>(0x5A), 254));
+static_assert(round_trips(filled<254>(0x5A, 253), 255));  // a zero ends the full-but-one block
+static_assert(round_trips(filled<254>(0x5A), 256));
+static_assert(round_trips(filled<255>(0x5A), 257));
+static_assert(round_trips(filled<255>(0x5A, 254), 257));
+static_assert(round_trips(filled<508>(0xA5), cobs_encoded_size_max(508)));  // worst case is tight
+static_assert(decode_fails<3>({0x05, 0x01, 0x02}));                        // truncated
+static_assert(decode_fails<3>({0x02, 0x01, 0x00}));                        // stray delimiter
+static_assert(decode_fails<4>({0x02, 0x11, 0x02, 0x22}, 2));               // `dst` too small
+
+}  // namespace internal
+
+}  // namespace nevermore
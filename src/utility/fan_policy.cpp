@@ -7,6 +7,7 @@
 using namespace std;
 using namespace std::literals::chrono_literals;
 using namespace BLE;
+using nevermore::sensors::NOxIndex;
 using nevermore::sensors::VOCIndex;
 
 namespace nevermore {
@@ -24,9 +25,22 @@ constexpr bool policy_voc_improving(VOCIndex voc_improve_min, VOCIndex intake, V
     return 0 <= voc_improvement && voc_improve_min <= voc_improvement;
 }
 
-constexpr bool should_filter(FanPolicyEnvironmental const& params, VOCIndex intake, VOCIndex exhaust) {
-    return policy_voc_too_high(params.voc_passive_max, intake, exhaust) ||
-           policy_voc_improving(params.voc_improve_min, intake, exhaust);
+constexpr bool policy_nox_too_high(NOxIndex nox_passive_max, NOxIndex intake, NOxIndex exhaust) {
+    // NB: Explicit checks, not-known & a `value_or(0)` share raw 0 and compare equivalent.
+    if (nox_passive_max == NOT_KNOWN) return false;                 // disabled
+    if (intake == NOT_KNOWN && exhaust == NOT_KNOWN) return false;  // sensors not connected
+
+    return nox_passive_max <= max(intake.value_or(0), exhaust.value_or(0));
+}
+
+constexpr bool should_filter(
+        FanPolicyEnvironmental::Instance const& instance, nevermore::sensors::Sensors const& state) {
+    auto const& params = instance.params;
+    auto const& intake = state[instance.zones.intake];
+    auto const& exhaust = state[instance.zones.exhaust];
+    return policy_voc_too_high(params.voc_passive_max, intake.voc_index, exhaust.voc_index) ||
+           policy_voc_improving(params.voc_improve_min, intake.voc_index, exhaust.voc_index) ||
+           policy_nox_too_high(instance.nox_passive_max, intake.nox_index, exhaust.nox_index);
 }
 
 enum class PolicyState { Idle, Filtering, Cooldown };
@@ -34,11 +48,9 @@ using enum PolicyState;
 
 constexpr PolicyState evaluate(FanPolicyEnvironmental::Instance const& instance,
         nevermore::sensors::Sensors const& state, chrono::steady_clock::time_point now) {
-    if (should_filter(instance.params, state.voc_index_intake, state.voc_index_exhaust)) return Filtering;
+    if (should_filter(instance, state)) return Filtering;
 
-    auto cooldown_end =
-            instance.last_filter + chrono::seconds(uint32_t(instance.params.cooldown.value_or(0)));
-    if (now < cooldown_end) return Cooldown;
+    if (now < instance.cooldown_end()) return Cooldown;
 
     return Idle;
 }
@@ -63,7 +75,25 @@ float FanPolicyEnvironmental::Instance::operator()(
 // Policy Tests
 
 // Initial state should be off if no sensors.
-static_assert(evaluate(FanPolicyEnvironmental{}.instance(), {}, {}) == Idle);
+static_assert(evaluate(FanPolicyEnvironmental{}.instance({}, {}), {}, {}) == Idle);
+
+// Cooldown
+constexpr chrono::steady_clock::duration cooldown_remaining(
+        chrono::steady_clock::time_point last_filter, chrono::steady_clock::time_point now) {
+    FanPolicyEnvironmental params;  // 15 min cooldown
+    auto instance = params.instance({}, {});
+    instance.last_filter = last_filter;
+    return instance.cooldown_remaining(now);
+}
+
+constexpr auto T0 = chrono::steady_clock::time_point{} + 1h;
+constexpr auto NEVER = chrono::steady_clock::time_point::min();  // `last_filter`'s initial value
+static_assert(cooldown_remaining(T0, T0) == 15min);
+static_assert(cooldown_remaining(T0, T0 + 10min) == 5min);
+static_assert(cooldown_remaining(T0, T0 + 15min) == 0s);  // barely over
+static_assert(cooldown_remaining(T0, T0 + 1h) == 0s);     // long over
+static_assert(cooldown_remaining(NEVER, T0) == 0s);       // never filtered
+static_assert(cooldown_remaining(NEVER, {}) == 0s);       // never filtered, at boot
 
 // VOC-exceeds-limits case
 static_assert(policy_voc_too_high(1, 1, 1));                   // barely
@@ -83,4 +113,11 @@ static_assert(!policy_voc_improving(2, NOT_KNOWN, NOT_KNOWN));  // sensors not c
 static_assert(!policy_voc_improving(NOT_KNOWN, 68, 76));        // disabled, unusual intake/exhuast
 static_assert(!policy_voc_improving(1, 68, 76));                // disabled, unusual intake/exhuast
 
+// NOx-exceeds-limits case
+static_assert(policy_nox_too_high(1, 1, NOT_KNOWN));           // barely
+static_assert(!policy_nox_too_high(2, 1, 1));                  // not enough
+static_assert(!policy_nox_too_high(NOT_KNOWN, 500, 500));      // disabled
+static_assert(!policy_nox_too_high(1, NOT_KNOWN, NOT_KNOWN));  // sensors not connected
+static_assert(!policy_nox_too_high({}, {}, {}));               // disabled, sensors not connected
+
 }  // namespace nevermore
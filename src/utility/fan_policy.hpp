@@ -9,6 +9,8 @@ using namespace std::literals::chrono_literals;
 
 struct [[gnu::packed]] FanPolicyEnvironmental {
     using VOCIndex = nevermore::sensors::VOCIndex;
+    using NOxIndex = nevermore::sensors::NOxIndex;
+    using ZonePair = nevermore::sensors::ZonePair;
 
     // How long to keep spinning after `should_filter` returns `false`
     BLE::TimeSecond16 cooldown = 60 * 15;
@@ -25,17 +27,33 @@ struct [[gnu::packed]] FanPolicyEnvironmental {
         using Clock = std::chrono::steady_clock;
 
         FanPolicyEnvironmental const& params;  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+        // <= max(intake, exhaust) -> filter. Not part of `params` b/c its layout is frozen by the settings.
+        NOxIndex const& nox_passive_max;  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+        // Zones playing the intake/exhaust roles above. Not part of `params` for the same reason.
+        ZonePair const& zones;  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
         Clock::time_point last_filter = Clock::time_point::min();
 
         // Stateful.
         // Returns fan power [0, 1] based on env state and policy parameters.
         [[nodiscard]] float operator()(
                 nevermore::sensors::Sensors const& state, Clock::time_point now = Clock::now());
+
+        // When the current cooldown ends, if any. In the past if not cooling down.
+        [[nodiscard]] constexpr Clock::time_point cooldown_end() const {
+            return last_filter + std::chrono::seconds(uint32_t(params.cooldown.value_or(0)));
+        }
+
+        // Zero if not cooling down.
+        // NB: Compare first, `last_filter` starts at `min()` so `cooldown_end() - now` can overflow.
+        [[nodiscard]] constexpr Clock::duration cooldown_remaining(Clock::time_point now) const {
+            auto end = cooldown_end();
+            return now < end ? end - now : Clock::duration::zero();
+        }
     };
 
-    // NB: DANGER - `this` must outlive `instance`
-    [[nodiscard]] constexpr Instance instance() const {
-        return {*this};
+    // NB: DANGER - `this`, `nox_passive_max`, & `zones` must outlive `instance`
+    [[nodiscard]] constexpr Instance instance(NOxIndex const& nox_passive_max, ZonePair const& zones) const {
+        return {*this, nox_passive_max, zones};
     }
 };
 
@@ -34,20 +34,19 @@ struct [[gnu::packed]] FanPolicyThermal {
         if (max <= current) return 1;  // trivially 0, also handles case where max <= min
         if (current < min) return 0;   // trivially 1, below limiter kicks in
 
-        auto range = max.value_or(0) - min.value_or(0);
-        auto x = current.value_or(0) - min.value_or(0);
-        assert(0 < max && "`0 < range` due to above checks");
-        return x / range;
+        // NB: ratio of deltas stays on the raw values. One soft-float divide instead of 5 ops.
+        auto range = max - min;
+        assert(0 < range && "`0 < range` due to above checks");
+        return (current - min) / range;
     }
 
     [[nodiscard]] double operator()(BLE::Temperature current) const {
-        auto coeff = coefficient.value_or(100);
-        if (coeff == 100) return 1;
+        if (coefficient == BLE::NOT_KNOWN || coefficient == 100) return 1;
 
         auto perc = percent(current);
         if (!perc) return 1;
 
-        return std::lerp(1, coeff / 100, *perc);
+        return std::lerp(1, coefficient.value_or(100) / 100, *perc);
     }
 };
 
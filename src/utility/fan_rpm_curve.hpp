@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace nevermore {
+
+enum class FanControlMode : uint8_t {
+    PWM = 0,  // fan % -> PWM duty (open loop)
+    RPM = 1,  // fan % -> % of characterised max RPM (closed loop, requires tachometer)
+};
+
+constexpr bool validate(FanControlMode mode) {
+    using enum FanControlMode;
+    switch (mode) {
+    default: return false;
+    case PWM:  // FALL THRU
+    case RPM: return true;
+    }
+}
+
+// Duty -> RPM characterisation of the attached fan(s).
+// `rpm[i]` is the measured RPM at duty `i / (POINTS - 1)`.
+// All zero -> not characterised (default init, no fan, or no tachometer).
+struct [[gnu::packed]] FanRPMCurve {
+    static constexpr size_t POINTS = 11;
+
+    std::array<uint16_t, POINTS> rpm{};
+
+    // Characterisation clamps samples to be monotonic, anything else is garbage.
+    [[nodiscard]] constexpr bool validate() const {
+        return std::ranges::is_sorted(rpm);
+    }
+
+    [[nodiscard]] constexpr bool characterised() const {
+        return validate() && 0 < rpm.back();
+    }
+
+    [[nodiscard]] constexpr double rpm_max() const {
+        return rpm.back();
+    }
+
+    // duty [0, 1] -> RPM
+    [[nodiscard]] constexpr double rpm_at(double duty) const {
+        auto x = std::clamp(duty, 0., 1.) * (POINTS - 1);
+        auto i = std::min(size_t(x), POINTS - 2);
+        auto lo = double(rpm.at(i));
+        auto hi = double(rpm.at(i + 1));
+        return lo + (hi - lo) * (x - double(i));
+    }
+
+    // RPM -> duty [0, 1]. Inverse of `rpm_at`.
+    // Picks the lowest duty reaching `target` (fans tend to stall below some duty).
+    [[nodiscard]] constexpr double duty_for(double target) const {
+        if (target <= 0) return 0;
+
+        for (size_t i = 1; i < POINTS; ++i) {
+            if (rpm.at(i) < target) continue;
+
+            auto lo = double(rpm.at(i - 1));
+            auto hi = double(rpm.at(i));
+            auto t = hi <= lo ? 1. : std::max(0., (target - lo) / (hi - lo));
+            return (double(i - 1) + t) / (POINTS - 1);
+        }
+
+        return 1;  // can't go any faster
+    }
+};
+
+namespace internal {
+
+// stalls below 20% duty, flat between 50% & 60%
+constexpr FanRPMCurve RPM_CURVE_TEST{{0, 0, 300, 600, 900, 1200, 1200, 1500, 1800, 2100, 2400}};
+
+static_assert(RPM_CURVE_TEST.characterised());
+static_assert(FanRPMCurve{}.validate() && !FanRPMCurve{}.characterised());  // not characterised
+
+// unsorted -> garbage
+constexpr FanRPMCurve RPM_CURVE_UNSORTED{{0, 300, 600, 900, 1200, 1100, 1300, 1400, 1500, 1600, 1700}};
+static_assert(!RPM_CURVE_UNSORTED.validate());
+static_assert(!RPM_CURVE_UNSORTED.characterised());
+
+static_assert(RPM_CURVE_TEST.rpm_max() == 2400);
+static_assert(RPM_CURVE_TEST.rpm_at(0) == 0);
+static_assert(RPM_CURVE_TEST.rpm_at(1) == 2400);
+static_assert(RPM_CURVE_TEST.rpm_at(-1) == 0);         // clamped
+static_assert(RPM_CURVE_TEST.rpm_at(2) == 2400);       // clamped
+static_assert(RPM_CURVE_TEST.rpm_at(0.25) == 450);     // interpolated
+static_assert(RPM_CURVE_TEST.rpm_at(0.1) == 0);        // stalled
+static_assert(RPM_CURVE_TEST.rpm_at(0.5625) == 1200);  // flat
+
+static_assert(RPM_CURVE_TEST.duty_for(0) == 0);
+static_assert(RPM_CURVE_TEST.duty_for(-1) == 0);
+static_assert(RPM_CURVE_TEST.duty_for(450) == 0.25);  // interpolated
+static_assert(RPM_CURVE_TEST.duty_for(300) == 0.2);   // lowest duty past the stall
+static_assert(RPM_CURVE_TEST.duty_for(1200) == 0.5);  // lowest duty of a flat segment
+static_assert(RPM_CURVE_TEST.duty_for(2400) == 1);    // barely
+static_assert(RPM_CURVE_TEST.duty_for(5000) == 1);    // can't go any faster
+static_assert(RPM_CURVE_TEST.rpm_at(RPM_CURVE_TEST.duty_for(750)) == 750);  // inverse
+
+}  // namespace internal
+
+}  // namespace nevermore
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+
+namespace nevermore {
+
+// When `FilterLife` considers the filter spent.
+// Ballpark figures, use `nevermore-filter-life` against your own traces to tune these.
+struct FilterLifeLimits {
+    float load = 50'000;            // VOC index excess * hours @ full fan power
+    float run_hours = 1'000;        // hours @ full fan power
+    float efficiency_new = 0.8f;    // efficiency -> 100% remaining
+    float efficiency_spent = 0.2f;  // efficiency -> 0% remaining
+};
+
+// Heuristic estimate of how much of the filter's (i.e. carbon's) adsorption capacity is spent.
+//
+// The VOC index isn't a concentration, it's relative to the sensor's recent history (100 -> typical).
+// So the best we can do is:
+//  * Integrate how much 'excess' VOC index the filter removes (`load`), weighted by fan power.
+//  * Track how well it's still doing it (`efficiency`), as a slow moving average.
+//  * Track fan power weighted run time (`run_hours`), for filters that never see much VOC.
+// The filter is considered spent when any of them hit their limit.
+//
+// NB: `nevermore-filter-life` (see `bench/`) replays recorded traces through this on the host.
+struct [[gnu::packed]] FilterLife {
+    static constexpr float EFFICIENCY_TIME_CONSTANT_HOURS = 8;  // run hours
+
+    static constexpr double VOC_INDEX_BASELINE = 100;   // VOC index of 'typical' air
+    static constexpr double VOC_INDEX_SIGNAL_MIN = 50;  // need this much excess to estimate efficiency
+    static constexpr double FAN_POWER_MIN = 0.2;        // too little airflow to estimate efficiency
+
+    float load = 0;
+    float run_hours = 0;
+    float efficiency = -1;  // [0, 1], < 0 -> not known (yet)
+
+    [[nodiscard]] constexpr bool validate() const {
+        auto ok = [](float x) { return std::isfinite(x) && 0 <= x; };
+        return ok(load) && ok(run_hours) && std::isfinite(efficiency) && efficiency <= 1;
+    }
+
+    [[nodiscard]] constexpr bool efficiency_known() const {
+        return 0 <= efficiency;
+    }
+
+    // `fan_power` : [0, 1]
+    // `voc_*`     : VOC index, NaN if not known
+    constexpr void update(double voc_intake, double voc_exhaust, double fan_power, double hours) {
+        if (!(0 < hours) || !(0 < fan_power)) return;
+
+        auto hours_eff = hours * std::clamp(fan_power, 0., 1.);
+        run_hours += float(hours_eff);
+
+        if (std::isnan(voc_intake) || std::isnan(voc_exhaust)) return;
+
+        auto excess = voc_intake - VOC_INDEX_BASELINE;
+        auto removed = std::max(0., voc_intake - voc_exhaust);
+        load += float(removed * hours_eff);
+
+        if (excess < VOC_INDEX_SIGNAL_MIN || fan_power < FAN_POWER_MIN) return;
+
+        auto sample = float(std::clamp(removed / excess, 0., 1.));
+        if (!efficiency_known()) {
+            efficiency = sample;
+            return;
+        }
+
+        auto alpha = float(hours_eff / (EFFICIENCY_TIME_CONSTANT_HOURS + hours_eff));
+        efficiency += (sample - efficiency) * alpha;
+    }
+
+    // [0, 1]
+    [[nodiscard]] constexpr double remaining(FilterLifeLimits const& limits = {}) const {
+        auto x = 1 - std::max(load / limits.load, run_hours / limits.run_hours);
+        if (efficiency_known()) {
+            auto eff = (efficiency - limits.efficiency_spent) /
+                       (limits.efficiency_new - limits.efficiency_spent);
+            x = std::min(x, eff);
+        }
+
+        return std::clamp<double>(x, 0, 1);
+    }
+};
+
+namespace internal {
+
+struct FilterLifeUpdate {
+    double voc_intake, voc_exhaust, fan_power, hours;
+};
+
+constexpr FilterLife filter_life_replay(std::initializer_list<FilterLifeUpdate> xs, FilterLife life = {}) {
+    for (auto&& x : xs)
+        life.update(x.voc_intake, x.voc_exhaust, x.fan_power, x.hours);
+    return life;
+}
+
+// load accumulation, weighted by fan power
+static_assert(filter_life_replay({{200, 100, 1, 2}}).load == 200);
+static_assert(filter_life_replay({{200, 100, 1, 2}}).run_hours == 2);
+static_assert(filter_life_replay({{200, 100, 0.5, 2}}).load == 100);
+static_assert(filter_life_replay({{200, 100, 0.5, 2}}).run_hours == 1);
+static_assert(filter_life_replay({{200, 100, 1, 2}, {200, 100, 1, 1}}).load == 300);
+static_assert(filter_life_replay({{100, 200, 1, 2}}).load == 0);       // exhaust dirtier, nothing removed
+static_assert(filter_life_replay({{NAN, 100, 1, 2}}).load == 0);       // not known, only runs
+static_assert(filter_life_replay({{NAN, 100, 1, 2}}).run_hours == 2);  // not known, only runs
+static_assert(filter_life_replay({{200, 100, 0, 2}}).run_hours == 0);  // fan off
+
+// efficiency EWMA
+static_assert(!FilterLife{}.efficiency_known());
+static_assert(filter_life_replay({{200, 100, 1, 1}}).efficiency == 1);  // first sample
+static_assert(filter_life_replay({{200, 100, 1, 1}, {200, 150, 1, 8}}).efficiency == 0.75f);  // alpha 1/2
+static_assert(filter_life_replay({{200, 100, 1, 1}, {200, 150, 1, 0}}).efficiency == 1);  // no time passed
+static_assert(!filter_life_replay({{140, 100, 1, 1}}).efficiency_known());                // signal too weak
+static_assert(!filter_life_replay({{200, 100, 0.1, 1}}).efficiency_known());              // airflow too weak
+static_assert(filter_life_replay({{200, 300, 1, 1}}).efficiency == 0);                    // clamped
+
+// remaining life, clamped to [0, 1]
+static_assert(FilterLife{}.remaining() == 1);
+static_assert(FilterLife{.load = 25'000}.remaining() == 0.5);
+static_assert(FilterLife{.run_hours = 500}.remaining() == 0.5);
+static_assert(FilterLife{.load = 100'000}.remaining() == 0);                      // overspent
+static_assert(FilterLife{.run_hours = 2'000}.remaining() == 0);                   // overspent
+static_assert(FilterLife{.efficiency = 1}.remaining() == 1);                      // better than new
+static_assert(FilterLife{.efficiency = 0}.remaining() == 0);                      // worse than spent
+static_assert(FilterLife{.load = 25'000, .efficiency = 1}.remaining() == 0.5);    // worst estimate wins
+static_assert(FilterLife{.run_hours = 500}.remaining({.run_hours = 250}) == 0);  // tuned limits
+
+}  // namespace internal
+
+}  // namespace nevermore
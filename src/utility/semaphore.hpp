@@ -0,0 +1,33 @@
+#pragma once
+
+#include "FreeRTOS.h"  // IWYU pragma: keep
+#include "semphr.h"    // IWYU pragma: keep [doesn't notice `SemaphoreHandle_t`]
+
+namespace nevermore {
+
+// Backing for a semaphore. Only has storage when built w/ `NEVERMORE_STATIC_ALLOCATION`, otherwise the
+// semaphore is allocated from the heap.
+// INVARIANT: Must outlive the semaphore, and may only back one semaphore at a time.
+struct SemaphoreStorage {
+#if NEVERMORE_STATIC_ALLOCATION
+    StaticSemaphore_t buffer;
+#endif
+
+    SemaphoreHandle_t mk_mutex() {
+#if NEVERMORE_STATIC_ALLOCATION
+        return xSemaphoreCreateMutexStatic(&buffer);
+#else
+        return xSemaphoreCreateMutex();
+#endif
+    }
+
+    SemaphoreHandle_t mk_binary() {
+#if NEVERMORE_STATIC_ALLOCATION
+        return xSemaphoreCreateBinaryStatic(&buffer);
+#else
+        return xSemaphoreCreateBinary();
+#endif
+    }
+};
+
+}  // namespace nevermore
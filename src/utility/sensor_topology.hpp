@@ -0,0 +1,66 @@
+#pragma once
+
+#include "config/pins.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+namespace nevermore {
+
+// Persisted, **cannot** be renumbered. Used as bit indices for `SensorTopology::Bus::drivers`.
+enum class SensorDriver : uint8_t {
+    AHTxx = 0,
+    BME280 = 1,
+    BME68x = 2,
+    BMP280 = 3,
+    ENS16x = 4,
+    HTU2xD = 5,
+    SGP30 = 6,
+    SGP40 = 7,
+    SGP41 = 8,
+};
+
+// Which drivers found a device on which bus the last time we probed.
+// Lets a warm boot skip probing (and waiting on the power-on delay of) drivers that found nothing.
+// Buses are keyed by their data pin, not their index in `Pins::i2c`, so a pin change invalidates the entry.
+struct [[gnu::packed]] SensorTopology {
+    using Drivers = uint16_t;  // bitset of `SensorDriver`
+    static constexpr Drivers DRIVERS_KNOWN = (1u << (uint8_t(SensorDriver::SGP41) + 1)) - 1;
+
+    struct [[gnu::packed]] Bus {
+        GPIO data;
+        Drivers drivers = 0;  // 0 -> unused slot
+    };
+
+    Bus buses[Pins::ALTERNATIVES_MAX]{};
+
+    [[nodiscard]] static constexpr Drivers bit(SensorDriver x) {
+        return Drivers(1u << uint8_t(x));
+    }
+
+    [[nodiscard]] constexpr bool validate() const {
+        return std::ranges::all_of(buses, [](auto&& bus) {
+            return bus.data.validate() && (bus.drivers & ~DRIVERS_KNOWN) == 0 &&
+                   (bus.drivers == 0 || !bus.data.not_set());
+        });
+    }
+
+    [[nodiscard]] constexpr Bus const* find(GPIO data) const {
+        auto it = std::ranges::find_if(buses, [&](auto&& bus) { return bus.drivers && bus.data == data; });
+        return it == std::end(buses) ? nullptr : &*it;
+    }
+
+    // `drivers == 0` removes the entry.
+    // Returns false if `drivers` had to be dropped b/c we're out of slots.
+    constexpr bool set(GPIO data, Drivers drivers) {
+        auto it = std::ranges::find_if(buses, [&](auto&& bus) { return bus.drivers && bus.data == data; });
+        if (it == std::end(buses))
+            it = std::ranges::find_if(buses, [](auto&& bus) { return bus.drivers == 0; });
+        if (it == std::end(buses)) return drivers == 0;
+
+        *it = drivers ? Bus{.data = data, .drivers = drivers} : Bus{};
+        return true;
+    }
+};
+
+}  // namespace nevermore
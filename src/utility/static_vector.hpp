@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace nevermore {
+
+// Fixed capacity stand-in for `std::vector`, only implements what we actually use.
+// Throws if pushed past capacity.
+template <typename A, size_t N>
+struct StaticVector {
+    using value_type = A;
+
+    [[nodiscard]] constexpr size_t size() const {
+        return n;
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() {
+        return N;
+    }
+
+    [[nodiscard]] constexpr bool empty() const {
+        return n == 0;
+    }
+
+    constexpr A* begin() {
+        return xs.data();
+    }
+
+    constexpr A* end() {
+        return xs.data() + n;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    constexpr A const* begin() const {
+        return xs.data();
+    }
+
+    constexpr A const* end() const {
+        return xs.data() + n;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    constexpr void push_back(A x) {
+        if (n == N) throw "StaticVector capacity exceeded";
+
+        xs[n++] = std::move(x);
+    }
+
+    constexpr void shrink_to_fit() {}  // nothing to do, here for parity w/ `std::vector`
+
+private:
+    std::array<A, N> xs{};
+    size_t n = 0;
+};
+
+}  // namespace nevermore
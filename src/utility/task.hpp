@@ -17,6 +17,29 @@ enum class Priority : UBaseType_t {
 };
 static_assert(UBaseType_t(Priority::Startup) < configMAX_PRIORITIES);
 
+// Stack & TCB for a task. Only has storage when built w/ `NEVERMORE_STATIC_ALLOCATION`, otherwise the
+// task is allocated from the heap.
+// INVARIANT: Must outlive the task, and may only back one task at a time.
+template <uint32_t StackDepth>
+struct TaskStorage {
+#if NEVERMORE_STATIC_ALLOCATION
+    StaticTask_t tcb;
+    StackType_t stack[StackDepth];
+#endif
+
+    TaskHandle_t create(TaskFunction_t go, void* param, char const* name, Priority priority,
+            UBaseType_t affinity_mask) {
+#if NEVERMORE_STATIC_ALLOCATION
+        return xTaskCreateStaticAffinitySet(
+                go, name, StackDepth, param, UBaseType_t(priority), stack, &tcb, affinity_mask);
+#else
+        TaskHandle_t task{};
+        xTaskCreateAffinitySet(go, name, StackDepth, param, UBaseType_t(priority), affinity_mask, &task);
+        return task;
+#endif
+    }
+};
+
 struct Task {
     Task() = default;
     Task(Task const&) = delete;
@@ -33,23 +56,22 @@ struct Task {
 
     explicit Task(TaskHandle_t task) : task(task) {}
 
-    Task(void (*go)(void*), void* param, char const* name, uint32_t stack_depth, Priority priority,
-            UBaseType_t affinity_mask = tskNO_AFFINITY) {
-        xTaskCreateAffinitySet(go, "", stack_depth, param, UBaseType_t(priority), affinity_mask, &task);
-    }
+    template <uint32_t StackDepth>
+    Task(void (*go)(void*), void* param, char const* name, TaskStorage<StackDepth>& storage,
+            Priority priority, UBaseType_t affinity_mask = tskNO_AFFINITY)
+        : task(storage.create(go, param, name, priority, affinity_mask)) {}
 
-    Task(void (*go)(), char const* name, Priority priority, uint32_t stack_depth,
-            UBaseType_t affinity_mask = tskNO_AFFINITY) {
-        xTaskCreateAffinitySet([](void* go) { reinterpret_cast<void (*)()>(go)(); }, "", stack_depth,
-                reinterpret_cast<void*>(go), UBaseType_t(priority), affinity_mask, &task);
-    }
+    template <uint32_t StackDepth>
+    Task(void (*go)(), char const* name, Priority priority, TaskStorage<StackDepth>& storage,
+            UBaseType_t affinity_mask = tskNO_AFFINITY)
+        : task(storage.create([](void* go) { reinterpret_cast<void (*)()>(go)(); },
+                  reinterpret_cast<void*>(go), name, priority, affinity_mask)) {}
 
-    template <typename A>
-    Task(A (*go)(), char const* name, Priority priority, uint32_t stack_depth,
-            UBaseType_t affinity_mask = tskNO_AFFINITY) {
-        xTaskCreateAffinitySet([](void* go) { reinterpret_cast<A (*)()>(go)(); }, "", stack_depth,
-                reinterpret_cast<void*>(go), UBaseType_t(priority), affinity_mask, &task);
-    }
+    template <typename A, uint32_t StackDepth>
+    Task(A (*go)(), char const* name, Priority priority, TaskStorage<StackDepth>& storage,
+            UBaseType_t affinity_mask = tskNO_AFFINITY)
+        : task(storage.create([](void* go) { reinterpret_cast<A (*)()>(go)(); },
+                  reinterpret_cast<void*>(go), name, priority, affinity_mask)) {}
 
     ~Task() {
         reset();
@@ -89,9 +111,10 @@ private:
     TaskHandle_t task{};
 };
 
-constexpr auto mk_task(char const* name, Priority priority, uint32_t stack_depth,
+template <uint32_t StackDepth>
+constexpr auto mk_task(char const* name, Priority priority, TaskStorage<StackDepth>& storage,
         UBaseType_t affinity_set = tskNO_AFFINITY) {
-    return [=](auto go) { return Task(go, name, priority, stack_depth, affinity_set); };
+    return [=, &storage](auto go) { return Task(go, name, priority, storage, affinity_set); };
 }
 
 template <typename A, typename Period>
@@ -0,0 +1,32 @@
+#include "timer.hpp"
+#include "pico.h"  // IWYU pragma: keep [panic]
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+using namespace std;
+
+namespace nevermore {
+
+#if NEVERMORE_STATIC_ALLOCATION
+
+namespace {
+
+// Bump this if you add more timers.
+constexpr size_t TIMERS_MAX = 16;
+
+array<StaticTimer_t, TIMERS_MAX> g_timers;
+atomic<size_t> g_timers_used = 0;
+
+}  // namespace
+
+StaticTimer_t& timer_storage_next() {
+    auto i = g_timers_used++;
+    if (TIMERS_MAX <= i) panic("PANIC - static timer pool exhausted\n");
+
+    return g_timers.at(i);
+}
+
+#endif
+
+}  // namespace nevermore
@@ -7,11 +7,21 @@
 
 namespace nevermore {
 
+#if NEVERMORE_STATIC_ALLOCATION
+// Timers are never deleted, so they're carved out of a fixed pool. Panics if the pool is exhausted.
+StaticTimer_t& timer_storage_next();
+#endif
+
 template <typename A, typename Period>
 consteval auto mk_timer(char const* name, std::chrono::duration<A, Period> period, bool one_shot = false) {
     auto ticks = to_ticks_safe(period);
     return [=](TimerCallbackFunction_t go) {
+#if NEVERMORE_STATIC_ALLOCATION
+        auto x = xTimerCreateStatic(name, ticks, one_shot ? pdFALSE : pdTRUE, reinterpret_cast<void*>(go), go,
+                &timer_storage_next());
+#else
         auto x = xTimerCreate(name, ticks, one_shot ? pdFALSE : pdTRUE, reinterpret_cast<void*>(go), go);
+#endif
         if (x) xTimerStart(x, 0);
         return x;
     };
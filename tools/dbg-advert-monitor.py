@@ -0,0 +1,89 @@
+#!/bin/bash
+"true" '''\'
+set -eu
+set -o pipefail
+
+FILE="$(readlink -f "$0")"
+ROOT_DIR="$(dirname "$FILE")"
+
+"$ROOT_DIR/setup-tool-env.bash"
+"$ROOT_DIR/.venv/bin/python" "$FILE" "$@"
+
+exit 0 # required to stop shell execution here
+'''
+
+
+# Passively monitors controllers broadcasting telemetry in their advertisements
+#
+# Copyright (C) 2023       Sanaa Hamel
+#
+# This file may be distributed under the terms of the GNU AGPLv3 license.
+
+__doc__ = """Passively monitors controllers broadcasting telemetry in their advertisements.
+
+Controllers only broadcast telemetry if `advertise_telemetry` is enabled (see README).
+No connection is made, so any number of hosts can monitor any number of controllers.
+"""
+
+import asyncio
+import datetime
+from typing import Optional
+
+import typed_argparse as tap
+from bleak import BleakScanner
+from bleak.backends.device import BLEDevice
+from bleak.backends.scanner import AdvertisementData
+from nevermore_utilities import *
+
+
+class CmdLnArgs(tap.TypedArgs):
+    bt_address: Optional[str] = tap.arg(help="only show this device")
+
+
+def _fmt(x: Optional[float], fmt: str) -> str:
+    return "---" if x is None else format(x, fmt)
+
+
+async def _main(args: CmdLnArgs):
+    if args.bt_address is not None and not bt_address_validate(args.bt_address):
+        exit("invalid address for `--bt-address`")
+
+    def on_advert(device: BLEDevice, advert: AdvertisementData):
+        address = args.bt_address
+        if address is not None and device.address.upper() != address.upper():
+            return
+
+        raw = advert.service_data.get(str(UUID_SERVICE_ENVIRONMENTAL_SENSING))
+        if raw is None:
+            return
+
+        x = AdvertTelemetry.parse(BleAttrReader(bytearray(raw)))
+        if x is None:
+            return
+
+        speed = None if x.fan.speed is None else x.fan.speed * 100
+        print(
+            f"{datetime.datetime.now():%H:%M:%S} {device.address} rssi={advert.rssi}"
+            f" voc={_fmt(x.voc_index_intake, 'd')}/{_fmt(x.voc_index_exhaust, 'd')}"
+            f" temperature={_fmt(x.temperature_intake, '.1f')}/{_fmt(x.temperature_exhaust, '.1f')}C"
+            f" fan={_fmt(speed, '.0f')}% rpm={_fmt(x.fan.rpm, 'd')}"
+        )
+
+    print("scanning...")
+    async with BleakScanner(detection_callback=on_advert):
+        while True:
+            await asyncio.sleep(1)
+
+
+def main():
+    def go(args: CmdLnArgs):
+        try:
+            asyncio.run(_main(args))
+        except KeyboardInterrupt:
+            pass
+
+    tap.Parser(CmdLnArgs).bind(go).run()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,139 @@
+#!/bin/bash
+"true" '''\'
+set -eu
+set -o pipefail
+
+FILE="$(readlink -f "$0")"
+ROOT_DIR="$(dirname "$FILE")"
+
+"$ROOT_DIR/setup-tool-env.bash"
+"$ROOT_DIR/.venv/bin/python" "$FILE" "$@"
+
+exit 0 # required to stop shell execution here
+'''
+
+# Measures BLE throughput & latency against a controller
+#
+# Copyright (C) 2023       Sanaa Hamel
+#
+# This file may be distributed under the terms of the GNU AGPLv3 license.
+
+__doc__ = """Measures BLE throughput & latency against a controller.
+
+Streams WS2812 update spans (write w/o response, same as Klipper's LED updates) as fast as the link allows,
+then measures bulk state read round trips in both the streaming and idle connection profiles.
+The controller also logs the negotiated MTU/PHY/data length/interval and its own view of the stream rate
+over its serial console.
+
+Stop Klipper (or anything else that's connected) first; this overwrites the WS2812 chain length and contents.
+"""
+
+import asyncio
+import statistics
+import time
+from typing import List
+
+import typed_argparse as tap
+from bleak import BleakClient
+from nevermore_tool_utilities import NevermoreToolCmdLnArgs
+from nevermore_utilities import *
+
+ATT_WRITE_HEADER = 3  # opcode + handle
+WS2812_SPAN_HEADER = 2  # offset + length
+WS2812_SPAN_MAX = 255  # offset & length are u8
+# controller reverts to the idle profile after this long w/o LED updates
+# see `STREAMING_IDLE_AFTER` in `src/gatt/connection.cpp`
+CONNECTION_STREAMING_IDLE_AFTER = 5
+
+
+class CmdLnArgs(NevermoreToolCmdLnArgs):
+    components: int = tap.arg(
+        default=3 * 64, help="# of WS2812 components (octets) to stream"
+    )
+    duration: float = tap.arg(default=10, help="seconds to stream for")
+    reads: int = tap.arg(default=20, help="# of bulk state reads per profile")
+
+
+async def _benchmark(client: BleakClient, args: CmdLnArgs):
+    service_ws2812 = client.services.get_service(UUID_SERVICE_WS2812)
+    service_status = client.services.get_service(UUID_SERVICE_STATUS)
+    assert service_ws2812 is not None and service_status is not None
+    ws2812_length = service_ws2812.get_characteristic(UUID_CHAR_COUNT16)
+    ws2812_update = service_ws2812.get_characteristic(UUID_CHAR_WS2812_UPDATE)
+    bulk_state = service_status.get_characteristic(UUID_CHAR_STATUS_BULK)
+    assert ws2812_length is not None and ws2812_update is not None
+    assert bulk_state is not None
+
+    mtu = client.mtu_size
+    span_max = min(WS2812_SPAN_MAX, mtu - ATT_WRITE_HEADER - WS2812_SPAN_HEADER)
+    print(f"MTU={mtu}, span max={span_max} octets")
+
+    await client.write_gatt_char(
+        ws2812_length, args.components.to_bytes(2, "little"), response=True
+    )
+
+    frames = 0
+    writes = 0
+    octets = 0
+    t_begin = time.monotonic()
+    while time.monotonic() - t_begin < args.duration:
+        value = frames % 32  # keep it dim
+        for offset in range(0, args.components, span_max):
+            length = min(span_max, args.components - offset)
+            params = bytearray([offset, length]) + bytes([value] * length)
+            await client.write_gatt_char(ws2812_update, params, response=False)
+            writes += 1
+            octets += len(params)
+        frames += 1
+    # one write w/ response to make sure everything actually made it across
+    await client.write_gatt_char(
+        ws2812_length, args.components.to_bytes(2, "little"), response=True
+    )
+    dur = time.monotonic() - t_begin
+
+    print(
+        f"streamed {frames} frames, {writes} writes, {octets} octets in {dur:.2f} s:"
+        f" {frames / dur:.1f} FPS, {writes / dur:.1f} writes/s, {octets / 1024 / dur:.2f} KiB/s"
+    )
+
+    async def read_rtt(profile: str):
+        xs: List[float] = []
+        for _ in range(args.reads):
+            t = time.monotonic()
+            await client.read_gatt_char(bulk_state)
+            xs.append((time.monotonic() - t) * 1000)
+
+        print(
+            f"bulk state read RTT ({profile}): mean={statistics.mean(xs):.1f} ms"
+            f" min={min(xs):.1f} ms max={max(xs):.1f} ms"
+        )
+
+    await read_rtt("streaming")
+
+    print("waiting for controller to switch to idle profile...")
+    await asyncio.sleep(CONNECTION_STREAMING_IDLE_AFTER + 2)
+    await read_rtt("idle")
+
+
+async def _main(args: CmdLnArgs):
+    if not args.validate():
+        exit(1)
+
+    address = await args.bt_address_discover()
+    if address is None:
+        exit(1)
+
+    print(f"connecting to {address}")
+    async with BleakClient(address) as client:
+        await _benchmark(client, args)
+
+
+def main():
+    def go(args: CmdLnArgs):
+        asyncio.run(_main(args))
+
+    tap.Parser(CmdLnArgs).bind(go).run()
+
+
+if __name__ == "__main__":
+    main()
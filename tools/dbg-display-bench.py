@@ -0,0 +1,130 @@
+#!/bin/bash
+"true" """\'
+set -eu
+set -o pipefail
+
+FILE="$(readlink -f "$0")"
+ROOT_DIR="$(dirname "$FILE")"
+
+"$ROOT_DIR/setup-tool-env.bash"
+"$ROOT_DIR/.venv/bin/python" "$FILE" "$@"
+
+exit 0 # required to stop shell execution here
+"""
+
+# Compares the display buffering strategies on a controller
+#
+# Copyright (C) 2023       Sanaa Hamel
+#
+# This file may be distributed under the terms of the GNU AGPLv3 license.
+
+__doc__ = """Compares the display buffering strategies on a controller.
+
+For each strategy: selects it, reboots the controller, lets the UI run for a while, and reports the
+frame rate, flushes per frame, and render time per frame from the controller's display stats.
+The UI only redraws when something changes (mostly sensor updates), so the frame rate mostly reflects
+UI activity. Render time per frame (and the implied max FPS) is what to compare.
+
+The draw arena is fixed at build time (`NEVERMORE_DISPLAY_DRAW_ARENA_LINES`). Strategies which don't fit
+fall back to one that does, the `active` column shows what actually ran.
+The original setting is restored afterwards.
+"""
+
+import asyncio
+from typing import List
+
+import typed_argparse as tap
+from bleak import BleakClient
+from nevermore_tool_utilities import NevermoreToolCmdLnArgs
+from nevermore_utilities import *
+
+REBOOT_WAIT = 10  # seconds, boot + sensor probing + UI init
+
+
+class CmdLnArgs(NevermoreToolCmdLnArgs):
+    duration: float = tap.arg(default=30, help="seconds to sample each strategy for")
+    strategies: List[str] = tap.arg(
+        default=[x.name for x in DisplayBuffering],
+        help="strategies to compare",
+    )
+
+
+def _chars(client: BleakClient):
+    service = client.services.get_service(UUID_SERVICE_DISPLAY)
+    assert service is not None
+    buffering = service.get_characteristic(UUID_CHAR_DISPLAY_BUFFERING)
+    stats = service.get_characteristic(UUID_CHAR_DISPLAY_STATS)
+    if buffering is None or stats is None:
+        print("controller doesn't support display buffering, update its firmware")
+        exit(1)
+
+    return buffering, stats
+
+
+async def _select_and_reboot(address: str, buffering: DisplayBuffering):
+    async with BleakClient(address) as client:
+        char_buffering, _ = _chars(client)
+        await client.write_gatt_char(
+            char_buffering, bytes([buffering.value]), response=True
+        )
+        # reboot also persists settings
+        await client.write_gatt_char(UUID_CHAR_CONFIG_REBOOT, b"\x00", response=True)
+
+    await asyncio.sleep(REBOOT_WAIT)
+
+
+async def _measure(address: str, args: CmdLnArgs):
+    async with BleakClient(address) as client:
+        _, char_stats = _chars(client)
+        s0 = DisplayStats.parse(BleAttrReader(await client.read_gatt_char(char_stats)))
+        await asyncio.sleep(args.duration)
+        s1 = DisplayStats.parse(BleAttrReader(await client.read_gatt_char(char_stats)))
+
+    frames = s1.frames - s0.frames
+    ms_per_frame = (s1.render_ms - s0.render_ms) / frames if frames else 0
+    print(
+        f" {s1.buffering.name:<14} {s1.draw_arena_size:>8}"
+        f" {frames / args.duration:>6.1f}"
+        f" {(s1.flushes - s0.flushes) / max(frames, 1):>8.1f}"
+        f" {ms_per_frame:>8.1f} {1000 / ms_per_frame if ms_per_frame else 0:>8.1f}"
+        f" {(s1.pixels - s0.pixels) / max(frames, 1):>9.0f}"
+    )
+
+
+async def _main(args: CmdLnArgs):
+    if not args.validate():
+        exit(1)
+
+    strategies = [DisplayBuffering[x.upper()] for x in args.strategies]
+
+    address = await args.bt_address_discover()
+    if address is None:
+        exit(1)
+
+    async with BleakClient(address) as client:
+        char_buffering, _ = _chars(client)
+        original = DisplayBuffering((await client.read_gatt_char(char_buffering))[0])
+
+    print(f"sampling each strategy for {args.duration} s (original: {original.name})")
+    print(
+        f"  {'requested':<14} {'active':<14} {'arena':>8} {'FPS':>6}"
+        f" {'flush/fr':>8} {'ms/fr':>8} {'max FPS':>8} {'px/fr':>9}"
+    )
+    try:
+        for buffering in strategies:
+            await _select_and_reboot(address, buffering)
+            print(f"  {buffering.name:<14}", end="")
+            await _measure(address, args)
+    finally:
+        await _select_and_reboot(address, original)
+
+
+def main():
+    def go(args: CmdLnArgs):
+        asyncio.run(_main(args))
+
+    tap.Parser(CmdLnArgs).bind(go).run()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,152 @@
+#!/bin/bash
+"true" """\'
+set -eu
+set -o pipefail
+
+FILE="$(readlink -f "$0")"
+ROOT_DIR="$(dirname "$FILE")"
+
+"$ROOT_DIR/setup-tool-env.bash"
+"$ROOT_DIR/.venv/bin/python" "$FILE" "$@"
+
+exit 0 # required to stop shell execution here
+"""
+
+# Measures ATT read round trips for every readable attribute on a controller
+#
+# Copyright (C) 2024       Sanaa Hamel
+#
+# This file may be distributed under the terms of the GNU AGPLv3 license.
+
+__doc__ = """Measures ATT read round trips for every readable attribute on a controller.
+
+Reads every readable characteristic value & descriptor, in handle order, and reports the round trip per
+attribute & per service. Useful for spotting handlers that are slow to answer (e.g. the dispatch in
+`src/gatt.cpp`, or a handler doing too much work per read).
+
+Round trips are dominated by the connection interval. Compare attributes against each other, not against
+an absolute number. Only reads: safe to run against a controller that's in use, though it adds link load.
+
+`--serial <path>` benchmarks the wired (USB CDC) transport instead, same attributes & handlers.
+"""
+
+import asyncio
+import statistics
+import time
+from dataclasses import dataclass, field
+from typing import Awaitable, Callable, Dict, List, Optional, Union
+
+import typed_argparse as tap
+from bleak import BleakClient
+from nevermore_tool_utilities import NevermoreToolCmdLnArgs
+from nevermore_utilities import *
+
+
+class CmdLnArgs(NevermoreToolCmdLnArgs):
+    reads: int = tap.arg(default=10, help="# of reads per attribute")
+    slowest: int = tap.arg(default=10, help="# of slowest attributes to list")
+    serial: Optional[str] = tap.arg(help="use the wired transport on this serial port")
+
+
+@dataclass
+class Attribute:
+    handle: int
+    service: str
+    name: str
+    read: Callable[[], Awaitable[bytearray]]
+    rtts: List[float] = field(default_factory=list)  # ms
+
+
+Client = Union[BleakClient, SerialGattClient]
+
+
+def _attributes(client: Client) -> List[Attribute]:
+    xs: List[Attribute] = []
+    for service in client.services:
+        for char in service.characteristics:
+            if "read" in char.properties:
+                xs.append(
+                    Attribute(
+                        char.handle,
+                        service.description,
+                        char.description,
+                        lambda char=char: client.read_gatt_char(char),
+                    )
+                )
+
+            for desc in char.descriptors:
+                xs.append(
+                    Attribute(
+                        desc.handle,
+                        service.description,
+                        f"{char.description} / {desc.description}",
+                        lambda desc=desc: client.read_gatt_descriptor(desc.handle),
+                    )
+                )
+
+    return sorted(xs, key=lambda x: x.handle)
+
+
+async def _benchmark(client: Client, args: CmdLnArgs):
+    attrs = _attributes(client)
+    print(f"MTU={client.mtu_size}, {len(attrs)} readable attributes")
+
+    t_begin = time.monotonic()
+    for attr in attrs:
+        for _ in range(args.reads):
+            t = time.monotonic()
+            await attr.read()
+            attr.rtts.append((time.monotonic() - t) * 1000)
+    dur = time.monotonic() - t_begin
+
+    reads = len(attrs) * args.reads
+    print(f"{reads} reads in {dur:.2f} s: {reads / dur:.1f} reads/s")
+
+    by_service: Dict[str, List[float]] = {}
+    for attr in attrs:
+        by_service.setdefault(attr.service, []).extend(attr.rtts)
+
+    print("\nper service:")
+    for service, rtts in by_service.items():
+        print(
+            f"  {service:40} mean={statistics.mean(rtts):6.1f} ms"
+            f" min={min(rtts):6.1f} ms max={max(rtts):6.1f} ms"
+        )
+
+    print(f"\nslowest {args.slowest} attributes (by median):")
+    slowest = sorted(attrs, key=lambda x: statistics.median(x.rtts), reverse=True)
+    for attr in slowest[: args.slowest]:
+        print(
+            f"  0x{attr.handle:04x} {attr.name:50} median={statistics.median(attr.rtts):6.1f} ms"
+            f" max={max(attr.rtts):6.1f} ms"
+        )
+
+
+async def _main(args: CmdLnArgs):
+    if not args.validate():
+        exit(1)
+
+    if args.serial is not None:
+        print(f"connecting to {args.serial}")
+        async with SerialGattClient(args.serial) as client:
+            await _benchmark(client, args)
+        return
+
+    address = await args.bt_address_discover()
+    if address is None:
+        exit(1)
+
+    print(f"connecting to {address}")
+    async with BleakClient(address) as client:
+        await _benchmark(client, args)
+
+
+def main():
+    def go(args: CmdLnArgs):
+        asyncio.run(_main(args))
+
+    tap.Parser(CmdLnArgs).bind(go).run()
+
+
+if __name__ == "__main__":
+    main()
@@ -296,22 +296,21 @@ async def _main_bluetooth(log: GraphiteLogger, address: Optional[str]):
         return
 
     async def _log_sensors(client: BleakClient):
-        service_env = client.services.get_service(UUID_SERVICE_ENVIRONMENTAL_SENSING)
-        service_fan = client.services.get_service(UUID_SERVICE_FAN)
-        assert service_env is not None
-        assert service_fan is not None
-        char_env = service_env.get_characteristic(UUID_CHAR_DATA_AGGREGATE)
-        char_fan = service_fan.get_characteristic(UUID_CHAR_FAN_AGGREGATE)
-        assert char_env is not None
-        assert char_fan is not None
+        service_status = client.services.get_service(UUID_SERVICE_STATUS)
+        assert service_status is not None
+        char_bulk = service_status.get_characteristic(UUID_CHAR_STATUS_BULK)
+        assert char_bulk is not None
 
         async def snapshot() -> SystemSnapshot:
-            intake, exhaust = SensorState.parse(
-                BleAttrReader(await client.read_gatt_char(char_env))
-            )
-            fan = FanState.parse(BleAttrReader(await client.read_gatt_char(char_fan)))
+            state = BulkState.parse(BleAttrReader(await client.read_gatt_char(char_bulk)))
+            fan = state.fan or FanState()
             sensors = _extract_fields(
-                ControllerState(intake, exhaust, fan.speed or 0, fan.rpm or 0).as_dict()
+                ControllerState(
+                    state.intake or SensorState(),
+                    state.exhaust or SensorState(),
+                    fan.speed or 0,
+                    fan.rpm or 0,
+                ).as_dict()
             )
 
             return SystemSnapshot(address.replace(":", "-"), {"nevermore": sensors})
@@ -0,0 +1,111 @@
+#!/bin/bash
+"true" """\'
+set -eu
+set -o pipefail
+
+FILE="$(readlink -f "$0")"
+ROOT_DIR="$(dirname "$FILE")"
+
+"$ROOT_DIR/setup-tool-env.bash"
+"$ROOT_DIR/.venv/bin/python" "$FILE" "$@"
+
+exit 0 # required to stop shell execution here
+"""
+
+# Reports the controller CPU cost per PIO I2C transaction, polled vs DMA
+#
+# Copyright (C) 2024       Sanaa Hamel
+#
+# This file may be distributed under the terms of the GNU AGPLv3 license.
+
+__doc__ = """Reports the controller CPU cost per PIO I2C transaction, polled vs DMA.
+
+Samples the status bulk state's diagnostics counters twice, `--period` seconds apart, and divides the
+core time spent on each path by its # of transactions. Polled transactions spin for the whole transfer,
+DMA ones only pay for encoding, setup, teardown & the completion IRQ.
+Needs a controller w/ a sensor bus on PIO (i.e. more buses than free HW I2C controllers).
+"""
+
+import asyncio
+from typing import Optional
+
+import typed_argparse as tap
+from bleak import BleakClient
+from nevermore_tool_utilities import NevermoreToolCmdLnArgs
+from nevermore_utilities import *
+
+
+class CmdLnArgs(NevermoreToolCmdLnArgs):
+    period: float = tap.arg(default=60, help="seconds between samples")
+
+
+U32 = 1 << 32
+
+
+def _per_transaction(
+    n0: Optional[int], us0: Optional[int], n1: Optional[int], us1: Optional[int]
+) -> str:
+    assert n0 is not None and us0 is not None and n1 is not None and us1 is not None
+    n = (n1 - n0) % U32  # counters wrap
+    us = (us1 - us0) % U32
+    if n == 0:
+        return "no transactions"
+    return f"{n:>8} transactions, {us / n:>8.1f} us CPU each"
+
+
+async def _report(client: BleakClient, args: CmdLnArgs):
+    service = client.services.get_service(UUID_SERVICE_STATUS)
+    assert service is not None
+    char = service.get_characteristic(UUID_CHAR_STATUS_BULK)
+    assert char is not None
+
+    async def sample() -> BulkState:
+        return BulkState.parse(BleAttrReader(await client.read_gatt_char(char)))
+
+    a = await sample()
+    if a.i2c_pio_polled is None:
+        print("controller doesn't report PIO I2C stats, update its firmware")
+        exit(1)
+
+    await asyncio.sleep(args.period)
+    b = await sample()
+
+    print(f"over {args.period:.0f} s:")
+    print(
+        "  polled: "
+        + _per_transaction(
+            a.i2c_pio_polled,
+            a.i2c_pio_polled_cpu_us,
+            b.i2c_pio_polled,
+            b.i2c_pio_polled_cpu_us,
+        )
+    )
+    print(
+        "  DMA:    "
+        + _per_transaction(
+            a.i2c_pio_dma, a.i2c_pio_dma_cpu_us, b.i2c_pio_dma, b.i2c_pio_dma_cpu_us
+        )
+    )
+
+
+async def _main(args: CmdLnArgs):
+    if not args.validate():
+        exit(1)
+
+    address = await args.bt_address_discover()
+    if address is None:
+        exit(1)
+
+    async with BleakClient(address) as client:
+        await _report(client, args)
+
+
+def main():
+    def go(args: CmdLnArgs):
+        asyncio.run(_main(args))
+
+    tap.Parser(CmdLnArgs).bind(go).run()
+
+
+if __name__ == "__main__":
+    main()
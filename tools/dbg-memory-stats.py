@@ -0,0 +1,92 @@
+#!/bin/bash
+"true" """\'
+set -eu
+set -o pipefail
+
+FILE="$(readlink -f "$0")"
+ROOT_DIR="$(dirname "$FILE")"
+
+"$ROOT_DIR/setup-tool-env.bash"
+"$ROOT_DIR/.venv/bin/python" "$FILE" "$@"
+
+exit 0 # required to stop shell execution here
+"""
+
+# Reads a controller's heap & per-task stack high-water marks
+#
+# Copyright (C) 2023       Sanaa Hamel
+#
+# This file may be distributed under the terms of the GNU AGPLv3 license.
+
+__doc__ = """Reads a controller's heap & per-task stack high-water marks.
+
+The runtime counterpart to `memory-report.py`: that covers static RAM & flash, this covers what's
+used out of the FreeRTOS heap and how close each task has come to overflowing its stack.
+Pass `--stack-margin` to exit w/ an error if any task has less stack headroom than that (e.g. for CI
+hardware-in-the-loop checks).
+"""
+
+import asyncio
+
+import typed_argparse as tap
+from bleak import BleakClient
+from nevermore_tool_utilities import NevermoreToolCmdLnArgs
+from nevermore_utilities import *
+
+
+class CmdLnArgs(NevermoreToolCmdLnArgs):
+    stack_margin: int = tap.arg(
+        default=0, help="fail if a task has fewer than this many stack bytes spare"
+    )
+
+
+async def _report(client: BleakClient, args: CmdLnArgs):
+    service = client.services.get_service(UUID_SERVICE_STATUS)
+    assert service is not None
+    char = service.get_characteristic(UUID_CHAR_STATUS_MEMORY)
+    if char is None:
+        print("controller doesn't expose memory stats, update its firmware")
+        exit(1)
+
+    report = MemoryReport.parse(BleAttrReader(await client.read_gatt_char(char)))
+    heap_used = report.heap_size - report.heap_free
+    heap_used_max = report.heap_size - report.heap_free_min
+    print(
+        f"heap: {heap_used} / {report.heap_size} bytes used,"
+        f" peak {heap_used_max} ({100 * heap_used_max / report.heap_size:.1f}%)"
+    )
+
+    print("\nstack free (min ever):")
+    for task in sorted(report.tasks, key=lambda x: x.stack_free_min):
+        print(f"  {task.stack_free_min:>6}  {task.name}")
+
+    tight = [x for x in report.tasks if x.stack_free_min < args.stack_margin]
+    for task in tight:
+        print(
+            f"STACK MARGIN - {task.name}: {task.stack_free_min} < {args.stack_margin}"
+        )
+    if tight:
+        exit(1)
+
+
+async def _main(args: CmdLnArgs):
+    if not args.validate():
+        exit(1)
+
+    address = await args.bt_address_discover()
+    if address is None:
+        exit(1)
+
+    async with BleakClient(address) as client:
+        await _report(client, args)
+
+
+def main():
+    def go(args: CmdLnArgs):
+        asyncio.run(_main(args))
+
+    tap.Parser(CmdLnArgs).bind(go).run()
+
+
+if __name__ == "__main__":
+    main()
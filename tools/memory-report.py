@@ -0,0 +1,376 @@
+#!/bin/bash
+"true" """\'
+set -eu
+set -o pipefail
+
+FILE="$(readlink -f "$0")"
+ROOT_DIR="$(dirname "$FILE")"
+
+"$ROOT_DIR/setup-tool-env.bash"
+"$ROOT_DIR/.venv/bin/python" "$FILE" "$@"
+
+exit 0 # required to stop shell execution here
+"""
+
+# Summarises static RAM & flash usage from a linker map file
+#
+# Copyright (C) 2023       Sanaa Hamel
+#
+# This file may be distributed under the terms of the GNU AGPLv3 license.
+
+__doc__ = """Summarises static RAM & flash usage from a linker map file.
+
+The map is written next to the ELF by the build (e.g. `build/nevermore-controller_pico_w.elf.map`).
+The `nevermore-controller-memory-report` build target runs this against the current build.
+
+Pass `--baseline` w/ another build's map to see what moved, e.g. comparing a default build against one
+configured w/ `-DNEVERMORE_STATIC_ALLOCATION=ON`, or against the previous commit's build in CI.
+Pass `--budget` w/ a JSON file to fail if a subsystem goes over budget, e.g.:
+    { "ram": { "display": 60000, "total": 200000 }, "flash": { "lvgl": 300000 } }
+
+NB: The FreeRTOS heap (`ucHeap`) is itself a static allocation, it's reported as its own subsystem.
+    Use `dbg-memory-stats.py` to see how much of it is used at runtime.
+"""
+
+import json
+import re
+import shutil
+import subprocess
+import sys
+from collections import defaultdict
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Callable, Dict, List, Optional
+
+import typed_argparse as tap
+
+# FreeRTOS heap_4's arena
+HEAP_SYMBOL = "ucHeap"
+
+# First match wins. Matched against the object path (archive members: `lib.a(member)`).
+SUBSYSTEMS = [
+    ("ws2812", r"/src/(gatt/)?ws2812\."),
+    ("gatt", r"/src/gatt[./]|/src/nevermore\.gatt"),
+    ("display", r"/src/(display|ui)[./]"),
+    ("sensors", r"/src/(sensors[./]|lib/(bme|bmp|sensirion|pio_i2c)|sdk/i2c)"),
+    ("settings", r"/src/(settings|config/pins)\."),
+    ("lvgl", r"lvgl"),
+    ("btstack", r"btstack"),
+    ("cyw43", r"cyw43"),
+    ("freertos", r"freertos|FreeRTOS"),
+    ("picowota", r"picowota"),
+    ("libc", r"lib(c|m|g|gcc|nosys|stdc\+\+|supc\+\+)(_nano)?\.a\("),
+    ("pico-sdk", r"pico-sdk|pico_|hardware_|/rp2_common/|/rp2040/|/common/|/tinyusb/"),
+    ("misc", r"/src/"),
+]
+
+RE_REGION = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+RE_OUTPUT_SECTION = re.compile(r"^(\.\S+)")
+RE_LOAD_ADDRESS = re.compile(r"load address 0x([0-9a-fA-F]+)")
+RE_INPUT_SECTION = re.compile(
+    r"^ (\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+(.*))?)?$"
+)
+RE_CONTINUATION = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+(.*))?$")
+RE_ARCHIVE_MEMBER = re.compile(r"^.*/(.+?\.a)\((.+)\)$")
+
+
+@dataclass
+class Region:
+    name: str
+    origin: int
+    length: int
+
+    def contains(self, addr: int) -> bool:
+        return self.origin <= addr < self.origin + self.length
+
+
+@dataclass
+class Chunk:
+    output: str
+    section: str
+    addr: int
+    size: int
+    obj: str
+    ram: bool = False
+    flash: bool = False  # code, read-only data, or initialisers for RAM
+
+
+@dataclass
+class MapFile:
+    regions: List[Region] = field(default_factory=list)
+    chunks: List[Chunk] = field(default_factory=list)
+
+    def region_of(self, addr: int) -> Optional[Region]:
+        return next((r for r in self.regions if r.contains(addr)), None)
+
+    def ram(self) -> List[Chunk]:
+        return [x for x in self.chunks if x.ram]
+
+    def flash(self) -> List[Chunk]:
+        return [x for x in self.chunks if x.flash]
+
+
+def object_name(path: str) -> str:
+    # `.../libfoo.a(bar.o)` -> `libfoo.a(bar.o)`
+    # `.../src/bar.cpp.obj` -> `src/bar.cpp.obj`
+    if m := RE_ARCHIVE_MEMBER.match(path):
+        return f"{m.group(1)}({m.group(2)})"
+    parts = Path(path).parts
+    if "src" in parts:
+        return str(Path(*parts[parts.index("src") :]))
+    return Path(path).name
+
+
+def subsystem(x: Chunk) -> str:
+    if x.section.endswith(HEAP_SYMBOL):
+        return "freertos-heap"
+    if x.obj == "*fill*":
+        return "padding"
+    for name, pattern in SUBSYSTEMS:
+        if re.search(pattern, x.obj):
+            return name
+    return "other"
+
+
+def parse(path: Path) -> MapFile:
+    out = MapFile()
+    lines = path.read_text(errors="replace").splitlines()
+
+    i = 0
+    while i < len(lines) and lines[i].strip() != "Memory Configuration":
+        i += 1
+    i += 3  # title, blank, column header
+    while i < len(lines) and lines[i].strip():
+        if m := RE_REGION.match(lines[i]):
+            if m.group(1) != "*default*":
+                out.regions.append(
+                    Region(m.group(1), int(m.group(2), 16), int(m.group(3), 16))
+                )
+        i += 1
+
+    while i < len(lines) and lines[i].strip() != "Linker script and memory map":
+        i += 1
+
+    def is_flash(addr: int) -> bool:
+        region = out.region_of(addr)
+        return region is not None and region.name == "FLASH"
+
+    def add(name: str, addr: int, size: int, obj: str):
+        region = out.region_of(addr)
+        if not size or region is None:
+            return
+        ram = region.name != "FLASH"
+        flash = not ram or output_load_flash
+        out.chunks.append(Chunk(output, name, addr, size, obj, ram=ram, flash=flash))
+
+    output = ""
+    output_load_flash = (
+        False  # output section is copied from flash at boot (e.g. `.data`)
+    )
+    output_pending = False  # long output section name w/ its addresses on the next line
+    pending: Optional[str] = (
+        None  # input section name w/ its addr/size on the next line
+    )
+    for line in lines[i:]:
+        if m := RE_OUTPUT_SECTION.match(line):
+            output = m.group(1)
+            load = RE_LOAD_ADDRESS.search(line)
+            output_load_flash = load is not None and is_flash(int(load.group(1), 16))
+            output_pending = line.strip() == output
+            pending = None
+            continue
+
+        if output_pending:
+            output_pending = False
+            if load := RE_LOAD_ADDRESS.search(line):
+                output_load_flash = is_flash(int(load.group(1), 16))
+                continue
+
+        if pending is not None:
+            if m := RE_CONTINUATION.match(line):
+                add(pending, int(m.group(1), 16), int(m.group(2), 16), m.group(3) or "")
+            pending = None
+            continue
+
+        if m := RE_INPUT_SECTION.match(line):
+            name = m.group(1)
+            if name.startswith("*") and name != "*fill*":
+                continue  # input section patterns, e.g. `*(.bss*)`
+            if m.group(2) is None:
+                pending = name
+                continue
+
+            obj = "*fill*" if name == "*fill*" else (m.group(4) or "").strip()
+            add(name, int(m.group(2), 16), int(m.group(3), 16), obj)
+
+    return out
+
+
+def demangle(names: List[str]) -> Dict[str, str]:
+    tool = shutil.which("arm-none-eabi-c++filt") or shutil.which("c++filt")
+    if tool is None or not names:
+        return {x: x for x in names}
+
+    # strip the section prefix (e.g. `.bss.`) so c++filt sees the bare symbol
+    bare = [re.sub(r"^\.[a-z]+\.", "", x) for x in names]
+    result = subprocess.run(
+        [tool], input="\n".join(bare), capture_output=True, text=True, check=False
+    )
+    demangled = result.stdout.splitlines()
+    if len(demangled) != len(names):
+        return {x: x for x in names}
+    return dict(zip(names, demangled))
+
+
+def totals(chunks: List[Chunk], key: Callable[[Chunk], str]) -> Dict[str, int]:
+    xs: Dict[str, int] = defaultdict(int)
+    for x in chunks:
+        xs[key(x)] += x.size
+    return xs
+
+
+class CmdLnArgs(tap.TypedArgs):
+    map: Path = tap.arg(positional=True, help="linker map file")
+    baseline: Optional[Path] = tap.arg(help="map file to diff against")
+    budget: Optional[Path] = tap.arg(help="JSON file of per-subsystem byte limits")
+    top: int = tap.arg(default=25, help="# of entries to list per table")
+
+
+def print_table(
+    title: str, xs: Dict[str, int], base: Optional[Dict[str, int]], top: int
+):
+    print(f"\n{title}")
+    keys = set(xs) | set(base or {})
+
+    def delta(k: str) -> int:
+        return xs.get(k, 0) - (base or {}).get(k, 0)
+
+    if base is None:
+        order = sorted(keys, key=lambda k: -xs[k])
+    else:
+        order = sorted(keys, key=lambda k: -abs(delta(k)))
+
+    for k in order[:top]:
+        if base is None:
+            print(f"  {xs[k]:>8}  {k}")
+        elif delta(k):
+            print(f"  {xs.get(k, 0):>8}  {delta(k):>+8}  {k}")
+
+
+def print_subsystems(current: MapFile, baseline: Optional[MapFile]):
+    ram = totals(current.ram(), subsystem)
+    flash = totals(current.flash(), subsystem)
+    ram_base = totals(baseline.ram(), subsystem) if baseline else {}
+    flash_base = totals(baseline.flash(), subsystem) if baseline else {}
+
+    print("\nby subsystem:")
+    header = f"  {'':<14} {'RAM':>8} {'flash':>8}"
+    if baseline:
+        header += f" {'Δ RAM':>8} {'Δ flash':>8}"
+    print(header)
+
+    for k in sorted(set(ram) | set(flash), key=lambda k: (-ram.get(k, 0), k)):
+        row = f"  {k:<14} {ram.get(k, 0):>8} {flash.get(k, 0):>8}"
+        if baseline:
+            row += f" {ram.get(k, 0) - ram_base.get(k, 0):>+8}"
+            row += f" {flash.get(k, 0) - flash_base.get(k, 0):>+8}"
+        print(row)
+
+    row = f"  {'total':<14} {sum(ram.values()):>8} {sum(flash.values()):>8}"
+    if baseline:
+        row += f" {sum(ram.values()) - sum(ram_base.values()):>+8}"
+        row += f" {sum(flash.values()) - sum(flash_base.values()):>+8}"
+    print(row)
+
+
+# returns # of budget violations
+def check_budget(current: MapFile, budget: Dict[str, Dict[str, int]]) -> int:
+    used = {
+        "ram": totals(current.ram(), subsystem),
+        "flash": totals(current.flash(), subsystem),
+    }
+    violations = 0
+    for kind, limits in budget.items():
+        if kind not in used:
+            sys.exit(f"budget: unknown memory kind `{kind}`, expected `ram` or `flash`")
+
+        for name, limit in limits.items():
+            x = sum(used[kind].values()) if name == "total" else used[kind].get(name, 0)
+            if limit < x:
+                violations += 1
+                print(
+                    f"OVER BUDGET - {kind} {name}: {x} > {limit} bytes (+{x - limit})"
+                )
+
+    return violations
+
+
+def report(args: CmdLnArgs):
+    current = parse(args.map)
+    if not current.regions:
+        sys.exit(
+            f"{args.map}: no memory configuration found, is this a GNU ld map file?"
+        )
+
+    baseline = parse(args.baseline) if args.baseline else None
+    ram = current.ram()
+    ram_base = baseline.ram() if baseline else None
+
+    print("regions:")
+    for region in current.regions:
+        if region.name == "FLASH":  # includes initialisers for RAM
+            used = sum(x.size for x in current.flash())
+        else:
+            used = sum(x.size for x in ram if region.contains(x.addr))
+        print(
+            f"  {region.name:<12} {used:>8} / {region.length:>8} bytes"
+            f" ({100 * used / region.length:.1f}%)"
+        )
+
+    print_subsystems(current, baseline)
+
+    def by_section(chunks: List[Chunk]):
+        return totals(chunks, lambda x: x.output)
+
+    def by_object(chunks: List[Chunk]):
+        return totals(chunks, lambda x: object_name(x.obj))
+
+    def by_symbol(chunks: List[Chunk]):
+        return totals(chunks, lambda x: x.section)
+
+    print_table(
+        "RAM by output section:",
+        by_section(ram),
+        by_section(ram_base) if ram_base else None,
+        args.top,
+    )
+    print_table(
+        "RAM by object:",
+        by_object(ram),
+        by_object(ram_base) if ram_base else None,
+        args.top,
+    )
+
+    symbols = by_symbol(ram)
+    symbols_base = by_symbol(ram_base) if ram_base else None
+    names = demangle(sorted(set(symbols) | set(symbols_base or {})))
+    print_table(
+        "RAM by symbol:",
+        {names[k]: v for k, v in symbols.items()},
+        {names[k]: v for k, v in symbols_base.items()} if symbols_base else None,
+        args.top,
+    )
+
+    if args.budget:
+        print()
+        if check_budget(current, json.loads(args.budget.read_text())):
+            sys.exit(1)
+        print("within budget")
+
+
+def main():
+    tap.Parser(CmdLnArgs).bind(report).run()
+
+
+if __name__ == "__main__":
+    main()
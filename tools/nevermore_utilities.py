@@ -8,13 +8,17 @@ import asyncio
 import dataclasses
 import enum
 import logging
+import os
+import re
 import typing
+import zlib
 from dataclasses import dataclass
 from typing import (
     Any,
     Callable,
     Coroutine,
     Dict,
+    Generator,
     List,
     MutableMapping,
     Optional,
@@ -42,6 +46,7 @@ BOOTLOADER_NAME_PREFIX = "picowota "
 
 TIMESEC16_MAX = 2**16 - 2
 VOC_INDEX_MAX = 500
+NOX_INDEX_MAX = 500
 VOC_INDEX_NOT_KNOWN = 0
 VOC_RAW_MAX = 2**16 - 2
 
@@ -94,6 +99,7 @@ UUID_SERVICE_WS2812 = UUID("f62918ab-33b7-4f47-9fba-8ce9de9fecbb")
 UUID_SERVICE_FAN_POLICY = UUID("260a0845-e62f-48c6-aef9-04f62ff8bffd")
 UUID_SERVICE_DISPLAY = UUID("7be8ac4b-7eb4-4e09-b134-91a46b622832")
 UUID_SERVICE_PHOTOCATALYTIC = UUID("de44dd71-2400-4cd1-a3f3-9fb00c4697d7")
+UUID_SERVICE_STATUS = UUID("d903600a-c268-4225-a0f6-5659160acafc")
 
 UUID_CHAR_PERCENT8 = short_uuid(0x2B04)
 UUID_CHAR_COUNT16 = short_uuid(0x2AEA)
@@ -115,9 +121,17 @@ UUID_CHAR_CONFIG_CHECKPOINT_SENSOR_CALIBRATION = UUID(
 UUID_CHAR_CONFIG_RESET_SENSOR_CALIBRATION = UUID("75bf055c-02be-466f-8c7d-6ebc72078048")
 UUID_CHAR_CONFIG_VOC_CALIBRATE_ENABLED = UUID("ee786ac0-7700-47dd-b7de-9958f96303f2")
 UUID_CHAR_DISPLAY_UI = UUID("86a25d55-1893-4d01-8ea8-8970f622c243")
+UUID_CHAR_DISPLAY_BUFFERING = UUID("64eccc24-c2c0-45f2-a16e-446ac5a4b119")
+UUID_CHAR_DISPLAY_STATS = UUID("ecab8577-a8b9-48db-b810-405d1a1a234a")
 UUID_CHAR_CONFIG_PINS = UUID("2e9410cb-30fd-4b2c-8c95-934226a9ba29")
 UUID_CHAR_CONFIG_PINS_ERROR = UUID("0f6d7c4b-c30c-45b2-b32a-0e5b130429f0")
 UUID_CHAR_CONFIG_PINS_DEFAULT = UUID("5b1dc210-6a51-4cf9-bda7-085604199856")
+UUID_CHAR_FAN_CONTROL_MODE = UUID("2eaec573-8cbf-4542-a91a-f4a3eef1680c")
+UUID_CHAR_FAN_RPM_CURVE = UUID("4ec1d504-c202-41e0-a2c7-db810879c3d9")
+UUID_CHAR_FAN_FILTER_LOAD = UUID("79d66381-c112-4b5f-b9ae-8445c98836ca")
+UUID_CHAR_FILTER_LIFE = UUID("4df932ec-e8e4-4528-84e9-e443098b0f53")
+UUID_CHAR_STATUS_BULK = UUID("5054026d-913e-45fc-a1f6-0500b5c9ab8d")
+UUID_CHAR_STATUS_MEMORY = UUID("1a8f2c5e-6b3d-4e71-9c0a-7d24e5f81b36")
 
 
 class DisplayUI(enum.Enum):
@@ -126,6 +140,19 @@ class DisplayUI(enum.Enum):
     GC9A01_NO_PLOT = 2
 
 
+# see `DisplayBuffering` in `src/settings.hpp`
+class DisplayBuffering(enum.Enum):
+    DOUBLE_HALF = 0
+    DOUBLE_TENTH = 1
+    SINGLE_TENTH = 2
+    DIRECT_FULL = 3
+
+
+class FanControlMode(enum.Enum):
+    PWM = 0
+    RPM = 1
+
+
 # must be of the form `xx:xx:xx:xx:xx:xx`, where `x` is a hex digit (uppercase)
 # FUTURE WORK: Won't work on MacOS. It uses UUIDs to abstract/hide the BT address.
 def bt_address_validate(addr: str):
@@ -318,6 +345,9 @@ class BleAttrReader:
     def voc_index(self) -> Optional[int]:  # [1, VOC_INDEX_MAX]
         return self._as_int(self._unsigned(2, 1, 0, 0, not_known=0))
 
+    def nox_index(self) -> Optional[int]:  # [1, NOX_INDEX_MAX]
+        return self._as_int(self._unsigned(2, 1, 0, 0, not_known=0))
+
     def voc_index_threshold(self) -> Optional[int]:  # [0, 2**16-2]
         return self._as_int(self._unsigned(2, 1, 0, 0, not_known=0xFFFF))
 
@@ -331,6 +361,23 @@ class BleAttrReader:
     def fix16(self) -> float:  # [-2^15, 2^15-1]
         return self._unsigned(4, 1, 0, -15)
 
+    def uint8(self) -> int:
+        return int(self._unsigned(1, 1, 0, 0))
+
+    def uint16(self) -> int:
+        return int(self._unsigned(2, 1, 0, 0))
+
+    def uint32(self) -> int:
+        return int(self._unsigned(4, 1, 0, 0))
+
+    def bytes(self, n: int) -> bytearray:
+        if len(self.remaining) < n:
+            raise BleAttrReaderNotEnoughData("insufficient data remaining")
+
+        head = self.remaining[0:n]
+        self.remaining = self.remaining[n:]
+        return head
+
     @overload
     def _signed(self, sz: int, M: int, d: int, e: int) -> float: ...
 
@@ -484,6 +531,7 @@ class SensorState:
     gas_raw: Optional[int] = None  # [0, VOC_RAW_MAX]
     gas_raw_gia: Optional[GIAState] = None
     gas_raw_breakdown: Optional[VOCRawBreakdown] = None
+    nox: Optional[int] = None  # [1, NOX_INDEX_MAX]
 
     def as_dict(self) -> Dict[str, float]:
         d = {
@@ -519,6 +567,10 @@ class SensorState:
         voc_raw_out = reader.voc_raw()
         gia_in = GIAState.parse(reader)
         gia_out = GIAState.parse(reader)
+        nox_in = (
+            reader.nox_index() if reader.remaining else None
+        )  # added w/ SGP41 support
+        nox_out = reader.nox_index() if reader.remaining else None
         breakdown_in = VOCRawBreakdown.parse(reader) if reader.remaining else None
         breakdown_out = VOCRawBreakdown.parse(reader) if reader.remaining else None
 
@@ -529,13 +581,223 @@ class SensorState:
             p_out /= 100  # need it in hPa instead of Pa
 
         return (
-            SensorState(t_in, h_in, p_in, voc_in, voc_raw_in, gia_in, breakdown_in),
             SensorState(
-                t_out, h_out, p_out, voc_out, voc_raw_out, gia_out, breakdown_out
+                t_in, h_in, p_in, voc_in, voc_raw_in, gia_in, breakdown_in, nox_in
             ),
+            SensorState(
+                t_out,
+                h_out,
+                p_out,
+                voc_out,
+                voc_raw_out,
+                gia_out,
+                breakdown_out,
+                nox_out,
+            ),
+        )
+
+
+class BulkStateRecord(enum.IntEnum):
+    ENVIRONMENTAL = 0x01
+    FAN = 0x02
+    FAN_POLICY = 0x03
+    CONFIG = 0x04
+    FILTER = 0x05
+    DIAGNOSTICS = 0x06
+    ZONES = 0x07
+
+
+# see `src/sensors.hpp`, index into `BulkState.zones`
+class Zone(enum.IntEnum):
+    INTAKE = 0
+    EXHAUST = 1
+    CHAMBER = 2
+    AUXILIARY = 3
+
+
+# see `src/gatt/environmental.cpp` for the format
+def zones_parse(reader: BleAttrReader) -> List[SensorState]:
+    version = reader.uint8()
+    if version != 1:
+        raise Exception(f"unsupported environmental zones version {version}")
+
+    count = reader.uint8()
+    zone_size = reader.uint8()
+    _t_mcu = reader.temperature()  # unused/ignored
+
+    zones = []
+    for _ in range(count):
+        zone = BleAttrReader(
+            reader.bytes(zone_size)
+        )  # may have trailing fields we don't know about
+        temperature = zone.temperature()
+        humidity = zone.humidity()
+        pressure = zone.pressure()
+        voc = zone.voc_index()
+        voc_raw = zone.voc_raw()
+        nox = zone.nox_index()
+        zones.append(
+            SensorState(
+                temperature=temperature,
+                humidity=humidity,
+                pressure=None if pressure is None else pressure / 100,  # Pa -> hPa
+                gas=voc,
+                gas_raw=voc_raw,
+                nox=nox,
+            )
+        )
+
+    return zones
+
+
+# see `src/gatt/status.cpp` for the format
+@dataclass
+class BulkState:
+    VERSION = 1
+
+    intake: Optional[SensorState] = None
+    exhaust: Optional[SensorState] = None
+    zones: Optional[List[SensorState]] = None  # indexed by `Zone`
+    fan: Optional[FanState] = None
+    filter_life: Optional[float] = None  # [0, 1]
+    uptime: Optional[int] = None  # seconds
+    heap_free: Optional[int] = None  # bytes
+    heap_free_min: Optional[int] = None  # bytes
+    tick_interrupts: Optional[int] = None
+    tickless_sleeps: Optional[int] = None
+    ticks_slept: Optional[int] = None
+    sensor_reads: Optional[int] = None
+    sensor_reads_deferred: Optional[int] = None
+    i2c_transactions: Optional[int] = None
+    # PIO I2C buses, per path. `*_cpu_us` is controller core time spent on them.
+    i2c_pio_polled: Optional[int] = None
+    i2c_pio_polled_cpu_us: Optional[int] = None
+    i2c_pio_dma: Optional[int] = None
+    i2c_pio_dma_cpu_us: Optional[int] = None
+
+    @staticmethod
+    def parse(reader: BleAttrReader) -> "BulkState":
+        version = reader.uint8()
+        if version != BulkState.VERSION:
+            raise Exception(f"unsupported bulk state version {version}")
+
+        x = BulkState()
+        while reader.remaining:
+            kind = reader.uint8()
+            record = BleAttrReader(reader.bytes(reader.uint8()))
+            # unknown records are skipped, known records may have trailing fields we don't know about
+            if kind == BulkStateRecord.ENVIRONMENTAL:
+                x.intake, x.exhaust = SensorState.parse(record)
+            elif kind == BulkStateRecord.FAN:
+                x.fan = FanState.parse(record)
+            elif kind == BulkStateRecord.FILTER:
+                life = record.percentage8()
+                x.filter_life = None if life is None else life / 100
+            elif kind == BulkStateRecord.DIAGNOSTICS:
+                x.uptime = record.uint32()
+                x.heap_free = record.uint32()
+                x.heap_free_min = record.uint32()
+                if record.remaining:  # added w/ tickless idle
+                    x.tick_interrupts = record.uint32()
+                    x.tickless_sleeps = record.uint32()
+                    x.ticks_slept = record.uint32()
+                if record.remaining:  # added w/ adaptive sensor sampling
+                    x.sensor_reads = record.uint32()
+                    x.sensor_reads_deferred = record.uint32()
+                    x.i2c_transactions = record.uint32()
+                if record.remaining:  # added w/ PIO I2C CPU accounting
+                    x.i2c_pio_polled = record.uint32()
+                    x.i2c_pio_polled_cpu_us = record.uint32()
+                    x.i2c_pio_dma = record.uint32()
+                    x.i2c_pio_dma_cpu_us = record.uint32()
+            elif kind == BulkStateRecord.ZONES:
+                x.zones = zones_parse(record)
+
+        return x
+
+
+# see `src/gatt/display.cpp` for the format
+@dataclass
+class DisplayStats:
+    buffering: DisplayBuffering  # active, might differ from the setting
+    draw_arena_size: int  # bytes
+    frames: int
+    flushes: int
+    render_ms: int
+    pixels: int
+
+    @staticmethod
+    def parse(reader: BleAttrReader) -> "DisplayStats":
+        return DisplayStats(
+            buffering=DisplayBuffering(reader.uint8()),
+            draw_arena_size=reader.uint32(),
+            frames=reader.uint32(),
+            flushes=reader.uint32(),
+            render_ms=reader.uint32(),
+            pixels=reader.uint32(),
         )
 
 
+@dataclass
+class TaskMemory:
+    name: str
+    stack_free_min: int  # bytes, high-water mark
+
+
+# see `src/gatt/status.cpp` for the format
+@dataclass
+class MemoryReport:
+    VERSION = 1
+
+    heap_size: int = 0  # bytes
+    heap_free: int = 0  # bytes
+    heap_free_min: int = 0  # bytes
+    tasks: List[TaskMemory] = dataclasses.field(default_factory=list)
+
+    @staticmethod
+    def parse(reader: BleAttrReader) -> "MemoryReport":
+        version = reader.uint8()
+        if version != MemoryReport.VERSION:
+            raise Exception(f"unsupported memory report version {version}")
+
+        x = MemoryReport(reader.uint32(), reader.uint32(), reader.uint32())
+        while reader.remaining:
+            stack_free_min = reader.uint16()
+            name = reader.bytes(reader.uint8()).decode(errors="replace")
+            x.tasks.append(TaskMemory(name, stack_free_min))
+
+        return x
+
+
+# see `src/gatt/advertise.cpp` for the format
+@dataclass
+class AdvertTelemetry:
+    VERSION = 1
+
+    voc_index_intake: Optional[int] = None
+    voc_index_exhaust: Optional[int] = None
+    temperature_intake: Optional[float] = None
+    temperature_exhaust: Optional[float] = None
+    fan: FanState = dataclasses.field(default_factory=FanState)
+
+    # `None` if it isn't a telemetry payload we understand (e.g. some other device's ESS service data)
+    @staticmethod
+    def parse(reader: BleAttrReader) -> "Optional[AdvertTelemetry]":
+        try:
+            if reader.uint8() != AdvertTelemetry.VERSION:
+                return None
+
+            return AdvertTelemetry(
+                voc_index_intake=reader.voc_index(),
+                voc_index_exhaust=reader.voc_index(),
+                temperature_intake=reader.temperature(),
+                temperature_exhaust=reader.temperature(),
+                fan=FanState.parse(reader),
+            )
+        except BleAttrReaderNotEnoughData:
+            return None
+
+
 @dataclass
 class ControllerState:
     intake: SensorState = SensorState()
@@ -592,3 +854,458 @@ class ControllerState:
             add("exhaust_{0}", k, v)
 
         return data
+
+
+# Wired transport: the controller's GATT database over its USB CDC serial port.
+# See `src/gatt/serial.cpp` for the frame format.
+SERIAL_VERSION = 1
+# seconds, per request. Replies normally take well under a millisecond.
+SERIAL_TIMEOUT = 1
+SERIAL_OP_RESPONSE = 0x80
+
+GATT_UUID_PRIMARY_SERVICE = 0x2800
+GATT_UUID_SECONDARY_SERVICE = 0x2801
+GATT_UUID_CHARACTERISTIC = 0x2803
+GATT_UUID_CLIENT_CONFIGURATION = 0x2902
+
+# BTstack `profile_data` attribute flags
+ATT_DB_VERSION = 1
+ATT_PROPERTY_DYNAMIC = 0x0100
+ATT_PROPERTY_UUID128 = 0x0200
+
+
+class SerialOp(enum.IntEnum):
+    HELLO = 0x01
+    READ = 0x02
+    WRITE = 0x03
+    WRITE_COMMAND = 0x04
+    DATABASE = 0x05
+    NOTIFY = 0x06
+
+
+class SerialGattError(Exception):
+    "The controller rejected a request (ATT error)."
+
+    def __init__(self, op: SerialOp, handle: int, status: int):
+        super().__init__(
+            f"{op.name} handle=0x{handle:04x} failed w/ ATT error 0x{status:02x}"
+        )
+        self.status = status
+
+
+class SerialGattLost(EOFError):
+    "Port went away, or the controller stopped answering (e.g. rebooting)."
+
+
+def cobs_encode(data: bytes) -> bytes:
+    out = bytearray([0])
+    code_at, code = 0, 1
+    for x in data:
+        if x != 0:
+            out.append(x)
+            code += 1
+
+        if x == 0 or code == 0xFF:
+            out[code_at] = code
+            code_at, code = len(out), 1
+            out.append(0)
+
+    out[code_at] = code
+    return bytes(out)
+
+
+def cobs_decode(data: bytes) -> Optional[bytes]:
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or len(data) < i + code:
+            return None
+
+        out += data[i + 1 : i + code]
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def serial_crc32(data: bytes) -> int:
+    # same as `nevermore::crc32`, which skips the final inversion
+    return ~zlib.crc32(data) & 0xFFFFFFFF
+
+
+def serial_frame(payload: bytes) -> bytes:
+    body = payload + serial_crc32(payload).to_bytes(4, "little")
+    return b"\0" + cobs_encode(body) + b"\0"
+
+
+class SerialFrameDecoder:
+    "Splits a port's byte stream into frame payloads & the controller's log text."
+
+    def __init__(self):
+        self._buffer = bytearray()
+        self._in_frame = False
+
+    # yields `(payload, None)` for frames & `(None, line)` for log text
+    def feed(
+        self, data: bytes
+    ) -> Generator[Tuple[Optional[bytes], Optional[str]], None, None]:
+        for chunk in re.split(b"(\0)", data):
+            if chunk != b"\0":
+                self._buffer += chunk
+                if not self._in_frame:
+                    yield from self._lines(flush=False)
+                continue
+
+            payload = self._frame(bytes(self._buffer)) if self._in_frame else None
+            if payload is not None:
+                self._buffer.clear()
+                self._in_frame = False
+                yield payload, None
+                continue
+
+            # Not a (valid) frame end -> text. Also how we resync if we joined mid-frame: the bogus
+            # 'frame' is whatever followed the previous frame's end delimiter, which is its start.
+            yield from self._lines(flush=True)
+            self._in_frame = True
+
+    def _lines(self, flush: bool):
+        *lines, rest = self._buffer.split(b"\n")
+        if flush:
+            lines.append(rest)
+            rest = b""
+        self._buffer[:] = rest
+        for line in lines:
+            if line.strip():
+                yield None, line.decode("utf-8", errors="replace").rstrip()
+
+    @staticmethod
+    def _frame(body: bytes) -> Optional[bytes]:
+        decoded = cobs_decode(body)
+        if decoded is None or len(decoded) < 4 + 4:  # header + CRC
+            return None
+
+        payload, crc = decoded[:-4], int.from_bytes(decoded[-4:], "little")
+        return payload if crc == serial_crc32(payload) else None
+
+
+# Mirrors the subset of `bleak`'s GATT object model that we use.
+@dataclass
+class SerialGattDescriptor:
+    handle: int
+    uuid: str
+    flags: int
+    value: bytes
+
+    @property
+    def description(self):
+        return self.uuid
+
+
+@dataclass
+class SerialGattCharacteristic:
+    handle: int  # value handle
+    uuid: str
+    properties: List[str]
+    flags: int
+    value: bytes  # only meaningful if not `ATT_PROPERTY_DYNAMIC`
+    descriptors: List[SerialGattDescriptor] = dataclasses.field(default_factory=list)
+
+    @property
+    def description(self):
+        return self.uuid
+
+
+@dataclass
+class SerialGattService:
+    handle: int
+    uuid: str
+    characteristics: List[SerialGattCharacteristic] = dataclasses.field(
+        default_factory=list
+    )
+
+    @property
+    def description(self):
+        return self.uuid
+
+
+class SerialGattServices:
+    def __init__(self, services: List[SerialGattService]):
+        self.services = services
+
+    def __iter__(self):
+        return iter(self.services)
+
+    def get_service(self, uuid: Union[UUID, str]) -> Optional[SerialGattService]:
+        return next((x for x in self.services if x.uuid == str(uuid)), None)
+
+    def get_characteristic(
+        self, uuid: Union[UUID, str]
+    ) -> Optional[SerialGattCharacteristic]:
+        xs = (y for x in self.services for y in x.characteristics)
+        return next((x for x in xs if x.uuid == str(uuid)), None)
+
+    @staticmethod
+    def parse(db: bytes) -> "SerialGattServices":
+        def uuid_of(raw: bytes):
+            if len(raw) == 2:
+                return str(short_uuid(int.from_bytes(raw, "little")))
+            return str(UUID(bytes=raw[::-1]))
+
+        if not db or db[0] != ATT_DB_VERSION:
+            raise SerialGattLost(f"unsupported attribute DB version {db[:1].hex()}")
+
+        PROPERTIES = [
+            (0x01, CharacteristicProperty.BROADCAST),
+            (0x02, CharacteristicProperty.READ),
+            (0x04, CharacteristicProperty.WRITE_NO_RESPONSE),
+            (0x08, CharacteristicProperty.WRITE),
+            (0x10, CharacteristicProperty.NOTIFY),
+            (0x20, CharacteristicProperty.INDICATE),
+        ]
+
+        services: List[SerialGattService] = []
+        char: Optional[SerialGattCharacteristic] = None
+        i = 1
+        while i + 2 <= len(db):
+            size = int.from_bytes(db[i : i + 2], "little")
+            if size == 0:
+                break
+
+            flags = int.from_bytes(db[i + 2 : i + 4], "little")
+            handle = int.from_bytes(db[i + 4 : i + 6], "little")
+            uuid_len = 16 if flags & ATT_PROPERTY_UUID128 else 2
+            uuid = uuid_of(db[i + 6 : i + 6 + uuid_len])
+            value = db[i + 6 + uuid_len : i + size]
+            i += size
+
+            if uuid in (
+                str(short_uuid(GATT_UUID_PRIMARY_SERVICE)),
+                str(short_uuid(GATT_UUID_SECONDARY_SERVICE)),
+            ):
+                services.append(SerialGattService(handle, uuid_of(value)))
+                char = None
+            elif uuid == str(short_uuid(GATT_UUID_CHARACTERISTIC)) and services:
+                props = [p.value for bit, p in PROPERTIES if value[0] & bit]
+                value_handle = int.from_bytes(value[1:3], "little")
+                char = SerialGattCharacteristic(
+                    value_handle, uuid_of(value[3:]), props, 0, b""
+                )
+                services[-1].characteristics.append(char)
+            elif char is not None and handle == char.handle:
+                char.flags = flags
+                char.value = value
+            elif char is not None:
+                char.descriptors.append(
+                    SerialGattDescriptor(handle, uuid, flags, value)
+                )
+
+        return SerialGattServices(services)
+
+
+# `BleakClient` look-alike for the wired transport, so `nevermore.py` & the tools can use either.
+# Open w/ `async with`. Works on anything that looks like a TTY (USB CDC, pty, etc.).
+class SerialGattClient:
+    def __init__(
+        self,
+        path: str,
+        timeout: float = SERIAL_TIMEOUT,
+        log: Union[logging.Logger, LoggerAdapter] = logging.root,
+    ):
+        self.address = path
+        self.timeout = timeout
+        self.log = log
+        self.services = SerialGattServices([])
+        self.value_max = 0
+        self._fd: Optional[int] = None
+        self._decoder = SerialFrameDecoder()
+        self._seq = 0
+        self._pending: Dict[int, "asyncio.Future[bytes]"] = {}
+        self._notify: Dict[
+            int, Callable[[SerialGattCharacteristic, bytearray], Any]
+        ] = {}
+        # HACK: Python < 3.10 compatibility, `asyncio.Lock` binds the current loop on construction.
+        self._write_lock: Optional[asyncio.Lock] = None
+
+    @property
+    def mtu_size(self):
+        return self.value_max + 3  # ATT notify header
+
+    async def __aenter__(self):
+        import termios
+        import tty
+
+        try:
+            self._fd = os.open(self.address, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+            tty.setraw(self._fd, termios.TCSANOW)
+        except OSError as e:
+            self._close()
+            raise SerialGattLost(f"can't open {self.address}: {e}") from e
+
+        self._write_lock = asyncio.Lock()
+        asyncio.get_running_loop().add_reader(self._fd, self._readable)
+        try:
+            hello = await self._request(SerialOp.HELLO, 0)
+            if len(hello) < 5 or hello[0] != SERIAL_VERSION:
+                raise SerialGattLost(f"unsupported protocol version {hello[:1].hex()}")
+            self.value_max = int.from_bytes(hello[1:3], "little")
+            db_size = int.from_bytes(hello[3:5], "little")
+
+            db = bytearray()
+            while len(db) < db_size:
+                db += await self._request(
+                    SerialOp.DATABASE, 0, len(db).to_bytes(2, "little")
+                )
+            self.services = SerialGattServices.parse(bytes(db))
+        except:
+            self._close()
+            raise
+
+        return self
+
+    async def __aexit__(self, *_: Any):
+        self._close()
+
+    async def read_gatt_char(self, char: SerialGattCharacteristic) -> bytearray:
+        if not char.flags & ATT_PROPERTY_DYNAMIC:
+            return bytearray(char.value)
+        return await self._read(char.handle)
+
+    async def read_gatt_descriptor(self, handle: int) -> bytearray:
+        descs = (
+            z for x in self.services for y in x.characteristics for z in y.descriptors
+        )
+        desc = next((x for x in descs if x.handle == handle), None)
+        if desc is not None and not desc.flags & ATT_PROPERTY_DYNAMIC:
+            return bytearray(desc.value)
+        return await self._read(handle)
+
+    async def write_gatt_char(
+        self,
+        char: SerialGattCharacteristic,
+        data: Union[bytes, bytearray],
+        response: Optional[bool] = None,
+    ):
+        # same default as `bleak`: w/ response unless the characteristic only supports w/o
+        if response is None:
+            response = CharacteristicProperty.WRITE.value in char.properties
+
+        if response:
+            await self._request(SerialOp.WRITE, char.handle, bytes(data))
+        else:
+            await self._send(SerialOp.WRITE_COMMAND, 0, char.handle, bytes(data))
+
+    async def start_notify(
+        self,
+        char: SerialGattCharacteristic,
+        callback: Callable[[SerialGattCharacteristic, bytearray], Any],
+    ):
+        self._notify[char.handle] = callback
+        await self._request(SerialOp.WRITE, self._client_cfg(char), b"\x01\x00")
+
+    async def stop_notify(self, char: SerialGattCharacteristic):
+        self._notify.pop(char.handle, None)
+        await self._request(SerialOp.WRITE, self._client_cfg(char), b"\x00\x00")
+
+    @staticmethod
+    def _client_cfg(char: SerialGattCharacteristic):
+        cfg = str(short_uuid(GATT_UUID_CLIENT_CONFIGURATION))
+        desc = next((x for x in char.descriptors if x.uuid == cfg), None)
+        if desc is None:
+            raise Exception(f"characteristic {char.uuid} doesn't support notifications")
+        return desc.handle
+
+    async def _read(self, handle: int) -> bytearray:
+        value = bytearray()
+        while True:
+            chunk = await self._request(
+                SerialOp.READ, handle, len(value).to_bytes(2, "little")
+            )
+            value += chunk
+            if len(chunk) < self.value_max:
+                return value
+
+    async def _request(self, op: SerialOp, handle: int, body: bytes = b"") -> bytes:
+        self._seq = (self._seq + 1) & 0xFF
+        seq = self._seq
+        reply = asyncio.get_running_loop().create_future()
+        self._pending[seq] = reply
+        try:
+            await self._send(op, seq, handle, body)
+            payload = await asyncio.wait_for(reply, self.timeout)
+        except asyncio.TimeoutError as e:
+            raise SerialGattLost(f"{op.name} handle=0x{handle:04x} timed out") from e
+        finally:
+            self._pending.pop(seq, None)
+
+        if payload[0] != 0:
+            raise SerialGattError(op, handle, payload[0])
+        return payload[1:]
+
+    async def _send(self, op: SerialOp, seq: int, handle: int, body: bytes):
+        if self._fd is None or self._write_lock is None:
+            raise SerialGattLost(f"{self.address} is closed")
+
+        frame = memoryview(
+            serial_frame(bytes([op, seq]) + handle.to_bytes(2, "little") + body)
+        )
+        async with self._write_lock:  # frames must not interleave
+            while frame:
+                try:
+                    frame = frame[os.write(self._fd, frame) :]
+                except BlockingIOError:
+                    await asyncio.sleep(
+                        0.001
+                    )  # USB/pty buffer is full, host side is slow
+                except OSError as e:
+                    self._lost(e)
+                    raise SerialGattLost(f"write to {self.address} failed: {e}") from e
+
+    def _readable(self):
+        assert self._fd is not None
+        try:
+            data = os.read(self._fd, 4096)
+        except BlockingIOError:
+            return
+        except OSError as e:
+            return self._lost(e)
+
+        if not data:
+            return self._lost(None)
+
+        for payload, line in self._decoder.feed(data):
+            if line is not None:
+                self.log.debug(f"controller: {line}")
+            elif payload is not None:
+                self._dispatch(payload)
+
+    def _dispatch(self, payload: bytes):
+        op, seq = payload[0], payload[1]
+        handle = int.from_bytes(payload[2:4], "little")
+        if op == SerialOp.NOTIFY:
+            callback = self._notify.get(handle)
+            chars = (y for x in self.services for y in x.characteristics)
+            char = next((x for x in chars if x.handle == handle), None)
+            if callback is not None and char is not None:
+                callback(char, bytearray(payload[4:]))
+        elif op & SERIAL_OP_RESPONSE:
+            reply = self._pending.get(seq)
+            if reply is not None and not reply.done():
+                reply.set_result(payload[4:])
+
+    def _lost(self, e: Optional[Exception]):
+        for reply in self._pending.values():
+            if not reply.done():
+                reply.set_exception(SerialGattLost(f"{self.address} lost: {e}"))
+        self._close()
+
+    def _close(self):
+        if self._fd is None:
+            return
+
+        try:
+            asyncio.get_running_loop().remove_reader(self._fd)
+        except RuntimeError:
+            pass  # no loop, never registered
+        os.close(self._fd)
+        self._fd = None